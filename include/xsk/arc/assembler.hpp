@@ -44,8 +44,8 @@ private:
     auto resolve_label(std::string const& name) const -> usize;
     auto resolve_string(std::string const& name) -> u16;
     auto add_stringref(std::string const& str, string_type type, u32 ref) -> void;
-    auto add_importref(std::vector<std::string> const& data, u32 ref) -> void;
-    auto add_animref(std::vector<std::string> const& data, u32 ref) -> void;
+    auto add_importref(std::vector<operand> const& data, u32 ref) -> void;
+    auto add_animref(std::vector<operand> const& data, u32 ref) -> void;
 };
 
 } // namespace xsk::arc
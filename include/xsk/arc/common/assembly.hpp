@@ -164,6 +164,40 @@ struct sourcepos
     i32 column;
 };
 
+// numeric operands keep their binary value, text is only produced when dumped
+struct operand
+{
+    enum class kind : u8 { string, label, integer, number, vector, hash };
+
+    kind type;
+    u8 width;
+    union
+    {
+        i64 integer;
+        u64 hash;
+        f32 number;
+    };
+    std::string text;
+
+    operand(std::string text) : type{ kind::string }, width{ 0 }, integer{ 0 }, text{ std::move(text) } {}
+    operand(std::string_view text) : type{ kind::string }, width{ 0 }, integer{ 0 }, text{ text } {}
+    operand(char const* text) : type{ kind::string }, width{ 0 }, integer{ 0 }, text{ text } {}
+
+    static auto make_label(std::string name) -> operand;
+    static auto make_int(i64 value) -> operand;
+    static auto make_float(f32 value) -> operand;
+    static auto make_vector(f32 value) -> operand;
+    static auto make_hash(u64 value, u8 width) -> operand;
+
+    auto is_string() const -> bool { return type == kind::string || type == kind::label; }
+    auto as_int() const -> i64;
+    auto as_float() const -> f32;
+    auto as_hash() const -> u64;
+    auto as_label() const -> usize;
+    auto to_string() const -> std::string;
+    auto operator==(std::string_view other) const -> bool { return is_string() && text == other; }
+};
+
 struct instruction
 {
     using ptr = std::unique_ptr<instruction>;
@@ -172,7 +206,7 @@ struct instruction
     usize size;
     sourcepos pos;
     opcode opcode;
-    std::vector<std::string> data;
+    std::vector<operand> data;
 
     static auto make() -> instruction::ptr
     {
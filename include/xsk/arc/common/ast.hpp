@@ -129,7 +129,7 @@ struct node
 
     auto kind() const -> type { return kind_; }
     auto loc() const -> location const& { return loc_; }
-    auto label() const -> std::string { return loc_.label(); }
+    auto label() const -> usize { return static_cast<usize>(loc_.begin.line); }
 
     auto is_special_stmt() -> bool;
     auto is_special_stmt_dev() -> bool;
@@ -1209,9 +1209,9 @@ struct stmt_jmp : public stmt
 {
     using ptr = std::unique_ptr<stmt_jmp>;
 
-    std::string value;
+    usize value;
 
-    stmt_jmp(location const& loc, std::string const& value);
+    stmt_jmp(location const& loc, usize value);
     XSK_ARC_AST_MAKE(stmt_jmp)
 };
 
@@ -1219,9 +1219,9 @@ struct stmt_jmp_back : public stmt
 {
     using ptr = std::unique_ptr<stmt_jmp_back>;
 
-    std::string value;
+    usize value;
 
-    stmt_jmp_back(location const& loc, std::string const& value);
+    stmt_jmp_back(location const& loc, usize value);
     XSK_ARC_AST_MAKE(stmt_jmp_back)
 };
 
@@ -1230,9 +1230,9 @@ struct stmt_jmp_cond : public stmt
     using ptr = std::unique_ptr<stmt_jmp_cond>;
 
     expr::ptr test;
-    std::string value;
+    usize value;
 
-    stmt_jmp_cond(location const& loc, expr::ptr test, std::string const& value);
+    stmt_jmp_cond(location const& loc, expr::ptr test, usize value);
     XSK_ARC_AST_MAKE(stmt_jmp_cond)
 };
 
@@ -1241,9 +1241,9 @@ struct stmt_jmp_true : public stmt
     using ptr = std::unique_ptr<stmt_jmp_true>;
 
     expr::ptr test;
-    std::string value;
+    usize value;
 
-    stmt_jmp_true(location const& loc, expr::ptr test, std::string const& value);
+    stmt_jmp_true(location const& loc, expr::ptr test, usize value);
     XSK_ARC_AST_MAKE(stmt_jmp_true)
 };
 
@@ -1252,9 +1252,9 @@ struct stmt_jmp_false : public stmt
     using ptr = std::unique_ptr<stmt_jmp_false>;
 
     expr::ptr test;
-    std::string value;
+    usize value;
 
-    stmt_jmp_false(location const& loc, expr::ptr test, std::string const& value);
+    stmt_jmp_false(location const& loc, expr::ptr test, usize value);
     XSK_ARC_AST_MAKE(stmt_jmp_false)
 };
 
@@ -1263,9 +1263,9 @@ struct stmt_jmp_switch : public stmt
     using ptr = std::unique_ptr<stmt_jmp_switch>;
 
     expr::ptr test;
-    std::string value;
+    usize value;
 
-    stmt_jmp_switch(location const& loc, expr::ptr test, std::string const& value);
+    stmt_jmp_switch(location const& loc, expr::ptr test, usize value);
     XSK_ARC_AST_MAKE(stmt_jmp_switch)
 };
 
@@ -1273,9 +1273,9 @@ struct stmt_jmp_endswitch : public stmt
 {
     using ptr = std::unique_ptr<stmt_jmp_endswitch>;
 
-    std::vector<std::string> data;
+    std::vector<operand> data;
 
-    stmt_jmp_endswitch(location const& loc, std::vector<std::string> data);
+    stmt_jmp_endswitch(location const& loc, std::vector<operand> data);
     XSK_ARC_AST_MAKE(stmt_jmp_endswitch)
 };
 
@@ -1283,9 +1283,9 @@ struct stmt_jmp_dev : public stmt
 {
     using ptr = std::unique_ptr<stmt_jmp_dev>;
 
-    std::string value;
+    usize value;
 
-    stmt_jmp_dev(location const& loc, std::string const& value);
+    stmt_jmp_dev(location const& loc, usize value);
     XSK_ARC_AST_MAKE(stmt_jmp_dev)
 };
 
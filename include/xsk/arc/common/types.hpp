@@ -113,13 +113,16 @@ enum class switch_type
     string,
 };
 
+// label offsets of the enclosing statement, none outside of a loop or switch
 struct locjmp
 {
-    std::string end;
-    std::string cnt;
-    std::string brk;
-    bool is_dev;
-    bool is_switch;
+    static constexpr auto none = ~usize{ 0 };
+
+    usize end = none;
+    usize cnt = none;
+    usize brk = none;
+    bool is_dev = false;
+    bool is_switch = false;
 };
 
 // fordward decl for modules ref
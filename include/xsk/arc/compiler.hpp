@@ -126,8 +126,8 @@ private:
     auto emit_expr_false(expr_false const& exp) -> void;
     auto emit_expr_true(expr_true const& exp) -> void;
     auto emit_opcode(opcode op) -> void;
-    auto emit_opcode(opcode op, std::string const& data) -> void;
-    auto emit_opcode(opcode op, std::vector<std::string> const& data) -> void;
+    auto emit_opcode(opcode op, operand data) -> void;
+    auto emit_opcode(opcode op, std::vector<operand> data) -> void;
     auto process_function(decl_function const& func) -> void;
     auto process_stmt(stmt const& stm) -> void;
     auto process_stmt_list(stmt_list const& stm) -> void;
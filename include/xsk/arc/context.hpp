@@ -15,12 +15,22 @@
 namespace xsk::arc
 {
 
+// read-only engine symbols, built once per engine and shared by all its contexts
+struct tables
+{
+    std::vector<opcode> code_map;
+    std::array<u16, 256> code_map_rev{};
+    std::unordered_map<u32, std::string_view> hash_map;
+
+    auto add_code(u16 id, opcode op) -> void;
+};
+
 struct context
 {
 public:
     using fs_callback = std::function<std::vector<u8>(std::string const&)>;
 
-    context(props props, engine engine, endian endian, system system, instance inst, u64 magic);
+    context(props props, engine engine, endian endian, system system, instance inst, u64 magic, tables const& tables);
 
     auto props() const -> props { return props_; }
     auto build() const -> build { return build_; }
@@ -51,6 +61,9 @@ public:
     auto hash_name(u32 id) const -> std::string;
     auto make_token(std::string_view str) const -> std::string;
     auto load_header(std::string const& name) -> std::tuple<std::string const*, char const*, usize>;
+    auto init_dependencies() -> void;
+    auto dependencies() const -> std::vector<std::string> const& { return dependencies_; }
+    auto invalidate(std::string const& name) -> void;
 
 protected:
     arc::props props_;
@@ -68,12 +81,10 @@ protected:
     bool fixup_{ false };
 
     fs_callback fs_callback_;
-    std::unordered_map<opcode, std::string_view> opcode_map_;
-    std::unordered_map<std::string_view, opcode> opcode_map_rev_;
-    std::unordered_map<u16, opcode> code_map_;
-    std::unordered_map<opcode, u16> code_map_rev_;
-    std::unordered_map<u32, std::string_view> hash_map_;
+    arc::tables const& tables_;
     std::unordered_map<std::string, std::vector<u8>> header_files_;
+    // headers read by the last compile, cached ones included
+    std::vector<std::string> dependencies_;
 };
 
 } // namespace xsk::arc
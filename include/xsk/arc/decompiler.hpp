@@ -17,9 +17,10 @@ private:
     program::ptr program_;
     decl_function::ptr func_;
     std::unordered_set<std::string> vars_;
-    std::unordered_map<usize, std::string> labels_;
-    std::vector<std::string> expr_labels_;
-    std::vector<std::string> tern_labels_;
+    std::unordered_set<usize> labels_;
+    std::unordered_map<usize, std::vector<usize>> jumps_;
+    std::vector<usize> expr_labels_;
+    std::vector<usize> tern_labels_;
     std::vector<std::string> locals_;
     std::vector<param_type> params_;
     std::stack<node::ptr> stack_;
@@ -52,11 +53,10 @@ private:
     auto decompile_for(stmt_list& stm, usize begin, usize end) -> void;
     auto decompile_foreach(stmt_list& stm, usize begin, usize end) -> void;
     auto decompile_switch(stmt_list& stm, usize begin, usize end) -> void;
-    auto find_location_reference(stmt_list const& stm, usize begin, usize end, std::string const& loc) -> bool;
-    auto find_location_index(stmt_list const& stm, std::string const& loc) -> usize;
+    auto find_location_reference(stmt_list const& stm, usize begin, usize end, usize loc) -> bool;
+    auto find_location_index(stmt_list const& stm, usize loc) -> usize;
     auto last_location_index(stmt_list const& stm, usize index) -> bool;
     auto lvalues_match(stmt_expr const& stm1, stmt_expr const& stm2) -> bool;
-    auto resolve_label(std::string const& name) const -> usize;
     auto process_function(decl_function& func) -> void;
     auto process_stmt(stmt& stm) -> void;
     auto process_stmt_list(stmt_list& stm) -> void;
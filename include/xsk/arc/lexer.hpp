@@ -28,6 +28,8 @@ public:
 private:
     auto push(char c) -> void;
     auto advance() -> void;
+    auto skip(usize count, usize columns) -> void;
+    auto skip_comment(char end) -> void;
     auto linewrap() -> void;
 };
 
@@ -17,6 +17,8 @@ private:
     context const* ctx_;
     function const* func_;
     assembly const* assembly_;
+    std::unordered_map<std::string_view, usize> functions_;
+    std::unordered_map<std::string_view, usize> labels_;
     utils::writer script_;
     utils::writer stack_;
     utils::writer devmap_;
@@ -40,7 +42,7 @@ private:
     auto assemble_switch_table(instruction const& inst) -> void;
     auto assemble_offset(i32 offs) -> void;
     auto resolve_function(std::string const& name) const -> usize;
-    auto resolve_label(std::string const& name) const -> usize;
+    auto resolve_label(operand const& label) const -> usize;
     auto encrypt_string(std::string const& str) -> std::string;
 };
 
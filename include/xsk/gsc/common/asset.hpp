@@ -23,4 +23,18 @@ struct asset
     auto deserialize(std::vector<u8> const& data) -> void;
 };
 
+// asset fields pointing into serialized data owned by the caller
+struct asset_view
+{
+    std::string_view name;
+    u32 compressedLen;
+    u32 len;
+    u32 bytecodeLen;
+    u8 const* buffer;
+    u8 const* bytecode;
+
+    auto serialize(std::ostream& stream) const -> void;
+    auto deserialize(u8 const* data, usize size) -> void;
+};
+
 } // namespace xsk::gsc
@@ -5,12 +5,34 @@
 
 #pragma once
 
+#include "xsk/utils/arena.hpp"
+
 namespace xsk::gsc
 {
 
+struct node;
+
+// pooled nodes only run their destructor, the memory goes with the arena
+struct node_deleter
+{
+    auto operator()(node* ptr) const -> void;
+};
+
+// nodes made while a scope is alive on this thread are placed in its arena
+struct node_arena
+{
+    explicit node_arena(utils::arena& nodes);
+    ~node_arena();
+    node_arena(node_arena const&) = delete;
+    auto operator=(node_arena const&) -> node_arena& = delete;
+
+private:
+    utils::arena* prev_;
+};
+
 struct node
 {
-    using ptr = std::unique_ptr<node>;
+    using ptr = std::unique_ptr<node, node_deleter>;
 
     enum type
     {
@@ -115,7 +137,7 @@ struct node
 
     auto kind() const -> type { return kind_; }
     auto loc() const -> location const& { return loc_; }
-    auto label() const -> std::string { return loc_.label(); }
+    auto label() const -> usize { return static_cast<usize>(loc_.begin.line); }
 
     auto is_special_stmt() -> bool;
     auto is_special_stmt_dev() -> bool;
@@ -126,12 +148,18 @@ struct node
     virtual auto precedence() -> u8;
 
     template<typename T>
-    static auto as(node::ptr) -> std::unique_ptr<T>;
+    static auto as(node::ptr) -> typename T::ptr;
+
+    static auto allocate(usize size, usize align) -> void*;
 
 protected:
     node(type t) : kind_(t) {}
     node(type t, location const& loc) : kind_(t), loc_(loc) {}
 
+    bool pooled_ = false;
+
+    friend node_deleter;
+
 private:
     type kind_;
     location loc_;
@@ -139,7 +167,7 @@ private:
 
 struct expr : node
 {
-    using ptr = std::unique_ptr<expr>;
+    using ptr = std::unique_ptr<expr, node_deleter>;
 
     virtual ~expr() = default;
 
@@ -161,7 +189,7 @@ protected:
 
 struct call : expr
 {
-    using ptr = std::unique_ptr<call>;
+    using ptr = std::unique_ptr<call, node_deleter>;
 
     enum class type { local, far, builtin };
     enum class mode { normal, thread, childthread, builtin };
@@ -184,7 +212,7 @@ protected:
 
 struct stmt : node
 {
-    using ptr = std::unique_ptr<stmt>;
+    using ptr = std::unique_ptr<stmt, node_deleter>;
 
     virtual ~stmt() = default;
 
@@ -204,7 +232,7 @@ protected:
 
 struct decl : node
 {
-    using ptr = std::unique_ptr<decl>;
+    using ptr = std::unique_ptr<decl, node_deleter>;
 
     virtual ~decl() = default;
 
@@ -224,14 +252,21 @@ protected:
 
 #define XSK_GSC_AST_MAKE(node_type)                                                 \
 template<class... Args>                                                             \
-inline static auto make(Args&&... args) -> std::unique_ptr<node_type>               \
+inline static auto make(Args&&... args) -> ptr                                      \
 {                                                                                   \
-    return std::unique_ptr<node_type>(new node_type(std::forward<Args>(args)...));  \
+    if (auto mem = node::allocate(sizeof(node_type), alignof(node_type)))           \
+    {                                                                               \
+        auto res = ptr(new (mem) node_type(std::forward<Args>(args)...));           \
+        res->pooled_ = true;                                                        \
+        return res;                                                                 \
+    }                                                                               \
+                                                                                    \
+    return ptr(new node_type(std::forward<Args>(args)...));                         \
 }
 
 struct node_prescriptcall : public node
 {
-    using ptr = std::unique_ptr<node_prescriptcall>;
+    using ptr = std::unique_ptr<node_prescriptcall, node_deleter>;
 
     node_prescriptcall(location const& loc);
     XSK_GSC_AST_MAKE(node_prescriptcall)
@@ -239,7 +274,7 @@ struct node_prescriptcall : public node
 
 struct node_voidcodepos : public node
 {
-    using ptr = std::unique_ptr<node_voidcodepos>;
+    using ptr = std::unique_ptr<node_voidcodepos, node_deleter>;
 
     node_voidcodepos(location const& loc);
     XSK_GSC_AST_MAKE(node_voidcodepos)
@@ -247,7 +282,7 @@ struct node_voidcodepos : public node
 
 struct expr_empty : public expr
 {
-    using ptr = std::unique_ptr<expr_empty>;
+    using ptr = std::unique_ptr<expr_empty, node_deleter>;
 
     expr_empty(location const& loc);
     friend auto operator==(expr_empty const& lhs, expr_empty const& rhs) -> bool;
@@ -256,7 +291,7 @@ struct expr_empty : public expr
 
 struct expr_true : public expr
 {
-    using ptr = std::unique_ptr<expr_true>;
+    using ptr = std::unique_ptr<expr_true, node_deleter>;
 
     expr_true(location const& loc);
     friend auto operator==(expr_true const& lhs, expr_true const& rhs) -> bool;
@@ -265,7 +300,7 @@ struct expr_true : public expr
 
 struct expr_false : public expr
 {
-    using ptr = std::unique_ptr<expr_false>;
+    using ptr = std::unique_ptr<expr_false, node_deleter>;
 
     expr_false(location const& loc);
     friend auto operator==(expr_false const& lhs, expr_false const& rhs) -> bool;
@@ -274,7 +309,7 @@ struct expr_false : public expr
 
 struct expr_integer : public expr
 {
-    using ptr = std::unique_ptr<expr_integer>;
+    using ptr = std::unique_ptr<expr_integer, node_deleter>;
 
     std::string value;
 
@@ -285,7 +320,7 @@ struct expr_integer : public expr
 
 struct expr_float : public expr
 {
-    using ptr = std::unique_ptr<expr_float>;
+    using ptr = std::unique_ptr<expr_float, node_deleter>;
 
     std::string value;
 
@@ -296,7 +331,7 @@ struct expr_float : public expr
 
 struct expr_vector : public expr
 {
-    using ptr = std::unique_ptr<expr_vector>;
+    using ptr = std::unique_ptr<expr_vector, node_deleter>;
 
     expr::ptr x;
     expr::ptr y;
@@ -309,7 +344,7 @@ struct expr_vector : public expr
 
 struct expr_string : public expr
 {
-    using ptr = std::unique_ptr<expr_string>;
+    using ptr = std::unique_ptr<expr_string, node_deleter>;
 
     std::string value;
 
@@ -320,7 +355,7 @@ struct expr_string : public expr
 
 struct expr_istring : public expr
 {
-    using ptr = std::unique_ptr<expr_istring>;
+    using ptr = std::unique_ptr<expr_istring, node_deleter>;
 
     std::string value;
 
@@ -331,7 +366,7 @@ struct expr_istring : public expr
 
 struct expr_path : public expr
 {
-    using ptr = std::unique_ptr<expr_path>;
+    using ptr = std::unique_ptr<expr_path, node_deleter>;
 
     std::string value;
 
@@ -343,7 +378,7 @@ struct expr_path : public expr
 
 struct expr_identifier : public expr
 {
-    using ptr = std::unique_ptr<expr_identifier>;
+    using ptr = std::unique_ptr<expr_identifier, node_deleter>;
 
     std::string value;
 
@@ -354,7 +389,7 @@ struct expr_identifier : public expr
 
 struct expr_animtree : public expr
 {
-    using ptr = std::unique_ptr<expr_animtree>;
+    using ptr = std::unique_ptr<expr_animtree, node_deleter>;
 
     expr_animtree(location const& loc);
     friend auto operator==(expr_animtree const& lhs, expr_animtree const& rhs) -> bool;
@@ -363,7 +398,7 @@ struct expr_animtree : public expr
 
 struct expr_animation : public expr
 {
-    using ptr = std::unique_ptr<expr_animation>;
+    using ptr = std::unique_ptr<expr_animation, node_deleter>;
 
     std::string value;
 
@@ -374,7 +409,7 @@ struct expr_animation : public expr
 
 struct expr_level : public expr
 {
-    using ptr = std::unique_ptr<expr_level>;
+    using ptr = std::unique_ptr<expr_level, node_deleter>;
 
     expr_level(location const& loc);
     friend auto operator==(expr_level const& lhs, expr_level const& rhs) -> bool;
@@ -383,7 +418,7 @@ struct expr_level : public expr
 
 struct expr_anim : public expr
 {
-    using ptr = std::unique_ptr<expr_anim>;
+    using ptr = std::unique_ptr<expr_anim, node_deleter>;
 
     expr_anim(location const& loc);
     friend auto operator==(expr_anim const& lhs, expr_anim const& rhs) -> bool;
@@ -392,7 +427,7 @@ struct expr_anim : public expr
 
 struct expr_self : public expr
 {
-    using ptr = std::unique_ptr<expr_self>;
+    using ptr = std::unique_ptr<expr_self, node_deleter>;
 
     expr_self(location const& loc);
     friend auto operator==(expr_self const& lhs, expr_self const& rhs) -> bool;
@@ -401,7 +436,7 @@ struct expr_self : public expr
 
 struct expr_game : public expr
 {
-    using ptr = std::unique_ptr<expr_game>;
+    using ptr = std::unique_ptr<expr_game, node_deleter>;
 
     expr_game(location const& loc);
     friend auto operator==(expr_game const& lhs, expr_game const& rhs) -> bool;
@@ -410,7 +445,7 @@ struct expr_game : public expr
 
 struct expr_undefined : public expr
 {
-    using ptr = std::unique_ptr<expr_undefined>;
+    using ptr = std::unique_ptr<expr_undefined, node_deleter>;
 
     expr_undefined(location const& loc);
     friend auto operator==(expr_undefined const& lhs, expr_undefined const& rhs) -> bool;
@@ -419,7 +454,7 @@ struct expr_undefined : public expr
 
 struct expr_empty_array : public expr
 {
-    using ptr = std::unique_ptr<expr_empty_array>;
+    using ptr = std::unique_ptr<expr_empty_array, node_deleter>;
 
     expr_empty_array(location const& loc);
     friend auto operator==(expr_empty_array const& lhs, expr_empty_array const& rhs) -> bool;
@@ -428,7 +463,7 @@ struct expr_empty_array : public expr
 
 struct expr_thisthread : public expr
 {
-    using ptr = std::unique_ptr<expr_thisthread>;
+    using ptr = std::unique_ptr<expr_thisthread, node_deleter>;
 
     expr_thisthread(location const& loc);
     friend auto operator==(expr_thisthread const& lhs, expr_thisthread const& rhs) -> bool;
@@ -437,7 +472,7 @@ struct expr_thisthread : public expr
 
 struct expr_paren : public expr
 {
-    using ptr = std::unique_ptr<expr_paren>;
+    using ptr = std::unique_ptr<expr_paren, node_deleter>;
 
     expr::ptr value;
 
@@ -448,7 +483,7 @@ struct expr_paren : public expr
 
 struct expr_size : public expr
 {
-    using ptr = std::unique_ptr<expr_size>;
+    using ptr = std::unique_ptr<expr_size, node_deleter>;
 
     expr::ptr obj;
 
@@ -459,7 +494,7 @@ struct expr_size : public expr
 
 struct expr_field : public expr
 {
-    using ptr = std::unique_ptr<expr_field>;
+    using ptr = std::unique_ptr<expr_field, node_deleter>;
 
     expr::ptr obj;
     expr_identifier::ptr field;
@@ -471,7 +506,7 @@ struct expr_field : public expr
 
 struct expr_array : public expr
 {
-    using ptr = std::unique_ptr<expr_array>;
+    using ptr = std::unique_ptr<expr_array, node_deleter>;
 
     expr::ptr obj;
     expr::ptr key;
@@ -483,7 +518,7 @@ struct expr_array : public expr
 
 struct expr_tuple : public expr
 {
-    using ptr = std::unique_ptr<expr_tuple>;
+    using ptr = std::unique_ptr<expr_tuple, node_deleter>;
 
     std::vector<expr::ptr> list;
     expr::ptr temp;
@@ -494,7 +529,7 @@ struct expr_tuple : public expr
 
 struct expr_reference : public expr
 {
-    using ptr = std::unique_ptr<expr_reference>;
+    using ptr = std::unique_ptr<expr_reference, node_deleter>;
 
     expr_path::ptr path;
     expr_identifier::ptr name;
@@ -505,7 +540,7 @@ struct expr_reference : public expr
 
 struct expr_istrue : public expr
 {
-    using ptr = std::unique_ptr<expr_istrue>;
+    using ptr = std::unique_ptr<expr_istrue, node_deleter>;
 
     expr::ptr value;
 
@@ -515,7 +550,7 @@ struct expr_istrue : public expr
 
 struct expr_isdefined : public expr
 {
-    using ptr = std::unique_ptr<expr_isdefined>;
+    using ptr = std::unique_ptr<expr_isdefined, node_deleter>;
 
     expr::ptr value;
 
@@ -525,7 +560,7 @@ struct expr_isdefined : public expr
 
 struct expr_arguments : public expr
 {
-    using ptr = std::unique_ptr<expr_arguments>;
+    using ptr = std::unique_ptr<expr_arguments, node_deleter>;
 
     std::vector<expr::ptr> list;
 
@@ -535,7 +570,7 @@ struct expr_arguments : public expr
 
 struct expr_parameters : public expr
 {
-    using ptr = std::unique_ptr<expr_parameters>;
+    using ptr = std::unique_ptr<expr_parameters, node_deleter>;
 
     std::vector<expr_identifier::ptr> list;
 
@@ -545,7 +580,7 @@ struct expr_parameters : public expr
 
 struct expr_add_array : public expr
 {
-    using ptr = std::unique_ptr<expr_add_array>;
+    using ptr = std::unique_ptr<expr_add_array, node_deleter>;
 
     expr_arguments::ptr args;
 
@@ -555,7 +590,7 @@ struct expr_add_array : public expr
 
 struct expr_pointer : public call
 {
-    using ptr = std::unique_ptr<expr_pointer>;
+    using ptr = std::unique_ptr<expr_pointer, node_deleter>;
 
     expr::ptr func;
     expr_arguments::ptr args;
@@ -567,7 +602,7 @@ struct expr_pointer : public call
 
 struct expr_function : public call
 {
-    using ptr = std::unique_ptr<expr_function>;
+    using ptr = std::unique_ptr<expr_function, node_deleter>;
 
     expr_path::ptr path;
     expr_identifier::ptr name;
@@ -580,7 +615,7 @@ struct expr_function : public call
 
 struct expr_method : public expr
 {
-    using ptr = std::unique_ptr<expr_method>;
+    using ptr = std::unique_ptr<expr_method, node_deleter>;
 
     expr::ptr obj;
     call::ptr value;
@@ -591,7 +626,7 @@ struct expr_method : public expr
 
 struct expr_call : public expr
 {
-    using ptr = std::unique_ptr<expr_call>;
+    using ptr = std::unique_ptr<expr_call, node_deleter>;
 
     call::ptr value;
 
@@ -601,7 +636,7 @@ struct expr_call : public expr
 
 struct expr_complement : public expr
 {
-    using ptr = std::unique_ptr<expr_complement>;
+    using ptr = std::unique_ptr<expr_complement, node_deleter>;
 
     expr::ptr rvalue;
 
@@ -611,7 +646,7 @@ struct expr_complement : public expr
 
 struct expr_negate : public expr
 {
-    using ptr = std::unique_ptr<expr_negate>;
+    using ptr = std::unique_ptr<expr_negate, node_deleter>;
 
     expr::ptr rvalue;
 
@@ -621,7 +656,7 @@ struct expr_negate : public expr
 
 struct expr_not : public expr
 {
-    using ptr = std::unique_ptr<expr_not>;
+    using ptr = std::unique_ptr<expr_not, node_deleter>;
 
     expr::ptr rvalue;
 
@@ -631,7 +666,7 @@ struct expr_not : public expr
 
 struct expr_binary : public expr
 {
-    using ptr = std::unique_ptr<expr_binary>;
+    using ptr = std::unique_ptr<expr_binary, node_deleter>;
 
     enum class op { eq, ne, le, ge, lt, gt, add, sub, mul, div, mod, shl, shr, bwor, bwand, bwexor, bool_or, bool_and };
 
@@ -646,7 +681,7 @@ struct expr_binary : public expr
 
 struct expr_ternary : public expr
 {
-    using ptr = std::unique_ptr<expr_ternary>;
+    using ptr = std::unique_ptr<expr_ternary, node_deleter>;
 
     expr::ptr test;
     expr::ptr true_expr;
@@ -658,7 +693,7 @@ struct expr_ternary : public expr
 
 struct expr_assign : public expr
 {
-    using ptr = std::unique_ptr<expr_assign>;
+    using ptr = std::unique_ptr<expr_assign, node_deleter>;
 
     enum class op { eq, add, sub, mul, div, mod, shl, shr, bwor, bwand, bwexor };
 
@@ -672,7 +707,7 @@ struct expr_assign : public expr
 
 struct expr_increment : expr
 {
-    using ptr = std::unique_ptr<expr_increment>;
+    using ptr = std::unique_ptr<expr_increment, node_deleter>;
 
     expr::ptr lvalue;
     bool prefix;
@@ -683,7 +718,7 @@ struct expr_increment : expr
 
 struct expr_decrement : expr
 {
-    using ptr = std::unique_ptr<expr_decrement>;
+    using ptr = std::unique_ptr<expr_decrement, node_deleter>;
 
     expr::ptr lvalue;
     bool prefix;
@@ -694,7 +729,7 @@ struct expr_decrement : expr
 
 struct expr_var_create : public expr
 {
-    using ptr = std::unique_ptr<expr_var_create>;
+    using ptr = std::unique_ptr<expr_var_create, node_deleter>;
 
     std::string index;
     std::vector<std::string> vars;
@@ -705,7 +740,7 @@ struct expr_var_create : public expr
 
 struct expr_var_access : public expr
 {
-    using ptr = std::unique_ptr<expr_var_access>;
+    using ptr = std::unique_ptr<expr_var_access, node_deleter>;
 
     std::string index;
 
@@ -715,7 +750,7 @@ struct expr_var_access : public expr
 
 struct stmt_empty : public stmt
 {
-    using ptr = std::unique_ptr<stmt_empty>;
+    using ptr = std::unique_ptr<stmt_empty, node_deleter>;
 
     stmt_empty(location const& loc);
     XSK_GSC_AST_MAKE(stmt_empty)
@@ -723,7 +758,7 @@ struct stmt_empty : public stmt
 
 struct stmt_list : public stmt
 {
-    using ptr = std::unique_ptr<stmt_list>;
+    using ptr = std::unique_ptr<stmt_list, node_deleter>;
 
     std::vector<stmt::ptr> list;
 
@@ -733,7 +768,7 @@ struct stmt_list : public stmt
 
 struct stmt_comp : public stmt
 {
-    using ptr = std::unique_ptr<stmt_comp>;
+    using ptr = std::unique_ptr<stmt_comp, node_deleter>;
 
     stmt_list::ptr block;
 
@@ -743,7 +778,7 @@ struct stmt_comp : public stmt
 
 struct stmt_dev : public stmt
 {
-    using ptr = std::unique_ptr<stmt_dev>;
+    using ptr = std::unique_ptr<stmt_dev, node_deleter>;
 
     stmt_list::ptr block;
 
@@ -753,7 +788,7 @@ struct stmt_dev : public stmt
 
 struct stmt_expr : public stmt
 {
-    using ptr = std::unique_ptr<stmt_expr>;
+    using ptr = std::unique_ptr<stmt_expr, node_deleter>;
 
     expr::ptr value;
 
@@ -763,7 +798,7 @@ struct stmt_expr : public stmt
 
 struct stmt_endon : public stmt
 {
-    using ptr = std::unique_ptr<stmt_endon>;
+    using ptr = std::unique_ptr<stmt_endon, node_deleter>;
 
     expr::ptr obj;
     expr::ptr event;
@@ -774,7 +809,7 @@ struct stmt_endon : public stmt
 
 struct stmt_notify : public stmt
 {
-    using ptr = std::unique_ptr<stmt_notify>;
+    using ptr = std::unique_ptr<stmt_notify, node_deleter>;
 
     expr::ptr obj;
     expr::ptr event;
@@ -786,7 +821,7 @@ struct stmt_notify : public stmt
 
 struct stmt_wait : public stmt
 {
-    using ptr = std::unique_ptr<stmt_wait>;
+    using ptr = std::unique_ptr<stmt_wait, node_deleter>;
 
     expr::ptr time;
 
@@ -796,7 +831,7 @@ struct stmt_wait : public stmt
 
 struct stmt_waittill : public stmt
 {
-    using ptr = std::unique_ptr<stmt_waittill>;
+    using ptr = std::unique_ptr<stmt_waittill, node_deleter>;
 
     expr::ptr obj;
     expr::ptr event;
@@ -808,7 +843,7 @@ struct stmt_waittill : public stmt
 
 struct stmt_waittillmatch : public stmt
 {
-    using ptr = std::unique_ptr<stmt_waittillmatch>;
+    using ptr = std::unique_ptr<stmt_waittillmatch, node_deleter>;
 
     expr::ptr obj;
     expr::ptr event;
@@ -820,7 +855,7 @@ struct stmt_waittillmatch : public stmt
 
 struct stmt_waittillframeend : public stmt
 {
-    using ptr = std::unique_ptr<stmt_waittillframeend>;
+    using ptr = std::unique_ptr<stmt_waittillframeend, node_deleter>;
 
     stmt_waittillframeend(location const& loc);
     XSK_GSC_AST_MAKE(stmt_waittillframeend)
@@ -828,7 +863,7 @@ struct stmt_waittillframeend : public stmt
 
 struct stmt_waitframe : public stmt
 {
-    using ptr = std::unique_ptr<stmt_waitframe>;
+    using ptr = std::unique_ptr<stmt_waitframe, node_deleter>;
 
     stmt_waitframe(location const& loc);
     XSK_GSC_AST_MAKE(stmt_waitframe)
@@ -836,7 +871,7 @@ struct stmt_waitframe : public stmt
 
 struct stmt_if : public stmt
 {
-    using ptr = std::unique_ptr<stmt_if>;
+    using ptr = std::unique_ptr<stmt_if, node_deleter>;
 
     expr::ptr test;
     stmt::ptr body;
@@ -847,7 +882,7 @@ struct stmt_if : public stmt
 
 struct stmt_ifelse : public stmt
 {
-    using ptr = std::unique_ptr<stmt_ifelse>;
+    using ptr = std::unique_ptr<stmt_ifelse, node_deleter>;
 
     expr::ptr test;
     stmt::ptr stmt_if;
@@ -859,7 +894,7 @@ struct stmt_ifelse : public stmt
 
 struct stmt_while : public stmt
 {
-    using ptr = std::unique_ptr<stmt_while>;
+    using ptr = std::unique_ptr<stmt_while, node_deleter>;
 
     expr::ptr test;
     stmt::ptr body;
@@ -870,7 +905,7 @@ struct stmt_while : public stmt
 
 struct stmt_dowhile : public stmt
 {
-    using ptr = std::unique_ptr<stmt_dowhile>;
+    using ptr = std::unique_ptr<stmt_dowhile, node_deleter>;
 
     expr::ptr test;
     stmt::ptr body;
@@ -881,7 +916,7 @@ struct stmt_dowhile : public stmt
 
 struct stmt_for : public stmt
 {
-    using ptr = std::unique_ptr<stmt_for>;
+    using ptr = std::unique_ptr<stmt_for, node_deleter>;
 
     stmt::ptr init;
     expr::ptr test;
@@ -894,7 +929,7 @@ struct stmt_for : public stmt
 
 struct stmt_foreach : public stmt
 {
-    using ptr = std::unique_ptr<stmt_foreach>;
+    using ptr = std::unique_ptr<stmt_foreach, node_deleter>;
 
     expr::ptr container;
     expr::ptr value;
@@ -910,7 +945,7 @@ struct stmt_foreach : public stmt
 
 struct stmt_switch : public stmt
 {
-    using ptr = std::unique_ptr<stmt_switch>;
+    using ptr = std::unique_ptr<stmt_switch, node_deleter>;
 
     expr::ptr test;
     stmt_comp::ptr body;
@@ -921,7 +956,7 @@ struct stmt_switch : public stmt
 
 struct stmt_case : public stmt
 {
-    using ptr = std::unique_ptr<stmt_case>;
+    using ptr = std::unique_ptr<stmt_case, node_deleter>;
 
     expr::ptr value;
     stmt_list::ptr body;
@@ -933,7 +968,7 @@ struct stmt_case : public stmt
 
 struct stmt_default : public stmt
 {
-    using ptr = std::unique_ptr<stmt_default>;
+    using ptr = std::unique_ptr<stmt_default, node_deleter>;
 
     stmt_list::ptr body;
 
@@ -944,7 +979,7 @@ struct stmt_default : public stmt
 
 struct stmt_break : public stmt
 {
-    using ptr = std::unique_ptr<stmt_break>;
+    using ptr = std::unique_ptr<stmt_break, node_deleter>;
 
     stmt_break(location const& loc);
     XSK_GSC_AST_MAKE(stmt_break)
@@ -952,7 +987,7 @@ struct stmt_break : public stmt
 
 struct stmt_continue : public stmt
 {
-    using ptr = std::unique_ptr<stmt_continue>;
+    using ptr = std::unique_ptr<stmt_continue, node_deleter>;
 
     stmt_continue(location const& loc);
     XSK_GSC_AST_MAKE(stmt_continue)
@@ -960,7 +995,7 @@ struct stmt_continue : public stmt
 
 struct stmt_return : public stmt
 {
-    using ptr = std::unique_ptr<stmt_return>;
+    using ptr = std::unique_ptr<stmt_return, node_deleter>;
 
     expr::ptr value;
 
@@ -970,7 +1005,7 @@ struct stmt_return : public stmt
 
 struct stmt_breakpoint : public stmt
 {
-    using ptr = std::unique_ptr<stmt_breakpoint>;
+    using ptr = std::unique_ptr<stmt_breakpoint, node_deleter>;
 
     stmt_breakpoint(location const& loc);
     XSK_GSC_AST_MAKE(stmt_breakpoint)
@@ -978,7 +1013,7 @@ struct stmt_breakpoint : public stmt
 
 struct stmt_prof_begin : public stmt
 {
-    using ptr = std::unique_ptr<stmt_prof_begin>;
+    using ptr = std::unique_ptr<stmt_prof_begin, node_deleter>;
 
     expr_arguments::ptr args;
 
@@ -988,7 +1023,7 @@ struct stmt_prof_begin : public stmt
 
 struct stmt_prof_end : public stmt
 {
-    using ptr = std::unique_ptr<stmt_prof_end>;
+    using ptr = std::unique_ptr<stmt_prof_end, node_deleter>;
 
     expr_arguments::ptr args;
 
@@ -998,7 +1033,7 @@ struct stmt_prof_end : public stmt
 
 struct stmt_assert : public stmt
 {
-    using ptr = std::unique_ptr<stmt_assert>;
+    using ptr = std::unique_ptr<stmt_assert, node_deleter>;
 
     expr_arguments::ptr args;
 
@@ -1008,7 +1043,7 @@ struct stmt_assert : public stmt
 
 struct stmt_assertex : public stmt
 {
-    using ptr = std::unique_ptr<stmt_assertex>;
+    using ptr = std::unique_ptr<stmt_assertex, node_deleter>;
 
     expr_arguments::ptr args;
 
@@ -1018,7 +1053,7 @@ struct stmt_assertex : public stmt
 
 struct stmt_assertmsg : public stmt
 {
-    using ptr = std::unique_ptr<stmt_assertmsg>;
+    using ptr = std::unique_ptr<stmt_assertmsg, node_deleter>;
 
     expr_arguments::ptr args;
 
@@ -1028,7 +1063,7 @@ struct stmt_assertmsg : public stmt
 
 struct stmt_create : public stmt
 {
-    using ptr = std::unique_ptr<stmt_create>;
+    using ptr = std::unique_ptr<stmt_create, node_deleter>;
 
     std::string index;
     std::vector<std::string> vars;
@@ -1039,7 +1074,7 @@ struct stmt_create : public stmt
 
 struct stmt_remove : public stmt
 {
-    using ptr = std::unique_ptr<stmt_remove>;
+    using ptr = std::unique_ptr<stmt_remove, node_deleter>;
 
     std::string index;
 
@@ -1049,7 +1084,7 @@ struct stmt_remove : public stmt
 
 struct stmt_clear : public stmt
 {
-    using ptr = std::unique_ptr<stmt_clear>;
+    using ptr = std::unique_ptr<stmt_clear, node_deleter>;
 
     std::string index;
 
@@ -1059,81 +1094,81 @@ struct stmt_clear : public stmt
 
 struct stmt_jmp : public stmt
 {
-    using ptr = std::unique_ptr<stmt_jmp>;
+    using ptr = std::unique_ptr<stmt_jmp, node_deleter>;
 
-    std::string value;
+    usize value;
 
-    stmt_jmp(location const& loc, std::string const& value);
+    stmt_jmp(location const& loc, usize value);
     XSK_GSC_AST_MAKE(stmt_jmp)
 };
 
 struct stmt_jmp_back : public stmt
 {
-    using ptr = std::unique_ptr<stmt_jmp_back>;
+    using ptr = std::unique_ptr<stmt_jmp_back, node_deleter>;
 
-    std::string value;
+    usize value;
 
-    stmt_jmp_back(location const& loc, std::string const& value);
+    stmt_jmp_back(location const& loc, usize value);
     XSK_GSC_AST_MAKE(stmt_jmp_back)
 };
 
 struct stmt_jmp_cond : public stmt
 {
-    using ptr = std::unique_ptr<stmt_jmp_cond>;
+    using ptr = std::unique_ptr<stmt_jmp_cond, node_deleter>;
 
     expr::ptr test;
-    std::string value;
+    usize value;
 
-    stmt_jmp_cond(location const& loc, expr::ptr test, std::string const& value);
+    stmt_jmp_cond(location const& loc, expr::ptr test, usize value);
     XSK_GSC_AST_MAKE(stmt_jmp_cond)
 };
 
 struct stmt_jmp_true : public stmt
 {
-    using ptr = std::unique_ptr<stmt_jmp_true>;
+    using ptr = std::unique_ptr<stmt_jmp_true, node_deleter>;
 
     expr::ptr test;
-    std::string value;
+    usize value;
 
-    stmt_jmp_true(location const& loc, expr::ptr test, std::string const& value);
+    stmt_jmp_true(location const& loc, expr::ptr test, usize value);
     XSK_GSC_AST_MAKE(stmt_jmp_true)
 };
 
 struct stmt_jmp_false : public stmt
 {
-    using ptr = std::unique_ptr<stmt_jmp_false>;
+    using ptr = std::unique_ptr<stmt_jmp_false, node_deleter>;
 
     expr::ptr test;
-    std::string value;
+    usize value;
 
-    stmt_jmp_false(location const& loc, expr::ptr test, std::string const& value);
+    stmt_jmp_false(location const& loc, expr::ptr test, usize value);
     XSK_GSC_AST_MAKE(stmt_jmp_false)
 };
 
 struct stmt_jmp_switch : public stmt
 {
-    using ptr = std::unique_ptr<stmt_jmp_switch>;
+    using ptr = std::unique_ptr<stmt_jmp_switch, node_deleter>;
 
     expr::ptr test;
-    std::string value;
+    usize value;
 
-    stmt_jmp_switch(location const& loc, expr::ptr test, std::string const& value);
+    stmt_jmp_switch(location const& loc, expr::ptr test, usize value);
     XSK_GSC_AST_MAKE(stmt_jmp_switch)
 };
 
 struct stmt_jmp_endswitch : public stmt
 {
-    using ptr = std::unique_ptr<stmt_jmp_endswitch>;
+    using ptr = std::unique_ptr<stmt_jmp_endswitch, node_deleter>;
 
-    std::vector<std::string> data;
+    std::vector<operand> data;
 
-    stmt_jmp_endswitch(location const& loc, std::vector<std::string> data);
+    stmt_jmp_endswitch(location const& loc, std::vector<operand> data);
     XSK_GSC_AST_MAKE(stmt_jmp_endswitch)
 };
 
 struct decl_empty : public decl
 {
-    using ptr = std::unique_ptr<decl_empty>;
+    using ptr = std::unique_ptr<decl_empty, node_deleter>;
 
     decl_empty(location const& loc);
     XSK_GSC_AST_MAKE(decl_empty)
@@ -1141,7 +1176,7 @@ struct decl_empty : public decl
 
 struct decl_function : public decl
 {
-    using ptr = std::unique_ptr<decl_function>;
+    using ptr = std::unique_ptr<decl_function, node_deleter>;
 
     expr_identifier::ptr name;
     expr_parameters::ptr params;
@@ -1153,7 +1188,7 @@ struct decl_function : public decl
 
 struct decl_constant : public decl
 {
-    using ptr = std::unique_ptr<decl_constant>;
+    using ptr = std::unique_ptr<decl_constant, node_deleter>;
 
     expr_identifier::ptr name;
     expr::ptr value;
@@ -1164,7 +1199,7 @@ struct decl_constant : public decl
 
 struct decl_usingtree : public decl
 {
-    using ptr = std::unique_ptr<decl_usingtree>;
+    using ptr = std::unique_ptr<decl_usingtree, node_deleter>;
 
     expr_string::ptr name;
 
@@ -1174,7 +1209,7 @@ struct decl_usingtree : public decl
 
 struct decl_dev_begin : public decl
 {
-    using ptr = std::unique_ptr<decl_dev_begin>;
+    using ptr = std::unique_ptr<decl_dev_begin, node_deleter>;
 
     decl_dev_begin(location const& loc);
     XSK_GSC_AST_MAKE(decl_dev_begin)
@@ -1182,7 +1217,7 @@ struct decl_dev_begin : public decl
 
 struct decl_dev_end : public decl
 {
-    using ptr = std::unique_ptr<decl_dev_end>;
+    using ptr = std::unique_ptr<decl_dev_end, node_deleter>;
 
     decl_dev_end(location const& loc);
     XSK_GSC_AST_MAKE(decl_dev_end)
@@ -1190,7 +1225,7 @@ struct decl_dev_end : public decl
 
 struct include : public node
 {
-    using ptr = std::unique_ptr<include>;
+    using ptr = std::unique_ptr<include, node_deleter>;
 
     expr_path::ptr path;
 
@@ -1200,14 +1235,22 @@ struct include : public node
 
 struct program : public node
 {
-    using ptr = std::unique_ptr<program>;
+    using ptr = std::unique_ptr<program, node_deleter>;
 
+    // owns the pooled nodes, declared first so it outlives them
+    utils::arena nodes;
     std::vector<include::ptr> includes;
     std::vector<decl::ptr> declarations;
 
     program();
     program(location const& loc);
-    XSK_GSC_AST_MAKE(program)
+
+    // the root stays on the heap, it carries the arena its nodes live in
+    template<class... Args>
+    inline static auto make(Args&&... args) -> ptr
+    {
+        return ptr(new program(std::forward<Args>(args)...));
+    }
 };
 
 #undef XSK_GSC_AST_MAKE
@@ -11,7 +11,7 @@ namespace xsk::gsc
 struct buffer
 {
     u8 const* data;
-    usize const size;
+    usize size;
 
     buffer() : data{ nullptr }, size{ 0 } {}
     buffer(u8 const* data, usize size) : data{ data }, size{ size } {}
@@ -16,6 +16,8 @@ struct define
 //  bool vararg;
     std::vector<token> args;
     std::vector<token> exp;
+    // interned name, indexes the preprocessor hide set
+    u32 id = 0;
 };
 
 } // namespace xsk::gsc
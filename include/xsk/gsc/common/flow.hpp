@@ -0,0 +1,35 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#pragma once
+
+namespace xsk::gsc
+{
+
+// control flow graph of a disassembled function, blocks are kept in offset order
+struct flowgraph
+{
+    struct block
+    {
+        usize begin;
+        usize last;
+        u32 idom;
+        u32 ipdom;
+        std::vector<u32> succs;
+        std::vector<u32> preds;
+    };
+
+    // no dominator: the entry, unreachable blocks, or paths that never leave the function
+    static constexpr u32 none = std::numeric_limits<u32>::max();
+
+    std::vector<block> blocks;
+    std::vector<u32> latches;
+
+    auto build(function const& func) -> void;
+    auto find(usize offset) const -> block const*;
+    auto dominates(u32 dom, u32 index) const -> bool;
+};
+
+} // namespace xsk::gsc
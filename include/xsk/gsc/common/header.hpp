@@ -0,0 +1,67 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#pragma once
+
+#include "xsk/utils/arena.hpp"
+
+namespace xsk::gsc
+{
+
+// a gsh file lexed once, its tokens are replayed by every script that inlines it
+struct header
+{
+    using ptr = std::shared_ptr<header const>;
+
+    std::string name;
+    std::string data;
+    bool dev;
+    std::vector<token> tokens;
+    // lexer error raised after the last token, rethrown when the replay reaches it
+    std::exception_ptr error;
+    utils::arena strings{ 0x1000 };
+
+    auto matches(std::string_view source, bool devblocks) const -> bool
+    {
+        return dev == devblocks && data == source;
+    }
+};
+
+// macros a header defines without emitting any token, valid while the absent names stay undefined
+struct header_defines
+{
+    using ptr = std::shared_ptr<header_defines const>;
+
+    header::ptr source;
+    std::vector<std::string_view> absent;
+    std::vector<std::pair<std::string_view, define>> defines;
+    utils::arena strings{ 0x400 };
+};
+
+// headers shared by every context of a target, safe to use from worker threads
+struct header_cache
+{
+    using ptr = std::shared_ptr<header_cache>;
+
+private:
+    struct slot
+    {
+        header::ptr data;
+        header_defines::ptr defines;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, slot> slots_;
+
+public:
+    auto find(std::string const& name) -> std::pair<header::ptr, header_defines::ptr>;
+    auto insert(header::ptr data) -> void;
+    auto publish(header_defines::ptr defines) -> void;
+    auto clear() -> void;
+    auto save(std::filesystem::path const& file) -> void;
+    auto load(std::filesystem::path const& file) -> void;
+};
+
+} // namespace xsk::gsc
@@ -8,12 +8,15 @@
 namespace xsk::gsc
 {
 
+// label offsets of the enclosing statement, none outside of a loop or switch
 struct locjmp
 {
-    std::string end;
-    std::string cnt;
-    std::string brk;
-    bool last;
+    static constexpr auto none = ~usize{ 0 };
+
+    usize end = none;
+    usize cnt = none;
+    usize brk = none;
+    bool last = false;
 };
 
 struct scope
@@ -36,9 +39,9 @@ struct scope
     };
 
     abort_type abort;
-    std::string loc_end;
-    std::string loc_cont;
-    std::string loc_break;
+    u32 loc_end;
+    u32 loc_cont;
+    u32 loc_break;
     u32 create_count;
     u32 public_count;
     std::vector<var> vars;
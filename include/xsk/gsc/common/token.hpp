@@ -31,10 +31,10 @@ struct token
     kind type;
     spacing space;
     location pos;
-    std::string data;
+    std::string_view data;
 
     token(kind type, spacing space, location pos) : type{ type }, space{ space },  pos{ pos }, data{} {}
-    token(kind type, spacing space, location pos, std::string data) : type{ type }, space{ space },  pos{ pos }, data{ std::move(data) } {}
+    token(kind type, spacing space, location pos, std::string_view data) : type{ type }, space{ space },  pos{ pos }, data{ data } {}
     auto to_string() -> std::string;
 };
 
@@ -9,6 +9,7 @@
 #include "xsk/gsc/common/scope.hpp"
 #include "xsk/gsc/common/buffer.hpp"
 #include "xsk/gsc/common/assembly.hpp"
+#include "xsk/gsc/common/flow.hpp"
 #include "xsk/gsc/common/location.hpp"
 #include "xsk/gsc/common/exception.hpp"
 #include "xsk/gsc/common/lookahead.hpp"
@@ -16,6 +17,7 @@
 #include "xsk/gsc/common/space.hpp"
 #include "xsk/gsc/common/token.hpp"
 #include "xsk/gsc/common/define.hpp"
+#include "xsk/gsc/common/header.hpp"
 #include "xsk/gsc/common/ast.hpp"
 
 namespace xsk::gsc
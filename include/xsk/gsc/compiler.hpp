@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "xsk/utils/thread_pool.hpp"
 #include "xsk/gsc/common/types.hpp"
 
 namespace xsk::gsc
@@ -16,7 +17,7 @@ private:
     context* ctx_;
     assembly::ptr assembly_;
     function::ptr function_;
-    std::vector<std::string> localfuncs_;
+    std::unordered_set<std::string> localfuncs_;
     std::vector<std::string> stackframe_;
     std::unordered_map<std::string, expr const*> constants_;
     std::unordered_map<node*, scope::ptr> scopes_;
@@ -25,19 +26,25 @@ private:
     std::string animname_;
     sourcepos debug_pos_;
     usize index_;
-    usize label_idx_;
+    std::vector<usize> labels_;
+    std::vector<u32> aliases_;
+    std::unordered_map<usize, u32> label_index_;
     bool can_break_;
     bool can_continue_;
     bool developer_thread_;
     bool animload_;
+    std::vector<std::unique_ptr<compiler>> workers_;
 
 public:
     explicit compiler(context* ctx);
     auto compile(program const& data) -> assembly::ptr;
     auto compile(std::string const& file, std::vector<u8>& data) -> assembly::ptr;
+    auto compile(program const& data, utils::thread_pool& pool) -> assembly::ptr;
+    auto compile(std::string const& file, std::vector<u8>& data, utils::thread_pool& pool) -> assembly::ptr;
 
 private:
     auto emit_program(program const& prog) -> void;
+    auto emit_symbols(program const& prog) -> void;
     auto emit_decl(decl const& dec) -> void;
     auto emit_decl_usingtree(decl_usingtree const& animtree) -> void;
     auto emit_decl_constant(decl_constant const& constant) -> void;
@@ -118,8 +125,8 @@ private:
     auto emit_create_local_vars(scope& scp) -> void;
     auto emit_remove_local_vars(scope& scp) -> void;
     auto emit_opcode(opcode op) -> void;
-    auto emit_opcode(opcode op, std::string const& data) -> void;
-    auto emit_opcode(opcode op, std::vector<std::string> const& data) -> void;
+    auto emit_opcode(opcode op, operand data) -> void;
+    auto emit_opcode(opcode op, std::vector<operand> data) -> void;
     auto process_function(decl_function const& func) -> void;
     auto process_stmt(stmt const& stm, scope& scp) -> void;
     auto process_stmt_list(stmt_list const& stm, scope& scp) -> void;
@@ -147,10 +154,13 @@ private:
     auto variable_access(expr_identifier const& exp, scope& scp) -> u8;
     auto resolve_function_type(expr_function const& exp, std::string& path) -> call::type;
     auto resolve_reference_type(expr_reference const& exp, std::string& path, bool& method) -> call::type;
+    auto resolve_include(location const& loc, std::string const& name, std::string& path) -> bool;
     auto is_constant_condition(expr const& exp) -> bool;
-    auto insert_label(std::string const& label) -> void;
-    auto create_label() -> std::string;
-    auto insert_label() -> std::string;
+    auto insert_label(u32 label) -> void;
+    auto create_label() -> u32;
+    auto insert_label() -> u32;
+    auto find_label(u32 label) -> u32;
+    auto resolve_labels() -> void;
 };
 
 } // namespace xsk::gsc
@@ -11,16 +11,81 @@
 #include "xsk/gsc/disassembler.hpp"
 #include "xsk/gsc/compiler.hpp"
 #include "xsk/gsc/decompiler.hpp"
+#include "xsk/gsc/optimizer.hpp"
 
 namespace xsk::gsc
 {
 
+// dense id to name lookup over the range of ids spanned by an engine list
+struct name_table
+{
+    u32 base{};
+    std::vector<std::string_view> names;
+
+    name_table() = default;
+
+    template<typename T>
+    explicit name_table(T const& list)
+    {
+        if (list.empty()) return;
+
+        auto min = static_cast<u32>(list.front().first);
+        auto max = min;
+
+        for (auto const& entry : list)
+        {
+            min = std::min(min, static_cast<u32>(entry.first));
+            max = std::max(max, static_cast<u32>(entry.first));
+        }
+
+        base = min;
+        names.resize(max - min + 1);
+
+        for (auto const& entry : list)
+        {
+            auto& name = names[entry.first - base];
+            if (name.empty()) name = entry.second;
+        }
+    }
+
+    auto find(u32 id) const -> std::string_view
+    {
+        return (id - base < names.size()) ? names[id - base] : std::string_view{};
+    }
+};
+
+// read-only engine symbols, built once per engine and shared by all its contexts
+struct tables
+{
+    std::array<opcode, 256> code_map{};
+    std::array<u8, 256> code_map_rev{};
+    name_table func_map;
+    std::unordered_map<std::string_view, u16> func_map_rev;
+    name_table meth_map;
+    std::unordered_map<std::string_view, u16> meth_map_rev;
+    name_table token_map;
+    std::unordered_map<std::string_view, u32> token_map_rev;
+    std::unordered_map<u64, std::string_view> func_map2;
+    std::unordered_map<u64, std::string_view> meth_map2;
+    std::unordered_map<u64, std::string_view> path_map;
+    std::unordered_map<u64, std::string_view> hash_map;
+
+    auto add_code(u8 id, opcode op) -> void;
+};
+
+// raw opcode byte resolved to its opcode and instruction size, zero size marks an invalid byte
+struct decode_entry
+{
+    opcode op;
+    u8 size;
+};
+
 struct context
 {
 public:
     using fs_callback = std::function<std::pair<buffer, std::vector<u8>>(context const*, std::string const&)>;
 
-    context(props props, engine engine, endian endian, system system, instance inst, u32 str_count);
+    context(props props, engine engine, endian endian, system system, instance inst, u32 str_count, tables const& tables);
 
     auto props() const -> props { return props_; }
 
@@ -46,8 +111,10 @@ public:
 
     auto decompiler() -> decompiler& { return decompiler_; }
 
-    auto func_map() const -> std::unordered_map<std::string_view, u16> const& { return func_map_rev_; }
-    auto meth_map() const -> std::unordered_map<std::string_view, u16> const& { return meth_map_rev_; }
+    auto optimizer() -> optimizer& { return optimizer_; }
+
+    auto func_map() const -> std::unordered_map<std::string_view, u16>;
+    auto meth_map() const -> std::unordered_map<std::string_view, u16>;
 
     auto init(gsc::build build, fs_callback callback) -> void;
 
@@ -57,11 +124,13 @@ public:
 
     auto opcode_size(opcode op) const -> usize;
 
+    auto opcode_decode(u8 id) const -> decode_entry const&;
+
     auto opcode_id(opcode op) const -> u8;
 
     auto opcode_name(opcode op) const -> std::string;
 
-    auto opcode_enum(std::string const& name) const -> opcode;
+    auto opcode_enum(std::string_view name) const -> opcode;
 
     auto opcode_enum(u8 id) const -> opcode;
 
@@ -105,11 +174,26 @@ public:
 
     auto load_header(std::string const& name) -> std::tuple<std::string const*, char const*, usize>;
 
+    auto headers() -> header_cache& { return *headers_; }
+
+    auto headers(header_cache::ptr cache) -> void { headers_ = std::move(cache); }
+
     auto load_include(std::string const& name) -> bool;
 
     auto init_includes() -> void;
 
-    auto is_includecall(std::string const& name, std::string& path) -> bool;
+    auto init_dependencies() -> void;
+
+    auto dependencies() const -> std::vector<std::string> const& { return dependencies_; }
+
+    auto invalidate(std::string const& name) -> void;
+
+    auto find_includecall(std::string const& name) const -> std::vector<std::string_view> const*;
+
+private:
+    auto instruction_size(opcode op) const -> usize;
+    auto add_dependency(std::string const& name) -> void;
+    auto add_includefuncs(std::string_view path, std::vector<std::string> const& funcs) -> void;
 
 protected:
     gsc::props props_;
@@ -124,24 +208,24 @@ protected:
     gsc::disassembler disassembler_;
     gsc::compiler compiler_;
     gsc::decompiler decompiler_;
+    gsc::optimizer optimizer_;
     fs_callback fs_callback_;
-    std::unordered_map<opcode, std::string_view> opcode_map_;
-    std::unordered_map<std::string_view, opcode> opcode_map_rev_;
-    std::unordered_map<u8, opcode> code_map_;
-    std::unordered_map<opcode, u8> code_map_rev_;
+    gsc::tables const& tables_;
+    std::array<decode_entry, 256> decode_table_{};
+    // builtins registered with func_add & meth_add
     std::unordered_map<u16, std::string_view> func_map_;
     std::unordered_map<std::string_view, u16> func_map_rev_;
     std::unordered_map<u16, std::string_view> meth_map_;
     std::unordered_map<std::string_view, u16> meth_map_rev_;
-    std::unordered_map<u32, std::string_view> token_map_;
-    std::unordered_map<std::string_view, u32> token_map_rev_;
-    std::unordered_map<u64, std::string_view> func_map2_;
-    std::unordered_map<u64, std::string_view> meth_map2_;
-    std::unordered_map<u64, std::string_view> path_map_;
-    std::unordered_map<u64, std::string_view> hash_map_;
     std::unordered_map<std::string, std::vector<u8>> header_files_;
+    // tokenized headers, may be shared with other contexts of the same target
+    header_cache::ptr headers_;
     std::unordered_set<std::string_view> includes_;
     std::unordered_map<std::string, std::vector<std::string>> include_cache_;
+    // function names of the loaded includes, keyed into include_cache_
+    std::unordered_map<std::string_view, std::vector<std::string_view>> include_funcs_;
+    // headers & includes read by the last compile, cached ones included
+    std::vector<std::string> dependencies_;
     std::unordered_set<std::string> new_func_map_;
     std::unordered_set<std::string> new_meth_map_;
 };
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "xsk/utils/thread_pool.hpp"
 #include "xsk/gsc/common/types.hpp"
 
 namespace xsk::gsc
@@ -16,16 +17,20 @@ private:
     context const* ctx_;
     program::ptr program_;
     decl_function::ptr func_;
-    std::unordered_map<usize, std::string> labels_;
-    std::vector<std::string> expr_labels_;
-    std::vector<std::string> tern_labels_;
+    flowgraph flow_;
+    std::unordered_set<usize> labels_;
+    std::vector<usize> expr_labels_;
+    std::vector<usize> tern_labels_;
     std::stack<node::ptr> stack_;
     bool in_waittill_;
     locjmp locs_;
+    std::ostream* log_;
+    std::vector<std::unique_ptr<decompiler>> workers_;
 
 public:
     explicit decompiler(context const* ctx);
     auto decompile(assembly const& data) -> program::ptr;
+    auto decompile(assembly const& data, utils::thread_pool& pool) -> program::ptr;
 
 private:
     auto decompile_function(function const& func) -> void;
@@ -47,8 +52,9 @@ private:
     auto decompile_for(stmt_list& stm, usize begin, usize end) -> void;
     auto decompile_foreach(stmt_list& stm, usize begin, usize end) -> void;
     auto decompile_switch(stmt_list& stm, usize begin, usize end) -> void;
-    auto find_location_reference(stmt_list const& stm, usize begin, usize end, std::string const& loc) -> bool;
-    auto find_location_index(stmt_list const& stm, std::string const& loc) -> usize;
+    auto find_location_reference(stmt_list const& stm, usize begin, usize end, usize loc) -> bool;
+    auto find_location_join(stmt_list const& stm, usize index) -> usize;
+    auto find_location_index(stmt_list const& stm, usize loc) -> usize;
     auto last_location_index(stmt_list const& stm, usize index) -> bool;
     auto process_function(decl_function& func) -> void;
     auto process_stmt(stmt& stm, scope& scp) -> void;
@@ -41,7 +41,7 @@ private:
     auto disassemble_switch_table(instruction& inst) -> void;
     auto disassemble_offset() -> i32;
     auto resolve_functions() -> void;
-    auto resolve_function(std::string const& index) -> std::string;
+    auto resolve_function(usize addr) -> std::string;
     auto decrypt_string(std::string const& str) -> std::string;
 };
 
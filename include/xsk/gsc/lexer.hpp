@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "xsk/utils/arena.hpp"
 #include "xsk/gsc/common/types.hpp"
 
 namespace xsk::gsc
@@ -14,6 +15,7 @@ struct lexer
 {
 private:
     context const* ctx_;
+    utils::arena* arena_;
     lookahead reader_;
     location loc_;
     usize buflen_;
@@ -22,12 +24,15 @@ private:
     std::array<char, 0x1000> buffer_;
 
 public:
-    lexer(context const* ctx, std::string const& name, char const* data, usize size);
+    lexer(context const* ctx, utils::arena& arena, std::string const& name, char const* data, usize size);
     auto lex() -> token;
 
 private:
     auto push(char c) -> void;
+    auto data(char const* begin) -> std::string_view;
     auto advance() -> void;
+    auto skip(usize count, usize columns) -> void;
+    auto skip_comment(char end) -> void;
     auto linewrap() -> void;
 };
 
@@ -0,0 +1,39 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#pragma once
+
+#include "xsk/gsc/common/types.hpp"
+
+namespace xsk::gsc
+{
+
+// peephole pass over compiled functions, run between the compiler and the assembler
+struct optimizer
+{
+private:
+    context const* ctx_;
+    std::vector<bool> dead_;
+    std::unordered_map<usize, usize> pos_;
+    std::unordered_map<usize, u32> refs_;
+
+public:
+    explicit optimizer(context const* ctx);
+    auto optimize(assembly& data) -> std::pair<usize, usize>;
+
+private:
+    auto optimize_function(function& func) -> void;
+    auto thread_jumps(function& func) -> bool;
+    auto rewrite(function& func) -> bool;
+    auto rewrite_negate(function& func, usize i) -> bool;
+    auto remove_unreachable(function& func) -> bool;
+    auto compact(function& func) -> void;
+    auto relocate(assembly& data) -> void;
+    auto next(function const& func, usize i) const -> usize;
+    auto referenced(instruction const& inst) const -> bool;
+    auto in_range(instruction const& inst, usize dest) const -> bool;
+};
+
+} // namespace xsk::gsc
@@ -14,19 +14,53 @@ namespace xsk::gsc
 struct preprocessor
 {
 private:
+    // a header being read, records what it looks up while it could still be summarized by its defines
+    struct replay
+    {
+        header::ptr data;
+        usize pos;
+        bool record;
+        std::unordered_set<std::string_view> absent;
+        std::unordered_set<std::string_view> added;
+    };
+
+    // a macro being expanded, its definition is read in place with the arguments kept flat
+    struct expansion
+    {
+        define const* def = nullptr;
+        std::vector<token> args;
+        std::vector<usize> bounds;
+        token last{ token::EOS, spacing::none, location{} };
+        usize pos = 0;
+        usize slot = 0;
+        usize arg = 0;
+        usize end = 0;
+        usize mark = 0;
+        u32 id = 0;
+        bool held = false;
+    };
+
     context* ctx_;
-    std::stack<lexer> lexer_;
+    utils::arena strings_;
+    lexer lexer_;
+    std::vector<replay> headers_;
+    std::vector<header::ptr> loaded_;
+    std::vector<header_defines::ptr> applied_;
     std::vector<std::string> includes_;
     std::stack<std::stack<directive>> indents_;
     std::unordered_map<std::string_view, directive::kind> directives_;
-    std::unordered_map<std::string, define> defines_;
-    std::set<std::string> reject_;
+    std::unordered_map<std::string_view, define> defines_;
+    std::unordered_map<std::string_view, u32> ids_;
+    std::vector<expansion> frames_;
+    std::vector<token> params_;
+    std::vector<usize> bounds_;
+    std::vector<u64> hidden_;
     std::deque<token> tokens_;
     std::vector<token> expr_;
     std::string date_;
     std::string time_;
     usize curr_expr_;
-    u32 expand_;
+    usize depth_;
     u32 skip_;
 
 public:
@@ -37,9 +71,15 @@ public:
     auto ban_header(location const& loc) -> void;
 
 private:
+    auto load_header(std::string const& name) -> std::pair<header::ptr, header_defines::ptr>;
+    auto apply_header(header_defines::ptr const& defines) -> bool;
+    auto publish_header(replay const& frame) -> void;
+    auto find_define(std::string_view name) -> define*;
+    auto add_define(std::string_view name, define&& def) -> void;
     auto skip_line() -> void;
     auto next_token() -> token;
     auto read_token() -> token;
+    auto replay_token() -> token;
     auto read_directive(token& tok) -> void;
     auto read_directive_if(token& tok) -> void;
     auto read_directive_ifdef(token& tok) -> void;
@@ -60,8 +100,16 @@ private:
     auto read_directive_usingtree(token& hash, token& name) -> void;
     auto read_hashtoken(token& hash) -> void;
     auto read_hashtoken_animtree(token& hash, token& name) -> void;
+    auto intern(std::string_view name) -> u32;
+    auto hidden(u32 id) const -> bool;
+    auto push_expansion(define const* def, u32 id) -> expansion&;
+    auto pop_expansion() -> void;
+    auto param_index(define const& def, std::string_view name) const -> usize;
+    auto expansion_ended(expansion const& frame) const -> bool;
+    auto expansion_token(expansion& frame, token& out) -> bool;
     auto expand(token& tok, define& def) -> void;
-    auto expand_params(token& tok, define& def) -> std::vector<std::vector<token>>;
+    auto expand_params(token& tok, define const& def) -> void;
+    auto expand_check(define const& def) -> void;
     auto expect(token& tok, token::kind expected, spacing space = spacing::none) -> void;
     auto evaluate() -> bool;
     auto eval_next() -> token&;
@@ -0,0 +1,31 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#pragma once
+
+namespace xsk::utils
+{
+
+// monotonic allocator, memory is only released when the arena is destroyed
+struct arena
+{
+private:
+    std::vector<std::unique_ptr<u8[]>> blocks_;
+    u8* head_ = nullptr;
+    usize left_ = 0;
+    usize block_size_;
+
+public:
+    arena(arena const&) = delete;
+    arena(arena&&) = default;
+    auto operator=(arena const&) -> arena& = delete;
+    auto operator=(arena&&) -> arena& = default;
+    explicit arena(usize block_size = 0x10000);
+    auto allocate(usize size, usize align) -> void*;
+    auto store(std::string_view str) -> std::string_view;
+    auto merge(arena&& other) -> void;
+};
+
+} // namespace xsk::utils
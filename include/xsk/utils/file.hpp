@@ -15,8 +15,35 @@ struct file
     static auto read(std::filesystem::path const& file) -> std::vector<u8>;
     static auto save(std::filesystem::path const& file, std::vector<u8> const& data) -> void;
     static auto save(std::filesystem::path const& file, u8 const* data, usize size) -> void;
+    static auto save(std::filesystem::path const& file, std::function<void(std::ostream&)> const& writer) -> void;
     static auto length(std::filesystem::path const& file) -> usize;
     static auto exists(std::filesystem::path const& file) -> bool;
+    static auto temp_path(std::filesystem::path const& file) -> std::filesystem::path;
+};
+
+// read-only memory mapping of a whole file
+struct mapped_file
+{
+private:
+    u8 const* data_;
+    usize size_;
+
+public:
+    using error = std::runtime_error;
+
+    mapped_file();
+    explicit mapped_file(std::filesystem::path const& file);
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file(mapped_file const&) = delete;
+    auto operator=(mapped_file&& other) noexcept -> mapped_file&;
+    auto operator=(mapped_file const&) -> mapped_file& = delete;
+    ~mapped_file();
+
+    auto data() const -> u8 const* { return data_; }
+    auto size() const -> usize { return size_; }
+
+private:
+    auto close() -> void;
 };
 
 } // namespace xsk::utils
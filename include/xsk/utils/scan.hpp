@@ -0,0 +1,18 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#pragma once
+
+namespace xsk::utils
+{
+
+struct scan
+{
+    static auto span(char const* data, usize size, char a, char b) -> usize;
+    static auto span(char const* data, usize size, char a, char b, char c) -> usize;
+    static auto count(char const* data, usize size, char c) -> usize;
+};
+
+} // namespace xsk::utils
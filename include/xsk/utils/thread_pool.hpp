@@ -0,0 +1,49 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#pragma once
+
+namespace xsk::utils
+{
+
+struct thread_pool
+{
+    using task = std::function<void(usize index, usize worker)>;
+
+private:
+    struct queue
+    {
+        std::mutex mutex;
+        std::deque<usize> items;
+    };
+
+    std::vector<std::thread> threads_;
+    std::vector<std::unique_ptr<queue>> queues_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::exception_ptr error_;
+    task const* task_ = nullptr;
+    usize generation_ = 0;
+    usize active_ = 0;
+    bool stop_ = false;
+
+public:
+    thread_pool(thread_pool const&) = delete;
+    thread_pool(thread_pool&&) = delete;
+    auto operator=(thread_pool const&) -> thread_pool& = delete;
+    auto operator=(thread_pool&&) -> thread_pool& = delete;
+    explicit thread_pool(usize count);
+    ~thread_pool();
+    auto size() const -> usize;
+    auto run(usize count, task const& func) -> void;
+    static auto concurrency() -> usize;
+
+private:
+    auto work(usize worker) -> void;
+    auto next(usize worker, usize& index) -> bool;
+};
+
+} // namespace xsk::utils
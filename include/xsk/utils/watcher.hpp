@@ -0,0 +1,36 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#pragma once
+
+namespace xsk::utils
+{
+
+// reports files changed in a set of directories, inotify on linux & polling elsewhere
+struct watcher
+{
+private:
+    std::map<std::filesystem::path, bool> dirs_;
+    std::unordered_map<int, std::filesystem::path> handles_;
+    std::map<std::filesystem::path, std::filesystem::file_time_type> times_;
+    int fd_;
+
+public:
+    using error = std::runtime_error;
+
+    watcher();
+    watcher(watcher const&) = delete;
+    auto operator=(watcher const&) -> watcher& = delete;
+    ~watcher();
+
+    auto add(std::filesystem::path const& dir, bool recursive) -> void;
+    auto wait(std::vector<std::filesystem::path>& files) -> bool;
+
+private:
+    auto scan(std::filesystem::path const& dir, std::set<std::filesystem::path>& changes) -> void;
+    auto rescan() -> void;
+};
+
+} // namespace xsk::utils
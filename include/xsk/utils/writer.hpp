@@ -14,10 +14,12 @@ struct writer
     using error = std::runtime_error;
 
 private:
-    static constexpr usize default_size = 0x100000;
+    static constexpr usize default_size = 0x10000;
+    std::vector<u8> buffer_;
     u8* data_;
     usize size_;
     usize pos_ = 0;
+    usize end_ = 0;
     bool swap_;
 
 public:
@@ -27,7 +29,6 @@ public:
     auto operator=(writer&&) -> writer& = delete;
     explicit writer(bool swap = false);
     writer(usize size, bool swap = false);
-    ~writer();
     auto clear() -> void;
     template <typename T>
     auto write(T data) -> void;
@@ -42,6 +43,9 @@ public:
     auto size() const -> usize;
     auto pos() const -> usize;
     auto pos(usize pos) -> void;
+
+private:
+    auto reserve(usize count) -> void;
 };
 
 } // namespace xsk::utils
@@ -13,7 +13,9 @@ struct zlib
     using error = std::runtime_error;
 
     static auto compress(std::vector<u8> const& data) -> std::vector<u8>;
+    static auto compress(u8 const* data, usize size) -> std::vector<u8>;
     static auto decompress(std::vector<u8> const& data, u32 length) -> std::vector<u8>;
+    static auto decompress(u8 const* data, usize size, u32 length) -> std::vector<u8>;
 };
 
 } // namespace xsk::utils
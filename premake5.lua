@@ -175,6 +175,33 @@ project "xsk-tool"
     cxxopts:link()
     zlib:link()
 
+project "xsk-bench"
+    kind "ConsoleApp"
+    language "C++"
+    targetname "gsc-bench"
+
+    dependson "xsk-utils"
+    dependson "xsk-arc"
+    dependson "xsk-gsc"
+
+    files {
+        "./src/bench/**.h",
+        "./src/bench/**.hpp",
+        "./src/bench/**.cpp"
+    }
+
+    links {
+        "xsk-utils",
+        "xsk-arc",
+        "xsk-gsc",
+    }
+
+    includedirs {
+        "./include",
+    }
+
+    zlib:link()
+
 project "xsk-utils"
     kind "StaticLib"
     language "C++"
@@ -405,26 +405,26 @@ auto assembler::assemble_instruction(instruction const& inst) -> void
             break;
         case opcode::OP_GetByte:
         case opcode::OP_GetNegByte:
-            script_.write<u8>(static_cast<u8>(std::stoi(inst.data[0])));
+            script_.write<u8>(static_cast<u8>(inst.data[0].as_int()));
             break;
         case opcode::OP_GetUnsignedShort:
         case opcode::OP_GetNegUnsignedShort:
             script_.align(2);
-            script_.write<u16>(static_cast<u16>(std::stoi(inst.data[0])));
+            script_.write<u16>(static_cast<u16>(inst.data[0].as_int()));
             break;
         case opcode::OP_GetInteger:
             script_.align(4);
-            script_.write<i32>((inst.data.size() == 2) ? -1 : std::stoi(inst.data[0]));
+            script_.write<i32>((inst.data.size() == 2) ? -1 : static_cast<i32>(inst.data[0].as_int()));
             break;
         case opcode::OP_GetFloat:
             script_.align(4);
-            script_.write<f32>(std::stof(inst.data[0]));
+            script_.write<f32>(inst.data[0].as_float());
             break;
         case opcode::OP_GetVector:
             script_.align(4);
-            script_.write<f32>(std::stof(inst.data[0]));
-            script_.write<f32>(std::stof(inst.data[1]));
-            script_.write<f32>(std::stof(inst.data[2]));
+            script_.write<f32>(inst.data[0].as_float());
+            script_.write<f32>(inst.data[1].as_float());
+            script_.write<f32>(inst.data[2].as_float());
             break;
         case opcode::OP_GetString:
         case opcode::OP_GetIString:
@@ -436,14 +436,14 @@ auto assembler::assemble_instruction(instruction const& inst) -> void
             script_.write<u32>(0);
             break;
         case opcode::OP_WaitTillMatch:
-            script_.write<u8>(static_cast<u8>(std::stoi(inst.data[0])));
+            script_.write<u8>(static_cast<u8>(inst.data[0].as_int()));
             break;
         case opcode::OP_VectorConstant:
-            script_.write<u8>(static_cast<u8>(std::stoi(inst.data[0])));
+            script_.write<u8>(static_cast<u8>(inst.data[0].as_int()));
             break;
         case opcode::OP_GetHash:
             script_.align(4);
-            script_.write<u32>(ctx_->hash_id(inst.data[0]));
+            script_.write<u32>(ctx_->hash_id(inst.data[0].text));
             break;
         case opcode::OP_SafeCreateLocalVariables:
             assemble_localvars(inst);
@@ -453,7 +453,7 @@ auto assembler::assemble_instruction(instruction const& inst) -> void
         case opcode::OP_EvalLocalArrayRefCached:
         case opcode::OP_SafeSetWaittillVariableFieldCached:
         case opcode::OP_EvalLocalVariableRefCached:
-            script_.write<u8>(static_cast<u8>(std::stoi(inst.data[0])));
+            script_.write<u8>(static_cast<u8>(inst.data[0].as_int()));
             break;
         case opcode::OP_EvalFieldVariable:
         case opcode::OP_EvalFieldVariableRef:
@@ -465,7 +465,7 @@ auto assembler::assemble_instruction(instruction const& inst) -> void
         case opcode::OP_ScriptMethodCallPointer:
         case opcode::OP_ScriptThreadCallPointer:
         case opcode::OP_ScriptMethodThreadCallPointer:
-            script_.write<u8>(static_cast<u8>(std::stoi(inst.data[0])));
+            script_.write<u8>(static_cast<u8>(inst.data[0].as_int()));
             break;
         case opcode::OP_GetFunction:
             script_.align(4);
@@ -515,18 +515,18 @@ auto assembler::assemble_localvars(instruction const& inst) -> void
 auto assembler::assemble_jump(instruction const& inst) -> void
 {
     script_.align(2);
-    script_.write<i16>(static_cast<i16>(resolve_label(inst.data[0]) - inst.index - inst.size));
+    script_.write<i16>(static_cast<i16>(resolve_label(inst.data[0].text) - inst.index - inst.size));
 }
 
 auto assembler::assemble_switch(instruction const& inst) -> void
 {
     script_.align(4);
-    script_.write<i32>(static_cast<i32>(((resolve_label(inst.data[0]) + 4) & 0xFFFFFFFC) - inst.index - inst.size));
+    script_.write<i32>(static_cast<i32>(((resolve_label(inst.data[0].text) + 4) & 0xFFFFFFFC) - inst.index - inst.size));
 }
 
 auto assembler::assemble_switch_table(instruction const& inst) -> void
 {
-    auto count = std::stoul(inst.data[0]);
+    auto count = static_cast<usize>(inst.data[0].as_int());
 
     script_.align(4);
     script_.write<u32>(count);
@@ -535,19 +535,19 @@ auto assembler::assemble_switch_table(instruction const& inst) -> void
     {
         if (inst.data[1 + (4 * i)] == "case")
         {
-            auto type = static_cast<switch_type>(std::stoul(inst.data[1 + (4 * i) + 1]));
+            auto type = static_cast<switch_type>(inst.data[1 + (4 * i) + 1].as_int());
 
-            script_.write<u32>((type == switch_type::integer) ? ((std::stoi(inst.data[1 + (4 * i) + 2]) & 0xFFFFFF) + 0x800000) : i + 1);
-            script_.write<i32>(static_cast<i32>(resolve_label(inst.data[1 + (4 * i) + 3]) - script_.pos() - 4));
+            script_.write<u32>((type == switch_type::integer) ? static_cast<u32>((inst.data[1 + (4 * i) + 2].as_int() & 0xFFFFFF) + 0x800000) : i + 1);
+            script_.write<i32>(static_cast<i32>(resolve_label(inst.data[1 + (4 * i) + 3].text) - script_.pos() - 4));
         }
         else if (inst.data[1 + (4 * i)] == "default")
         {
             script_.write<u32>(0);
-            script_.write<i32>(static_cast<i32>(resolve_label(inst.data[1 + (4 * i) + 1]) - script_.pos() - 4));
+            script_.write<i32>(static_cast<i32>(resolve_label(inst.data[1 + (4 * i) + 1].text) - script_.pos() - 4));
         }
         else
         {
-            throw asm_error(std::format("invalid switch case {}", inst.data[1 + (4 * i)]));
+            throw asm_error(std::format("invalid switch case {}", inst.data[1 + (4 * i)].text));
         }
     }
 }
@@ -578,21 +578,21 @@ auto assembler::process_instruction(instruction const& inst) -> void
     {
         case opcode::OP_GetInteger:
             if (inst.data.size() == 2)
-                process_string(inst.data[0]);
+                process_string(inst.data[0].text);
             break;
         case opcode::OP_GetString:
         case opcode::OP_GetIString:
-            process_string(inst.data[0]);
+            process_string(inst.data[0].text);
             break;
         case opcode::OP_GetAnimation:
-            process_string(inst.data[0]);
-            process_string(inst.data[1]);
+            process_string(inst.data[0].text);
+            process_string(inst.data[1].text);
             break;
         case opcode::OP_SafeCreateLocalVariables:
         {
             for (auto const& entry : inst.data)
             {
-                process_string(entry);
+                process_string(entry.text);
             }
 
             break;
@@ -600,11 +600,11 @@ auto assembler::process_instruction(instruction const& inst) -> void
         case opcode::OP_EvalFieldVariable:
         case opcode::OP_EvalFieldVariableRef:
         case opcode::OP_ClearFieldVariable:
-            process_string(inst.data[0]);
+            process_string(inst.data[0].text);
             break;
         case opcode::OP_GetFunction:
-            process_string(inst.data[0]);
-            process_string(inst.data[1]);
+            process_string(inst.data[0].text);
+            process_string(inst.data[1].text);
             break;
         case opcode::OP_CallBuiltin:
         case opcode::OP_CallBuiltinMethod:
@@ -612,21 +612,21 @@ auto assembler::process_instruction(instruction const& inst) -> void
         case opcode::OP_ScriptMethodCall:
         case opcode::OP_ScriptThreadCall:
         case opcode::OP_ScriptMethodThreadCall:
-            process_string(inst.data[0]);
-            process_string(inst.data[1]);
+            process_string(inst.data[0].text);
+            process_string(inst.data[1].text);
             break;
         case opcode::OP_EndSwitch:
         {
-            auto count = std::stoul(inst.data[0]);
+            auto count = static_cast<usize>(inst.data[0].as_int());
 
             for (auto i = 0u; i < count; i++)
             {
                 if (inst.data[1 + (4 * i)] == "case")
                 {
-                    auto type = static_cast<switch_type>(std::stoul(inst.data[1 + (4 * i) + 1]));
+                    auto type = static_cast<switch_type>(inst.data[1 + (4 * i) + 1].as_int());
 
                     if (type == switch_type::string)
-                        process_string(inst.data[1 + (4 * i) + 2]);
+                        process_string(inst.data[1 + (4 * i) + 2].text);
                 }
             }
 
@@ -753,7 +753,7 @@ auto assembler::align_instruction(instruction& inst) -> void
         case opcode::OP_GetString:
         case opcode::OP_GetIString:
             inst.size += script_.align(2);
-            add_stringref(inst.data[0], string_type::literal, static_cast<u32>(script_.pos()));
+            add_stringref(inst.data[0].text, string_type::literal, static_cast<u32>(script_.pos()));
             script_.seek(2);
             break;
         case opcode::OP_GetAnimation:
@@ -778,7 +778,7 @@ auto assembler::align_instruction(instruction& inst) -> void
             for (auto i = 0u; i < inst.data.size(); i++)
             {
                 inst.size += script_.align(2) + 2;
-                add_stringref(inst.data[i], string_type::canonical, static_cast<u32>(script_.pos()));
+                add_stringref(inst.data[i].text, string_type::canonical, static_cast<u32>(script_.pos()));
                 script_.seek(2);
             }
 
@@ -795,7 +795,7 @@ auto assembler::align_instruction(instruction& inst) -> void
         case opcode::OP_EvalFieldVariableRef:
         case opcode::OP_ClearFieldVariable:
             inst.size += script_.align(2);
-            add_stringref(inst.data[0], string_type::canonical, static_cast<u32>(script_.pos()));
+            add_stringref(inst.data[0].text, string_type::canonical, static_cast<u32>(script_.pos()));
             script_.seek(2);
             break;
         case opcode::OP_ScriptFunctionCallPointer:
@@ -839,13 +839,13 @@ auto assembler::align_instruction(instruction& inst) -> void
             inst.size += script_.align(4);
             script_.seek(4);
 
-            auto count = std::stoul(inst.data[0]);
+            auto count = static_cast<usize>(inst.data[0].as_int());
 
             for (auto i = 0u; i < count; i++)
             {
-                if (inst.data[1 + (4 * i)] == "case" && static_cast<switch_type>(std::stoul(inst.data[1 + (4 * i) + 1])) == switch_type::string)
+                if (inst.data[1 + (4 * i)] == "case" && static_cast<switch_type>(inst.data[1 + (4 * i) + 1].as_int()) == switch_type::string)
                 {
-                    add_stringref(inst.data[1 + (4 * i) + 2], string_type::literal, static_cast<u32>(script_.pos() + 2));
+                    add_stringref(inst.data[1 + (4 * i) + 2].text, string_type::literal, static_cast<u32>(script_.pos() + 2));
                 }
 
                 inst.size += 8;
@@ -895,42 +895,45 @@ auto assembler::add_stringref(std::string const& str, string_type type, u32 ref)
     strings_.push_back({ str, u8(type), { ref } });
 }
 
-auto assembler::add_importref(std::vector<std::string> const& data, u32 ref) -> void
+auto assembler::add_importref(std::vector<operand> const& data, u32 ref) -> void
 {
     for (auto& entry : imports_)
     {
-        if (entry.space == data[0] && entry.name == data[1] && entry.params == std::stoi(data[2]) && entry.flags == std::stoi(data[3]))
+        if (entry.space == data[0].text && entry.name == data[1].text && entry.params == data[2].as_int() && entry.flags == data[3].as_int())
         {
             return entry.refs.push_back(ref);
         }
     }
 
     import_ref new_entry;
-    new_entry.space = data[0];
-    new_entry.name = data[1];
-    new_entry.params = static_cast<u8>(std::stoi(data[2]));
-    new_entry.flags = static_cast<u8>(std::stoi(data[3]));
+    new_entry.space = data[0].text;
+    new_entry.name = data[1].text;
+    new_entry.params = static_cast<u8>(data[2].as_int());
+    new_entry.flags = static_cast<u8>(data[3].as_int());
     new_entry.refs.push_back(ref);
     imports_.push_back(std::move(new_entry));
 }
 
-auto assembler::add_animref(std::vector<std::string> const& data, u32 ref) -> void
+auto assembler::add_animref(std::vector<operand> const& data, u32 ref) -> void
 {
+    // animtree integers carry -1 in place of an animation name
+    auto const tree = !data[1].is_string() || data[1].text == "-1";
+
     for (auto& entry : anims_)
     {
-        if (entry.name != data[0])
+        if (entry.name != data[0].text)
             continue;
 
-        return (data[1] == "-1") ? entry.refs.push_back(ref) : entry.anims.push_back({ data[1], ref });
+        return tree ? entry.refs.push_back(ref) : entry.anims.push_back({ data[1].text, ref });
     }
 
     animtree_ref new_entry;
-    new_entry.name = data[0];
+    new_entry.name = data[0].text;
 
-    if (data[1] == "-1")
+    if (tree)
         new_entry.refs.push_back(ref);
     else
-        new_entry.anims.push_back({ data[1], ref });
+        new_entry.anims.push_back({ data[1].text, ref });
 
     anims_.push_back(std::move(new_entry));
 }
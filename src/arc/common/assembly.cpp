@@ -0,0 +1,125 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/utils/string.hpp"
+#include "xsk/arc/common/assembly.hpp"
+
+namespace xsk::arc
+{
+
+auto operand::make_label(std::string name) -> operand
+{
+    auto res = operand{ std::move(name) };
+    res.type = kind::label;
+    return res;
+}
+
+auto operand::make_int(i64 value) -> operand
+{
+    auto res = operand{ std::string{} };
+    res.type = kind::integer;
+    res.integer = value;
+    return res;
+}
+
+auto operand::make_float(f32 value) -> operand
+{
+    auto res = operand{ std::string{} };
+    res.type = kind::number;
+    res.number = value;
+    return res;
+}
+
+auto operand::make_vector(f32 value) -> operand
+{
+    auto res = operand{ std::string{} };
+    res.type = kind::vector;
+    res.number = value;
+    return res;
+}
+
+auto operand::make_hash(u64 value, u8 width) -> operand
+{
+    auto res = operand{ std::string{} };
+    res.type = kind::hash;
+    res.width = width;
+    res.hash = value;
+    return res;
+}
+
+// operands parsed from gscasm text are strings until the assembler reads them
+auto operand::as_int() const -> i64
+{
+    switch (type)
+    {
+        case kind::integer:
+            return integer;
+        case kind::number:
+        case kind::vector:
+            return static_cast<i64>(number);
+        case kind::hash:
+            return static_cast<i64>(hash);
+        default:
+            return std::stoll(text);
+    }
+}
+
+auto operand::as_float() const -> f32
+{
+    switch (type)
+    {
+        case kind::integer:
+            return static_cast<f32>(integer);
+        case kind::number:
+        case kind::vector:
+            return number;
+        case kind::hash:
+            return static_cast<f32>(hash);
+        default:
+            return std::stof(text);
+    }
+}
+
+auto operand::as_hash() const -> u64
+{
+    switch (type)
+    {
+        case kind::integer:
+            return static_cast<u64>(integer);
+        case kind::hash:
+            return hash;
+        case kind::number:
+        case kind::vector:
+            return static_cast<u64>(number);
+        default:
+            return std::stoull(text, nullptr, 16);
+    }
+}
+
+// disassembled labels are named after the offset they point at
+auto operand::as_label() const -> usize
+{
+    return static_cast<usize>(std::stoull(text.substr(4), nullptr, 16));
+}
+
+auto operand::to_string() const -> std::string
+{
+    switch (type)
+    {
+        case kind::integer:
+            return std::format("{}", integer);
+        case kind::number:
+            return utils::string::float_string(number);
+        case kind::vector:
+            return utils::string::float_string(number, true);
+        case kind::hash:
+            return std::format("0x{:016X}", hash);
+        default:
+            return text;
+    }
+}
+
+} // namespace xsk::arc
@@ -6,6 +6,7 @@
 #include "xsk/stdinc.hpp"
 #include "xsk/arc/common/location.hpp"
 #include "xsk/arc/common/asset.hpp"
+#include "xsk/arc/common/assembly.hpp"
 #include "xsk/arc/common/ast.hpp"
 
 namespace xsk::arc
@@ -825,35 +826,35 @@ stmt_prof_end::stmt_prof_end(location const& loc, expr_arguments::ptr args) : st
 {
 }
 
-stmt_jmp::stmt_jmp(location const& loc, std::string const& value) : stmt{ type::stmt_jmp, loc }, value{ value }
+stmt_jmp::stmt_jmp(location const& loc, usize value) : stmt{ type::stmt_jmp, loc }, value{ value }
 {
 }
 
-stmt_jmp_back::stmt_jmp_back(location const& loc, std::string const& value) : stmt{ type::stmt_jmp_back, loc }, value{ value }
+stmt_jmp_back::stmt_jmp_back(location const& loc, usize value) : stmt{ type::stmt_jmp_back, loc }, value{ value }
 {
 }
 
-stmt_jmp_cond::stmt_jmp_cond(location const& loc, expr::ptr test, std::string const& value) : stmt{ type::stmt_jmp_cond, loc }, test{ std::move(test) }, value{ value }
+stmt_jmp_cond::stmt_jmp_cond(location const& loc, expr::ptr test, usize value) : stmt{ type::stmt_jmp_cond, loc }, test{ std::move(test) }, value{ value }
 {
 }
 
-stmt_jmp_true::stmt_jmp_true(location const& loc, expr::ptr test, std::string const& value) : stmt{ type::stmt_jmp_true, loc }, test{ std::move(test) }, value{ value }
+stmt_jmp_true::stmt_jmp_true(location const& loc, expr::ptr test, usize value) : stmt{ type::stmt_jmp_true, loc }, test{ std::move(test) }, value{ value }
 {
 }
 
-stmt_jmp_false::stmt_jmp_false(location const& loc, expr::ptr test, std::string const& value) : stmt{ type::stmt_jmp_false, loc }, test{ std::move(test) }, value{ value }
+stmt_jmp_false::stmt_jmp_false(location const& loc, expr::ptr test, usize value) : stmt{ type::stmt_jmp_false, loc }, test{ std::move(test) }, value{ value }
 {
 }
 
-stmt_jmp_switch::stmt_jmp_switch(location const& loc, expr::ptr test, std::string const& value) : stmt{ type::stmt_jmp_switch, loc }, test{ std::move(test) }, value{ value }
+stmt_jmp_switch::stmt_jmp_switch(location const& loc, expr::ptr test, usize value) : stmt{ type::stmt_jmp_switch, loc }, test{ std::move(test) }, value{ value }
 {
 }
 
-stmt_jmp_endswitch::stmt_jmp_endswitch(location const& loc, std::vector<std::string> data) : stmt{ type::stmt_jmp_endswitch, loc }, data{ std::move(data) }
+stmt_jmp_endswitch::stmt_jmp_endswitch(location const& loc, std::vector<operand> data) : stmt{ type::stmt_jmp_endswitch, loc }, data{ std::move(data) }
 {
 }
 
-stmt_jmp_dev::stmt_jmp_dev(location const& loc, std::string const& value) : stmt{ type::stmt_jmp_dev, loc }, value{ value }
+stmt_jmp_dev::stmt_jmp_dev(location const& loc, usize value) : stmt{ type::stmt_jmp_dev, loc }, value{ value }
 {
 }
 
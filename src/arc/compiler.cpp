@@ -22,6 +22,8 @@ auto compiler::compile(program const& data) -> assembly::ptr
 
 auto compiler::compile(std::string const& file, std::vector<u8>& data) -> assembly::ptr
 {
+    ctx_->init_dependencies();
+
     auto prog = ctx_->source().parse_program(file, data);
     return compile(*prog);
 }
@@ -327,7 +329,7 @@ auto compiler::emit_stmt_waittill(stmt_waittill const& stm) -> void
         if (entry->is<expr_undefined>())
             emit_opcode(opcode::OP_SafeDecTop);
         else
-            emit_opcode(opcode::OP_SafeSetWaittillVariableFieldCached, std::format("{}", variable_access(entry->as<expr_identifier>())));
+            emit_opcode(opcode::OP_SafeSetWaittillVariableFieldCached, operand::make_int(variable_access(entry->as<expr_identifier>())));
     }
 
     emit_opcode(opcode::OP_ClearParams);
@@ -338,7 +340,7 @@ auto compiler::emit_stmt_waittillmatch(stmt_waittillmatch const& stm) -> void
     emit_expr_arguments(*stm.args);
     emit_expr(*stm.event);
     emit_expr(*stm.obj);
-    emit_opcode(opcode::OP_WaitTillMatch, std::format("{}", stm.args->list.size()));
+    emit_opcode(opcode::OP_WaitTillMatch, operand::make_int(stm.args->list.size()));
     emit_opcode(opcode::OP_ClearParams);
 }
 
@@ -532,7 +534,7 @@ auto compiler::emit_stmt_foreach(stmt_foreach const& stm) -> void
     can_continue_ = true;
 
     emit_expr_variable(*stm.key);
-    emit_opcode(opcode::OP_EvalLocalVariableCached, std::format("{}", variable_access(stm.array->as<expr_identifier>())));
+    emit_opcode(opcode::OP_EvalLocalVariableCached, operand::make_int(variable_access(stm.array->as<expr_identifier>())));
     emit_opcode(opcode::OP_EvalArray);
     emit_expr_variable_ref(*stm.value, true);
 
@@ -569,8 +571,8 @@ auto compiler::emit_stmt_switch(stmt_switch const& stm) -> void
 
     can_break_ = true;
 
-    auto data = std::vector<std::string>{};
-    data.push_back(std::format("{}", stm.body->block->list.size()));
+    auto data = std::vector<operand>{};
+    data.push_back(operand::make_int(stm.body->block->list.size()));
 
     auto loc_default = std::string{};
     auto has_default = false;
@@ -585,13 +587,13 @@ auto compiler::emit_stmt_switch(stmt_switch const& stm) -> void
 
             if (entry->as<stmt_case>().value->is<expr_integer>())
             {
-                data.push_back(std::format("{}", static_cast<i32>(switch_type::integer)));
-                data.push_back(entry->as<stmt_case>().value->as<expr_integer>().value);
+                data.push_back(operand::make_int(static_cast<i32>(switch_type::integer)));
+                data.push_back(operand::make_int(std::stoll(entry->as<stmt_case>().value->as<expr_integer>().value)));
                 data.push_back(insert_label());
             }
             else if (entry->as<stmt_case>().value->is<expr_string>())
             {
-                data.push_back(std::format("{}", static_cast<i32>(switch_type::string)));
+                data.push_back(operand::make_int(static_cast<i32>(switch_type::string)));
                 data.push_back(entry->as<stmt_case>().value->as<expr_string>().value);
                 data.push_back(insert_label());
             }
@@ -1114,7 +1116,7 @@ auto compiler::emit_expr_call_pointer(expr_pointer const& exp, bool is_stmt) ->
     emit_expr_arguments(*exp.args);
     emit_expr(*exp.func);
 
-    auto argcount = std::format("{}", exp.args->list.size());
+    auto argcount = operand::make_int(exp.args->list.size());
 
     switch (exp.mode)
     {
@@ -1167,18 +1169,18 @@ auto compiler::emit_expr_call_function(expr_function const& exp, bool is_stmt) -
     emit_opcode(opcode::OP_PreScriptCall);
     emit_expr_arguments(*exp.args);
 
-    auto argcount = std::format("{}", exp.args->list.size());
+    auto argcount = operand::make_int(exp.args->list.size());
     auto flags = developer_thread_ ? static_cast<u8>(import_flags::developer) : 0;
 
     switch (exp.mode)
     {
         case call::mode::normal:
             flags |= static_cast<u8>(import_flags::func_call);
-            emit_opcode(opcode::OP_ScriptFunctionCall, { exp.path->value, exp.name->value, argcount, std::format("{}", flags) });
+            emit_opcode(opcode::OP_ScriptFunctionCall, { exp.path->value, exp.name->value, argcount, operand::make_int(flags) });
             break;
         case call::mode::thread:
             flags |= static_cast<u8>(import_flags::func_call_thread);
-            emit_opcode(opcode::OP_ScriptThreadCall, { exp.path->value, exp.name->value, argcount, std::format("{}", flags) });
+            emit_opcode(opcode::OP_ScriptThreadCall, { exp.path->value, exp.name->value, argcount, operand::make_int(flags) });
             break;
         default:
             break;
@@ -1211,7 +1213,7 @@ auto compiler::emit_expr_method_pointer(expr_pointer const& exp, expr const& obj
     emit_expr(obj);
     emit_expr(*exp.func);
 
-    auto argcount = std::format("{}", exp.args->list.size());
+    auto argcount = operand::make_int(exp.args->list.size());
 
     switch (exp.mode)
     {
@@ -1254,18 +1256,18 @@ auto compiler::emit_expr_method_function(expr_function const& exp, expr const& o
     emit_expr_arguments(*exp.args);
     emit_expr(obj);
 
-    auto argcount = std::format("{}", exp.args->list.size());
+    auto argcount = operand::make_int(exp.args->list.size());
     auto flags = developer_thread_ ? static_cast<u8>(import_flags::developer) : 0;
 
     switch (exp.mode)
     {
         case call::mode::normal:
             flags |= static_cast<u8>(import_flags::meth_call);
-            emit_opcode(opcode::OP_ScriptMethodCall, { exp.path->value, exp.name->value, argcount, std::format("{}", flags) });
+            emit_opcode(opcode::OP_ScriptMethodCall, { exp.path->value, exp.name->value, argcount, operand::make_int(flags) });
             break;
         case call::mode::thread:
             flags |= static_cast<u8>(import_flags::meth_call_thread);
-            emit_opcode(opcode::OP_ScriptMethodThreadCall, { exp.path->value, exp.name->value, argcount, std::format("{}", flags) });
+            emit_opcode(opcode::OP_ScriptMethodThreadCall, { exp.path->value, exp.name->value, argcount, operand::make_int(flags) });
             break;
         default:
             break;
@@ -1283,7 +1285,7 @@ auto compiler::emit_expr_parameters(expr_parameters const& exp) -> void
     }
     else
     {
-        emit_opcode(opcode::OP_SafeCreateLocalVariables, stackframe_);
+        emit_opcode(opcode::OP_SafeCreateLocalVariables, std::vector<operand>(stackframe_.begin(), stackframe_.end()));
     }
 
     for (auto const& entry : exp.list)
@@ -1450,7 +1452,7 @@ auto compiler::emit_expr_reference(expr_reference const& exp) -> void
     auto flags = developer_thread_ ? static_cast<u8>(import_flags::developer) : 0;
     flags |= static_cast<u8>(import_flags::func_reference);
 
-    emit_opcode(opcode::OP_GetFunction, { exp.path->value, exp.name->value, "0", std::format("{}", flags) });
+    emit_opcode(opcode::OP_GetFunction, { exp.path->value, exp.name->value, operand::make_int(0), operand::make_int(flags) });
 }
 
 auto compiler::emit_expr_size(expr_size const& exp) -> void
@@ -1536,7 +1538,7 @@ auto compiler::emit_expr_field_ref(expr_field const& exp, bool set) -> void
             if (set) emit_opcode(opcode::OP_SetVariableField);
             break;
         case node::expr_identifier:
-            emit_opcode(opcode::OP_EvalLocalVariableCached, std::format("{}", variable_access(exp.obj->as<expr_identifier>())));
+            emit_opcode(opcode::OP_EvalLocalVariableCached, operand::make_int(variable_access(exp.obj->as<expr_identifier>())));
             emit_opcode(opcode::OP_CastFieldObject);
             emit_opcode(opcode::OP_EvalFieldVariableRef, field);
             if (set) emit_opcode(opcode::OP_SetVariableField);
@@ -1567,7 +1569,7 @@ auto compiler::emit_expr_local_ref(expr_identifier const& exp, bool set) -> void
         throw comp_error(exp.loc(), std::format("variable name already defined as constant '{}'", exp.value));
     }
 
-    emit_opcode(opcode::OP_EvalLocalVariableRefCached, std::format("{}", variable_access(exp)));
+    emit_opcode(opcode::OP_EvalLocalVariableRefCached, operand::make_int(variable_access(exp)));
 
     if (set)
     {
@@ -1639,7 +1641,7 @@ auto compiler::emit_expr_field(expr_field const& exp) -> void
             emit_opcode(opcode::OP_EvalFieldVariable, field);
             break;
         case node::expr_identifier:
-            emit_opcode(opcode::OP_EvalLocalVariableCached, std::format("{}", variable_access(exp.obj->as<expr_identifier>())));
+            emit_opcode(opcode::OP_EvalLocalVariableCached, operand::make_int(variable_access(exp.obj->as<expr_identifier>())));
             emit_opcode(opcode::OP_CastFieldObject);
             emit_opcode(opcode::OP_EvalFieldVariable, field);
             break;
@@ -1655,7 +1657,7 @@ auto compiler::emit_expr_local(expr_identifier const& exp) -> void
     if (it != constants_.end())
         emit_expr(*it->second);
     else
-        emit_opcode(opcode::OP_EvalLocalVariableCached, std::format("{}", variable_access(exp)));
+        emit_opcode(opcode::OP_EvalLocalVariableCached, operand::make_int(variable_access(exp)));
 }
 
 auto compiler::emit_expr_object(expr const& exp) -> void
@@ -1688,7 +1690,7 @@ auto compiler::emit_expr_object(expr const& exp) -> void
             emit_opcode(opcode::OP_CastFieldObject);
             break;
         case node::expr_identifier:
-            emit_opcode(opcode::OP_EvalLocalVariableCached, std::format("{}", variable_access(exp.as<expr_identifier>())));
+            emit_opcode(opcode::OP_EvalLocalVariableCached, operand::make_int(variable_access(exp.as<expr_identifier>())));
             emit_opcode(opcode::OP_CastFieldObject);
             break;
         default:
@@ -1698,14 +1700,14 @@ auto compiler::emit_expr_object(expr const& exp) -> void
 
 auto compiler::emit_expr_vector(expr_vector const& exp) -> void
 {
-    auto data = std::vector<std::string>{};
+    auto data = std::vector<operand>{};
     auto isconst = true;
     auto flags = 0;
 
     if (exp.x->is<expr_integer>())
     {
         auto value = std::atoi(exp.x->as<expr_integer>().value.data());
-        data.push_back(exp.x->as<expr_integer>().value);
+        data.push_back(operand::make_float(static_cast<f32>(value)));
 
         if (value != 1 && value != -1 && value != 0)
             isconst = false;
@@ -1715,7 +1717,7 @@ auto compiler::emit_expr_vector(expr_vector const& exp) -> void
     else if (exp.x->is<expr_float>())
     {
         auto value = std::stof(exp.x->as<expr_float>().value.data());
-        data.push_back(exp.x->as<expr_float>().value);
+        data.push_back(operand::make_float(value));
 
         if (value != 1.0 && value != -1.0 && value != 0.0)
             isconst = false;
@@ -1730,7 +1732,7 @@ auto compiler::emit_expr_vector(expr_vector const& exp) -> void
     if (exp.y->is<expr_integer>())
     {
         auto value = std::atoi(exp.y->as<expr_integer>().value.data());
-        data.push_back(exp.y->as<expr_integer>().value);
+        data.push_back(operand::make_float(static_cast<f32>(value)));
 
         if (value != 1 && value != -1 && value != 0)
             isconst = false;
@@ -1740,7 +1742,7 @@ auto compiler::emit_expr_vector(expr_vector const& exp) -> void
     else if (exp.y->is<expr_float>())
     {
         auto value = std::stof(exp.y->as<expr_float>().value.data());
-        data.push_back(exp.y->as<expr_float>().value);
+        data.push_back(operand::make_float(value));
 
         if (value != 1.0 && value != -1.0 && value != 0.0)
             isconst = false;
@@ -1755,7 +1757,7 @@ auto compiler::emit_expr_vector(expr_vector const& exp) -> void
     if (exp.z->is<expr_integer>())
     {
         auto value = std::atoi(exp.z->as<expr_integer>().value.data());
-        data.push_back(exp.z->as<expr_integer>().value);
+        data.push_back(operand::make_float(static_cast<f32>(value)));
 
         if (value != 1 && value != -1 && value != 0)
             isconst = false;
@@ -1765,7 +1767,7 @@ auto compiler::emit_expr_vector(expr_vector const& exp) -> void
     else if (exp.z->is<expr_float>())
     {
         auto value = std::stof(exp.z->as<expr_float>().value.data());
-        data.push_back(exp.z->as<expr_float>().value);
+        data.push_back(operand::make_float(value));
 
         if (value != 1.0 && value != -1.0 && value != 0.0)
             isconst = false;
@@ -1779,7 +1781,7 @@ auto compiler::emit_expr_vector(expr_vector const& exp) -> void
 
     if (isconst)
     {
-        emit_opcode(opcode::OP_VectorConstant, std::format("{}", flags));
+        emit_opcode(opcode::OP_VectorConstant, operand::make_int(flags));
     }
     else
     {
@@ -1811,7 +1813,7 @@ auto compiler::emit_expr_animtree(expr_animtree const& exp) -> void
         throw comp_error(exp.loc(), "trying to use animtree without specified using animtree");
     }
 
-    emit_opcode(opcode::OP_GetInteger, { animtree_, "-1" });
+    emit_opcode(opcode::OP_GetInteger, { animtree_, operand::make_int(-1) });
 }
 
 auto compiler::emit_expr_istring(expr_istring const& exp) -> void
@@ -1831,7 +1833,7 @@ auto compiler::emit_expr_hash(expr_hash const& exp) -> void
 
 auto compiler::emit_expr_float(expr_float const& exp) -> void
 {
-    emit_opcode(opcode::OP_GetFloat, exp.value);
+    emit_opcode(opcode::OP_GetFloat, operand::make_float(std::stof(exp.value)));
 }
 
 auto compiler::emit_expr_integer(expr_integer const& exp) -> void
@@ -1844,23 +1846,23 @@ auto compiler::emit_expr_integer(expr_integer const& exp) -> void
     }
     else if (value > 0 && value < 256)
     {
-        emit_opcode(opcode::OP_GetByte, exp.value);
+        emit_opcode(opcode::OP_GetByte, operand::make_int(value));
     }
     else if (value < 0 && value > -256)
     {
-        emit_opcode(opcode::OP_GetNegByte, exp.value.substr(1));
+        emit_opcode(opcode::OP_GetNegByte, operand::make_int(-value));
     }
     else if (value > 0 && value < 65536)
     {
-        emit_opcode(opcode::OP_GetUnsignedShort, exp.value);
+        emit_opcode(opcode::OP_GetUnsignedShort, operand::make_int(value));
     }
     else if (value < 0 && value > -65536)
     {
-        emit_opcode(opcode::OP_GetNegUnsignedShort, exp.value.substr(1));
+        emit_opcode(opcode::OP_GetNegUnsignedShort, operand::make_int(-value));
     }
     else
     {
-        emit_opcode(opcode::OP_GetInteger, exp.value);
+        emit_opcode(opcode::OP_GetInteger, operand::make_int(value));
     }
 }
 
@@ -1887,7 +1889,7 @@ auto compiler::emit_opcode(opcode op) -> void
     index_ += inst->size;
 }
 
-auto compiler::emit_opcode(opcode op, std::string const& data) -> void
+auto compiler::emit_opcode(opcode op, operand data) -> void
 {
     function_->instructions.push_back(instruction::make());
 
@@ -1895,13 +1897,13 @@ auto compiler::emit_opcode(opcode op, std::string const& data) -> void
     inst->opcode = op;
     inst->size = ctx_->opcode_size(op);
     inst->index = index_;
-    inst->data.push_back(data);
+    inst->data.push_back(std::move(data));
     inst->pos = debug_pos_;
 
     index_ += inst->size;
 }
 
-auto compiler::emit_opcode(opcode op, std::vector<std::string> const& data) -> void
+auto compiler::emit_opcode(opcode op, std::vector<operand> data) -> void
 {
     function_->instructions.push_back(instruction::make());
 
@@ -1909,7 +1911,7 @@ auto compiler::emit_opcode(opcode op, std::vector<std::string> const& data) -> v
     inst->opcode = op;
     inst->size = ctx_->opcode_size(op);
     inst->index = index_;
-    inst->data = data;
+    inst->data = std::move(data);
     inst->pos = debug_pos_;
 
     index_ += inst->size;
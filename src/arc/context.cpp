@@ -11,18 +11,61 @@ namespace xsk::arc
 
 extern std::array<std::pair<opcode, std::string_view>, opcode_count> const opcode_list;
 
-context::context(arc::props props, arc::engine engine, arc::endian endian, arc::system system, arc::instance inst, u64 magic)
-    : props_{ props }, engine_{ engine }, endian_{ endian }, system_{ system }, instance_{ inst }, magic_{ magic },
-      source_{ this }, assembler_{ this }, disassembler_{ this }, compiler_{ this }, decompiler_{ this }
+auto opcode_map() -> std::array<std::string_view, 256> const&
+{
+    static auto const shared = []
+    {
+        auto data = std::array<std::string_view, 256>{};
+
+        for (auto const& entry : opcode_list)
+        {
+            data[static_cast<u8>(entry.first)] = entry.second;
+        }
+
+        return data;
+    }();
+
+    return shared;
+}
+
+auto opcode_map_rev() -> std::unordered_map<std::string_view, opcode> const&
 {
-    opcode_map_.reserve(opcode_list.size());
-    opcode_map_rev_.reserve(opcode_list.size());
+    static auto const shared = []
+    {
+        auto data = std::unordered_map<std::string_view, opcode>{};
+        data.reserve(opcode_list.size());
+
+        for (auto const& entry : opcode_list)
+        {
+            data.insert({ entry.second, entry.first });
+        }
+
+        return data;
+    }();
 
-    for (auto const& entry : opcode_list)
+    return shared;
+}
+
+auto tables::add_code(u16 id, opcode op) -> void
+{
+    if (code_map.size() <= id)
     {
-        opcode_map_.insert({ entry.first, entry.second });
-        opcode_map_rev_.insert({ entry.second, entry.first });
+        code_map.resize(id + 1, opcode::OP_Invalid);
     }
+
+    // keep the first id of an opcode, like the map insertion did
+    if (code_map[code_map_rev[static_cast<u8>(op)]] != op)
+    {
+        code_map_rev[static_cast<u8>(op)] = id;
+    }
+
+    code_map[id] = op;
+}
+
+context::context(arc::props props, arc::engine engine, arc::endian endian, arc::system system, arc::instance inst, u64 magic, arc::tables const& tables)
+    : props_{ props }, engine_{ engine }, endian_{ endian }, system_{ system }, instance_{ inst }, magic_{ magic },
+      source_{ this }, assembler_{ this }, disassembler_{ this }, compiler_{ this }, decompiler_{ this }, tables_{ tables }
+{
 }
 
 auto context::init(arc::build build, fs_callback callback) -> void
@@ -33,6 +76,8 @@ auto context::init(arc::build build, fs_callback callback) -> void
 
 auto context::cleanup() -> void
 {
+    header_files_.clear();
+    dependencies_.clear();
 }
 
 auto context::engine_name() const -> std::string_view
@@ -212,11 +257,11 @@ auto context::opcode_size(opcode op) const -> u32
 
 auto context::opcode_id(opcode op) const -> u16
 {
-    auto const itr = code_map_rev_.find(op);
+    auto const id = tables_.code_map_rev[static_cast<u8>(op)];
 
-    if (itr != code_map_rev_.end())
+    if (op != opcode::OP_Invalid && id < tables_.code_map.size() && tables_.code_map[id] == op)
     {
-        return itr->second;
+        return id;
     }
 
     throw error(std::format("couldn't resolve opcode id for '{}'", opcode_name(op)));
@@ -224,11 +269,11 @@ auto context::opcode_id(opcode op) const -> u16
 
 auto context::opcode_name(opcode op) const -> std::string
 {
-    auto const itr = opcode_map_.find(op);
+    auto const name = opcode_map()[static_cast<u8>(op)];
 
-    if (itr != opcode_map_.end())
+    if (!name.empty())
     {
-        return std::string{ itr->second };
+        return std::string{ name };
     }
 
     throw std::runtime_error(std::format("couldn't resolve opcode string for enum '{}'", static_cast<std::underlying_type_t<opcode>>(op)));
@@ -236,9 +281,10 @@ auto context::opcode_name(opcode op) const -> std::string
 
 auto context::opcode_enum(std::string const& name) const -> opcode
 {
-    auto const itr = opcode_map_rev_.find(name);
+    auto const& map = opcode_map_rev();
+    auto const itr = map.find(name);
 
-    if (itr != opcode_map_rev_.end())
+    if (itr != map.end())
     {
         return itr->second;
     }
@@ -248,14 +294,7 @@ auto context::opcode_enum(std::string const& name) const -> opcode
 
 auto context::opcode_enum(u16 id) const -> opcode
 {
-    auto const itr = code_map_.find(id);
-
-    if (itr != code_map_.end())
-    {
-        return itr->second;
-    }
-
-    return opcode::OP_Invalid;
+    return (id < tables_.code_map.size()) ? tables_.code_map[id] : opcode::OP_Invalid;
 }
 
 auto context::hash_id(std::string const& name) const -> u32
@@ -295,9 +334,9 @@ auto context::hash_id(std::string const& name) const -> u32
 
 auto context::hash_name(u32 id) const -> std::string
 {
-    auto const itr = hash_map_.find(id);
+    auto const itr = tables_.hash_map.find(id);
 
-    if (itr != hash_map_.end())
+    if (itr != tables_.hash_map.end())
     {
         return std::string(itr->second);
     }
@@ -325,6 +364,9 @@ auto context::make_token(std::string_view str) const -> std::string
 
 auto context::load_header(std::string const& name) -> std::tuple<std::string const*, char const*, usize>
 {
+    if (std::find(dependencies_.begin(), dependencies_.end(), name) == dependencies_.end())
+        dependencies_.push_back(name);
+
     auto const itr = header_files_.find(name);
 
     if (itr != header_files_.end())
@@ -347,6 +389,16 @@ auto context::load_header(std::string const& name) -> std::tuple<std::string con
     throw error(std::format("couldn't open gsh file '{}'", name));
 }
 
+auto context::init_dependencies() -> void
+{
+    dependencies_.clear();
+}
+
+auto context::invalidate(std::string const& name) -> void
+{
+    header_files_.erase(name);
+}
+
 extern std::array<std::pair<opcode, std::string_view>, opcode_count> const opcode_list
 {{
     { opcode::OP_Invalid, "OP_Invalid"  },
@@ -40,7 +40,21 @@ auto decompiler::decompile_function(function const& func) -> void
     locals_.clear();
     params_.clear();
     vars_.clear();
-    labels_ = func.labels;
+    labels_.clear();
+    jumps_.clear();
+
+    for (auto const& [offset, name] : func.labels)
+        labels_.insert(offset);
+
+    for (auto const& inst : func.instructions)
+    {
+        for (auto const& entry : inst->data)
+        {
+            if (entry.type == operand::kind::label)
+                jumps_[entry.as_label()].push_back(inst->index);
+        }
+    }
+
     in_waittill_ = false;
     retbool_ = true;
     locs_ = {};
@@ -86,7 +100,7 @@ auto decompiler::decompile_function(function const& func) -> void
     }
 
     auto& list = func_->body->block->list;
-    locs_.end = std::format("loc_{:X}", list.back()->loc().begin.line + 1);
+    locs_.end = list.back()->label() + 1;
 
     decompile_statements(*func_->body->block);
 
@@ -130,13 +144,13 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         case opcode::OP_GetByte:
         case opcode::OP_GetUnsignedShort:
         {
-            stack_.push(expr_integer::make(loc, inst.data[0]));
+            stack_.push(expr_integer::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_GetNegByte:
         case opcode::OP_GetNegUnsignedShort:
         {
-            stack_.push(expr_integer::make(loc, "-" + inst.data[0]));
+            stack_.push(expr_integer::make(loc, "-" + inst.data[0].to_string()));
             break;
         }
         case opcode::OP_GetInteger:
@@ -149,14 +163,14 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
                 {
                     if ((*i)->is<decl_usingtree>())
                     {
-                        found = (*i)->as<decl_usingtree>().name->value == inst.data[0];
+                        found = (*i)->as<decl_usingtree>().name->value == inst.data[0].text;
                         break;
                     }
                 }
 
                 if (!found)
                 {
-                    auto dec = decl_usingtree::make(loc, expr_string::make(loc, inst.data[0]));
+                    auto dec = decl_usingtree::make(loc, expr_string::make(loc, inst.data[0].to_string()));
                     program_->declarations.push_back(std::move(dec));
                 }
 
@@ -164,31 +178,31 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
             }
             else
             {
-                stack_.push(expr_integer::make(loc, inst.data[0]));
+                stack_.push(expr_integer::make(loc, inst.data[0].to_string()));
             }
             break;
         }
         case opcode::OP_GetFloat:
         {
-            stack_.push(expr_float::make(loc, inst.data[0]));
+            stack_.push(expr_float::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_GetVector:
         {
-            auto x = expr_float::make(loc, inst.data[0]);
-            auto y = expr_float::make(loc, inst.data[1]);
-            auto z = expr_float::make(loc, inst.data[2]);
+            auto x = expr_float::make(loc, inst.data[0].to_string());
+            auto y = expr_float::make(loc, inst.data[1].to_string());
+            auto z = expr_float::make(loc, inst.data[2].to_string());
             stack_.push(expr_vector::make(loc, std::move(x), std::move(y), std::move(z)));
             break;
         }
         case opcode::OP_GetString:
         {
-            stack_.push(expr_string::make(loc, inst.data[0]));
+            stack_.push(expr_string::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_GetIString:
         {
-            stack_.push(expr_istring::make(loc, inst.data[0]));
+            stack_.push(expr_istring::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_GetUndefined:
@@ -247,7 +261,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
             {
                 if ((*i)->is<decl_usingtree>())
                 {
-                    found = (*i)->as<decl_usingtree>().name->value == inst.data[0];
+                    found = (*i)->as<decl_usingtree>().name->value == inst.data[0].text;
                     space = (*i)->as<decl_usingtree>().name->value;
                     break;
                 }
@@ -257,30 +271,30 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
             {
                 if (space == "")
                 {
-                    auto dec = decl_usingtree::make(loc, expr_string::make(loc, inst.data[0]));
+                    auto dec = decl_usingtree::make(loc, expr_string::make(loc, inst.data[0].to_string()));
                     program_->declarations.push_back(std::move(dec));
-                    stack_.push(expr_animation::make(loc, "", inst.data[1]));
+                    stack_.push(expr_animation::make(loc, "", inst.data[1].to_string()));
                 }
                 else
                 {
-                    stack_.push(expr_animation::make(loc, inst.data[0], inst.data[1]));
+                    stack_.push(expr_animation::make(loc, inst.data[0].to_string(), inst.data[1].to_string()));
                 }
             }
-            else if (space == inst.data[0])
+            else if (space == inst.data[0].text)
             {
-                stack_.push(expr_animation::make(loc, "", inst.data[1]));
+                stack_.push(expr_animation::make(loc, "", inst.data[1].to_string()));
             }
             else
             {
-                stack_.push(expr_animation::make(loc, inst.data[0], inst.data[1]));
+                stack_.push(expr_animation::make(loc, inst.data[0].to_string(), inst.data[1].to_string()));
             }
 
             break;
         }
         case opcode::OP_GetFunction:
         {
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
             stack_.push(expr_reference::make(loc, std::move(path), std::move(name)));
             break;
         }
@@ -290,14 +304,14 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
             {
                 for (auto i = 0u; i < inst.data.size(); i += 2)
                 {
-                    locals_.insert(locals_.begin(), inst.data[i]);
-                    params_.insert(params_.begin(), static_cast<param_type>(std::stoul(inst.data[i + 1])));
+                    locals_.insert(locals_.begin(), inst.data[i].to_string());
+                    params_.insert(params_.begin(), static_cast<param_type>(inst.data[i + 1].as_int()));
                 }
             }
             else
             {
                 for (const auto& entry : inst.data)
-                    locals_.insert(locals_.begin(), entry);
+                    locals_.insert(locals_.begin(), entry.text);
             }
 
             break;
@@ -306,14 +320,14 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         {
             if (!ctx_->fixup())
             {
-                stack_.push(expr_identifier::make(loc, locals_.at(std::stoi(inst.data[0]))));
+                stack_.push(expr_identifier::make(loc, locals_.at(inst.data[0].as_int())));
                 break;
             }
             else // fix old compiler bug
             {
                 try
                 {
-                    stack_.push(expr_identifier::make(loc, locals_.at(std::stoi(inst.data[0]))));
+                    stack_.push(expr_identifier::make(loc, locals_.at(inst.data[0].as_int())));
                 }
                 catch (const std::exception&)
                 {
@@ -332,7 +346,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         case opcode::OP_EvalLocalArrayRefCached:
         {
             auto key = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            auto obj = expr_identifier::make(loc, locals_.at(std::stoi(inst.data[0])));
+            auto obj = expr_identifier::make(loc, locals_.at(inst.data[0].as_int()));
             stack_.push(expr_array::make(key->loc(), std::move(obj), std::move(key)));
             break;
         }
@@ -357,14 +371,14 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         case opcode::OP_EvalFieldVariable:
         {
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(obj->loc(), std::move(obj), std::move(field)));
             break;
         }
         case opcode::OP_EvalFieldVariableRef:
         {
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(obj->loc(), std::move(obj), std::move(field)));
             break;
         }
@@ -372,7 +386,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         {
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = obj->loc();
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
             auto field = expr_field::make(loc, std::move(obj), std::move(name));
             auto undef = expr_undefined::make(loc);
             auto exp = expr_assign::make(loc, std::move(field), std::move(undef), expr_assign::op::eq);
@@ -381,7 +395,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         }
         case opcode::OP_SafeSetWaittillVariableFieldCached:
         {
-            stack_.push(expr_identifier::make(loc, locals_.at(std::stoi(inst.data[0]))));
+            stack_.push(expr_identifier::make(loc, locals_.at(inst.data[0].as_int())));
             break;
         }
         case opcode::OP_ClearParams:
@@ -410,7 +424,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         }
         case opcode::OP_EvalLocalVariableRefCached:
         {
-            stack_.push(expr_identifier::make(loc, locals_.at(std::stoi(inst.data[0]))));
+            stack_.push(expr_identifier::make(loc, locals_.at(inst.data[0].as_int())));
             break;
         }
         case opcode::OP_SetVariableField:
@@ -425,8 +439,8 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         case opcode::OP_CallBuiltin:
         {
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
             auto var = std::move(stack_.top()); stack_.pop();
             loc = var->loc();
@@ -446,8 +460,8 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = obj->loc();
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
             auto var = std::move(stack_.top()); stack_.pop();
             loc = var->loc();
@@ -481,8 +495,8 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         case opcode::OP_ScriptFunctionCall:
         {
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
             auto var = std::move(stack_.top()); stack_.pop();
             loc = var->loc();
@@ -520,8 +534,8 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
             loc = obj->loc();
 
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
             auto var = std::move(stack_.top()); stack_.pop();
             loc = var->loc();
@@ -557,8 +571,8 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         case opcode::OP_ScriptThreadCall:
         {
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
             auto var = std::move(stack_.top()); stack_.pop();
             loc = var->loc();
@@ -598,8 +612,8 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
             loc = obj->loc();
 
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
             auto var = std::move(stack_.top()); stack_.pop();
             loc = var->loc();
@@ -661,14 +675,14 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
             auto lvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = lvalue->loc();
 
-            if (inst.index > resolve_label(inst.data[0]))
+            if (inst.index > inst.data[0].as_label())
             {
-                func_->body->block->list.push_back(stmt_jmp_cond::make(loc, std::move(lvalue), inst.data[0]));
+                func_->body->block->list.push_back(stmt_jmp_cond::make(loc, std::move(lvalue), inst.data[0].as_label()));
             }
             else
             {
                 auto test = expr_not::make(loc, std::move(lvalue));
-                func_->body->block->list.push_back(stmt_jmp_cond::make(loc, std::move(test), inst.data[0]));
+                func_->body->block->list.push_back(stmt_jmp_cond::make(loc, std::move(test), inst.data[0].as_label()));
             }
             break;
         }
@@ -677,40 +691,40 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
             auto lvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = lvalue->loc();
 
-            if (inst.index > resolve_label(inst.data[0]))
+            if (inst.index > inst.data[0].as_label())
             {
                 auto test = expr_not::make(loc, std::move(lvalue));
-                func_->body->block->list.push_back(stmt_jmp_cond::make(loc, std::move(test), inst.data[0]));
+                func_->body->block->list.push_back(stmt_jmp_cond::make(loc, std::move(test), inst.data[0].as_label()));
             }
             else
             {
-                func_->body->block->list.push_back(stmt_jmp_cond::make(lvalue->loc(), std::move(lvalue), inst.data[0]));
+                func_->body->block->list.push_back(stmt_jmp_cond::make(lvalue->loc(), std::move(lvalue), inst.data[0].as_label()));
             }
             break;
         }
         case opcode::OP_JumpOnTrueExpr:
         {
             auto test = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            stack_.push(stmt_jmp_true::make(test->loc(), std::move(test), inst.data[0]));
-            expr_labels_.push_back(inst.data[0]);
+            stack_.push(stmt_jmp_true::make(test->loc(), std::move(test), inst.data[0].as_label()));
+            expr_labels_.push_back(inst.data[0].as_label());
             break;
         }
         case opcode::OP_JumpOnFalseExpr:
         {
             auto test = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            stack_.push(stmt_jmp_false::make(test->loc(), std::move(test), inst.data[0]));
-            expr_labels_.push_back(inst.data[0]);
+            stack_.push(stmt_jmp_false::make(test->loc(), std::move(test), inst.data[0].as_label()));
+            expr_labels_.push_back(inst.data[0].as_label());
             break;
         }
         case opcode::OP_Jump:
         {
-            func_->body->block->list.push_back(stmt_jmp::make(loc, inst.data[0]));
-            if (stack_.size() != 0) tern_labels_.push_back(inst.data[0]);
+            func_->body->block->list.push_back(stmt_jmp::make(loc, inst.data[0].as_label()));
+            if (stack_.size() != 0) tern_labels_.push_back(inst.data[0].as_label());
             break;
         }
         case opcode::OP_JumpBack:
         {
-            func_->body->block->list.push_back(stmt_jmp_back::make(loc, inst.data[0]));
+            func_->body->block->list.push_back(stmt_jmp_back::make(loc, inst.data[0].as_label()));
             break;
         }
         case opcode::OP_Inc:
@@ -868,7 +882,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
             auto event = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = event->loc();
 
-            for (auto i = std::stoul(inst.data[0]); i > 0; i--)
+            for (auto i = inst.data[0].as_int(); i > 0; i--)
             {
                 auto arg = node::as<expr>(std::move(stack_.top())); stack_.pop();
                 loc = arg->loc();
@@ -920,7 +934,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         case opcode::OP_Switch:
         {
             auto test = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            func_->body->block->list.push_back(stmt_jmp_switch::make(test->loc(), std::move(test), inst.data[0]));
+            func_->body->block->list.push_back(stmt_jmp_switch::make(test->loc(), std::move(test), inst.data[0].as_label()));
             break;
         }
         case opcode::OP_EndSwitch:
@@ -938,7 +952,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         }
         case opcode::OP_GetHash:
         {
-            stack_.push(expr_hash::make(loc, inst.data[0]));
+            stack_.push(expr_hash::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_RealWait:
@@ -949,7 +963,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         }
         case opcode::OP_VectorConstant:
         {
-            auto flags = static_cast<std::uint8_t>(std::stoi(inst.data[0]));
+            auto flags = static_cast<std::uint8_t>(inst.data[0].as_int());
             auto x = expr_float::make(loc, (flags & 0x20) ? "1" : (flags & 0x10) ? "-1" : "0");
             auto y = expr_float::make(loc, (flags & 0x08) ? "1" : (flags & 0x04) ? "-1" : "0");
             auto z = expr_float::make(loc, (flags & 0x02) ? "1" : (flags & 0x01) ? "-1" : "0");
@@ -1086,7 +1100,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         case opcode::OP_LevelEvalFieldVariableRef:
         {
             auto obj = expr_level::make(loc);
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(loc, std::move(obj), std::move(field)));
             break;
         }
@@ -1094,18 +1108,18 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
         case opcode::OP_SelfEvalFieldVariableRef:
         {
             auto obj = expr_self::make(loc);
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(loc, std::move(obj), std::move(field)));
             break;
         }
         case opcode::OP_DevblockBegin:
         {
-            func_->body->block->list.push_back(stmt_jmp_dev::make(loc, inst.data[0]));
+            func_->body->block->list.push_back(stmt_jmp_dev::make(loc, inst.data[0].as_label()));
             break;
         }
         case opcode::OP_New:
         {
-            stack_.push(expr_new::make(loc, expr_identifier::make(loc, inst.data[0])));
+            stack_.push(expr_new::make(loc, expr_identifier::make(loc, inst.data[0].to_string())));
             break;
         }
         case opcode::OP_ScriptFunctionCallClass:
@@ -1124,7 +1138,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
                     loc = var->loc();
                 }
 
-                stack_.push(expr_call::make(loc, expr_member::make(loc, std::move(obj), expr_identifier::make(loc, inst.data[0]), std::move(args), call::mode::normal)));
+                stack_.push(expr_call::make(loc, expr_member::make(loc, std::move(obj), expr_identifier::make(loc, inst.data[0].to_string()), std::move(args), call::mode::normal)));
             }
             break;
         }
@@ -1144,7 +1158,7 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
                     loc = var->loc();
                 }
 
-                stack_.push(expr_call::make(loc, expr_member::make(loc, std::move(obj), expr_identifier::make(loc, inst.data[0]), std::move(args), call::mode::thread)));
+                stack_.push(expr_call::make(loc, expr_member::make(loc, std::move(obj), expr_identifier::make(loc, inst.data[0].to_string()), std::move(args), call::mode::thread)));
             }
             break;
         }
@@ -1175,14 +1189,12 @@ auto decompiler::decompile_instruction(instruction const& inst, bool last) -> vo
 
 auto decompiler::decompile_expressions(instruction const& inst) -> void
 {
-    auto const itr = labels_.find(inst.index);
-
-    if (itr == labels_.end())
+    if (!labels_.contains(inst.index))
         return;
 
-    for (auto const& exp : expr_labels_)
+    for (auto const exp : expr_labels_)
     {
-        if (exp == itr->second)
+        if (exp == inst.index)
         {
             auto rvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             auto jump = std::move(stack_.top()); stack_.pop();
@@ -1205,9 +1217,9 @@ auto decompiler::decompile_expressions(instruction const& inst) -> void
         }
     }
 
-    for (auto const& tern : tern_labels_)
+    for (auto const tern : tern_labels_)
     {
-        if (tern == itr->second)
+        if (tern == inst.index)
         {
             auto rvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             auto lvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
@@ -1248,7 +1260,7 @@ auto decompiler::decompile_infinites(stmt_list& stm) -> void
     {
         if (stm.list.at(i)->is<stmt_jmp>())
         {
-            if (stm.list.at(i)->loc().begin.line < std::stol(stm.list.at(i)->as<stmt_jmp>().value.substr(4), 0, 16))
+            if (stm.list.at(i)->label() < stm.list.at(i)->as<stmt_jmp>().value)
                 continue;
 
             if (stm.list.at(i)->as<stmt_jmp>().value == locs_.cnt)
@@ -1301,10 +1313,10 @@ auto decompiler::decompile_loops(stmt_list& stm) -> void
 
             if (stm.list.at(j)->is<stmt_jmp>())
             {
-                if (stm.list.at(j)->loc().begin.line < std::stol(stm.list.at(j)->as<stmt_jmp>().value.substr(4), 0, 16))
+                if (stm.list.at(j)->label() < stm.list.at(j)->as<stmt_jmp>().value)
                     continue;
 
-                if (stm.list.at(i)->loc().label() == stm.list.at(j)->as<stmt_jmp>().value)
+                if (stm.list.at(i)->label() == stm.list.at(j)->as<stmt_jmp>().value)
                 {
                     decompile_loop(stm, i, j);
                     i = 0;
@@ -1343,7 +1355,7 @@ auto decompiler::decompile_ifelses(stmt_list& stm) -> void
                 if (stm.list.at(j)->as<stmt_jmp>().value == locs_.cnt)
                 {
                     //if its a while, continue jumps back
-                    if (stm.list.at(j)->loc().begin.line > std::stol(stm.list.at(j)->as<stmt_jmp>().value.substr(4), 0, 16))
+                    if (stm.list.at(j)->label() > stm.list.at(j)->as<stmt_jmp>().value)
                     {
                         decompile_if(stm, i, j);
                     }
@@ -1397,9 +1409,9 @@ auto decompiler::decompile_ifelses(stmt_list& stm) -> void
                 else
                 {
                     // fix treyarch compiler bug: breaks outside loops or switches
-                    auto out_of_scope = stm.list.at(stm.list.size() - 1)->loc().begin.line < std::stol(stm.list.at(j)->as<stmt_jmp>().value.substr(4), 0, 16);
+                    auto out_of_scope = stm.list.at(stm.list.size() - 1)->label() < stm.list.at(j)->as<stmt_jmp>().value;
 
-                    if (locs_.brk == "" && out_of_scope)
+                    if (locs_.brk == locjmp::none && out_of_scope)
                         decompile_if(stm, i, j);
                     else
                         decompile_ifelse(stm, i, j);
@@ -1437,7 +1449,7 @@ auto decompiler::decompile_aborts(stmt_list& stm) -> void
             else
             {
                 // fix treyarch compiler bug: breaks outside loops or switches
-                if (locs_.brk == "")
+                if (locs_.brk == locjmp::none)
                 {
                     stm.list.erase(stm.list.begin() + i);
                     stm.list.insert(stm.list.begin() + i, stmt_break::make(loc));
@@ -1456,7 +1468,7 @@ auto decompiler::decompile_aborts(stmt_list& stm) -> void
                     continue;
                 }
 
-                std::cout << "WARNING: unresolved jump to '" + jmp + "', maybe incomplete for loop\n";
+                std::cout << std::format("WARNING: unresolved jump to 'loc_{:X}', maybe incomplete for loop\n", jmp);
             }
         }
     }
@@ -1845,24 +1857,24 @@ auto decompiler::decompile_foreach(stmt_list& stm, usize begin, usize end) -> vo
 auto decompiler::decompile_switch(stmt_list& stm, usize begin, usize end) -> void
 {
     auto const& data = stm.list[end]->as<stmt_jmp_endswitch>().data;
-    auto const count = std::stoul(data[0]);
+    auto const count = static_cast<usize>(data[0].as_int());
     auto index = 1u;
 
     for (auto i = 0u; i < count; i++)
     {
         if (data[index] == "case")
         {
-            auto type = static_cast<switch_type>(std::stoul(data[index + 1]));
-            auto pos = find_location_index(stm, data[index + 3]);
+            auto type = static_cast<switch_type>(data[index + 1].as_int());
+            auto pos = find_location_index(stm, data[index + 3].as_label());
             auto loc = stm.list[pos]->loc();
-            auto exp = (type == switch_type::integer) ? expr::ptr{ expr_integer::make(loc, data[index + 2]) } : expr::ptr{ expr_string::make(loc, data[index + 2]) };
+            auto exp = (type == switch_type::integer) ? expr::ptr{ expr_integer::make(loc, data[index + 2].to_string()) } : expr::ptr{ expr_string::make(loc, data[index + 2].to_string()) };
             while (stm.list[pos]->is<stmt_case>()) pos++;
             stm.list.insert(stm.list.begin() + pos, stmt_case::make(loc, std::move(exp), stmt_list::make(loc)));
             index += 4;
         }
         else if (data[index] == "default")
         {
-            auto pos = find_location_index(stm, data[index + 1]);
+            auto pos = find_location_index(stm, data[index + 1].as_label());
             auto loc = stm.list[pos]->loc();
             while (stm.list[pos]->is<stmt_case>()) pos++;
             stm.list.insert(stm.list.begin() + pos, stmt_default::make(loc, stmt_list::make(loc)));
@@ -1941,11 +1953,23 @@ auto decompiler::decompile_switch(stmt_list& stm, usize begin, usize end) -> voi
     stm.list.insert(stm.list.begin() + begin, stmt_switch::make(loc, std::move(test), stmt_comp::make(loc, std::move(body))));
 }
 
-auto decompiler::find_location_reference(stmt_list const& stm, usize begin, usize end, std::string const& loc) -> bool
+auto decompiler::find_location_reference(stmt_list const& stm, usize begin, usize end, usize loc) -> bool
 {
-    for (auto i = begin; i < end; i++)
+    auto const itr = jumps_.find(loc);
+
+    if (itr == jumps_.end())
+        return false;
+
+    for (auto const source : itr->second)
     {
-        auto const& entry = stm.list.at(i);
+        // statements are ordered by offset, the one holding the jump is the last starting before it
+        auto const pos = std::ranges::upper_bound(stm.list, source, {}, [](auto const& entry) { return entry->label(); });
+        auto const index = static_cast<usize>(pos - stm.list.begin());
+
+        if (index <= begin || index > end)
+            continue;
+
+        auto const& entry = stm.list[index - 1];
 
         if (entry->is<stmt_jmp_cond>() && entry->as<stmt_jmp_cond>().value == loc)
         {
@@ -1964,22 +1988,17 @@ auto decompiler::find_location_reference(stmt_list const& stm, usize begin, usiz
     return false;
 }
 
-auto decompiler::find_location_index(stmt_list const& stm, std::string const& loc) -> usize
+auto decompiler::find_location_index(stmt_list const& stm, usize loc) -> usize
 {
-    auto index = 0u;
-
     if (loc == locs_.end)
         return stm.list.size();
 
-    for (auto const& entry : stm.list)
-    {
-        if (entry->label() == loc)
-            return index;
+    auto const itr = std::ranges::lower_bound(stm.list, loc, {}, [](auto const& entry) { return entry->label(); });
 
-        index++;
-    }
+    if (itr != stm.list.end() && (*itr)->label() == loc)
+        return static_cast<usize>(itr - stm.list.begin());
 
-    throw decomp_error(std::format("location '{}' not found", loc));
+    throw decomp_error(std::format("location 'loc_{:X}' not found", loc));
 }
 
 auto decompiler::last_location_index(stmt_list const& stm, usize index) -> bool
@@ -2028,19 +2047,6 @@ auto decompiler::lvalues_match(stmt_expr const& stm1, stmt_expr const& stm2) ->
     return false;
 }
 
-auto decompiler::resolve_label(std::string const& name) const -> usize
-{
-    for (auto const& entry : labels_)
-    {
-        if (entry.second == name)
-        {
-            return entry.first;
-        }
-    }
-
-    throw decomp_error(std::format("couldn't resolve label address of '{}'", name));
-}
-
 auto decompiler::process_function(decl_function& func) -> void
 {
     process_stmt_comp(*func.body);
@@ -490,33 +490,33 @@ auto disassembler::disassemble_instruction(instruction& inst) -> void
             break;
         case opcode::OP_GetByte:
         case opcode::OP_GetNegByte:
-            inst.data.push_back(std::format("{}", script_.read<u8>()));
+            inst.data.push_back(operand::make_int(script_.read<u8>()));
             break;
         case opcode::OP_GetUnsignedShort:
         case opcode::OP_GetNegUnsignedShort:
             inst.size += script_.align(2);
-            inst.data.push_back(std::format("{}", script_.read<u16>()));
+            inst.data.push_back(operand::make_int(script_.read<u16>()));
             break;
         case opcode::OP_GetInteger:
             inst.size += script_.align(4);
             disassemble_animtree(inst);
-            inst.data.push_back(std::format("{}", script_.read<i32>()));
+            inst.data.push_back(operand::make_int(script_.read<i32>()));
             break;
         case opcode::OP_GetFloat:
             inst.size += script_.align(4);
-            inst.data.push_back(utils::string::float_string(script_.read<f32>()));
+            inst.data.push_back(operand::make_float(script_.read<f32>()));
             break;
         case opcode::OP_GetUintptr:
         //case opcode::OP_ProfileStart:
         case opcode::OP_GetAPIFunction:
             inst.size += script_.align(8);
-            inst.data.push_back(std::format("0x{:016X}", script_.read<u64>()));
+            inst.data.push_back(operand::make_hash(script_.read<u64>(), 16));
             break;
         case opcode::OP_GetVector:
             inst.size += script_.align(4);
-            inst.data.push_back(utils::string::float_string(script_.read<f32>()));
-            inst.data.push_back(utils::string::float_string(script_.read<f32>()));
-            inst.data.push_back(utils::string::float_string(script_.read<f32>()));
+            inst.data.push_back(operand::make_float(script_.read<f32>()));
+            inst.data.push_back(operand::make_float(script_.read<f32>()));
+            inst.data.push_back(operand::make_float(script_.read<f32>()));
             break;
         case opcode::OP_GetString:
         case opcode::OP_GetIString:
@@ -526,10 +526,10 @@ auto disassembler::disassemble_instruction(instruction& inst) -> void
             disassemble_animation(inst);
             break;
         case opcode::OP_WaitTillMatch:
-            inst.data.push_back(std::format("{}", script_.read<u8>()));
+            inst.data.push_back(operand::make_int(script_.read<u8>()));
             break;
         case opcode::OP_VectorConstant:
-            inst.data.push_back(std::format("{}", script_.read<u8>()));
+            inst.data.push_back(operand::make_int(script_.read<u8>()));
             break;
         case opcode::OP_GetHash:
             inst.size += script_.align(4);
@@ -549,7 +549,7 @@ auto disassembler::disassemble_instruction(instruction& inst) -> void
         case opcode::OP_EvalLocalArrayRefCached:
         case opcode::OP_SafeSetWaittillVariableFieldCached:
         case opcode::OP_EvalLocalVariableRefCached:
-            inst.data.push_back(std::format("{}", script_.read<u8>()));
+            inst.data.push_back(operand::make_int(script_.read<u8>()));
             break;
         case opcode::OP_EvalFieldVariable:
         case opcode::OP_EvalFieldVariableRef:
@@ -567,7 +567,7 @@ auto disassembler::disassemble_instruction(instruction& inst) -> void
         case opcode::OP_ScriptMethodCallPointer:
         case opcode::OP_ScriptThreadCallPointer:
         case opcode::OP_ScriptMethodThreadCallPointer:
-            inst.data.push_back(std::format("{}", script_.read<u8>()));
+            inst.data.push_back(operand::make_int(script_.read<u8>()));
             break;
         case opcode::OP_GetFunction:
             disassemble_import(inst);
@@ -629,7 +629,7 @@ auto disassembler::disassemble_params(instruction& inst) -> void
         {
             inst.size += script_.align(4) + 5;
             inst.data.push_back(ctx_->hash_name(script_.read<u32>()));
-            inst.data.push_back(std::format("{}", script_.read<u8>()));
+            inst.data.push_back(operand::make_int(script_.read<u8>()));
         }
         else
         {
@@ -704,7 +704,7 @@ auto disassembler::disassemble_jump(instruction& inst) -> void
     auto addr = ((ctx_->props() & props::size64) ? ((script_.read<i16>() + 1) & ~1) : script_.read<i16>()) + script_.pos();
     auto label = std::format("loc_{:X}", addr);
 
-    inst.data.emplace_back(label);
+    inst.data.push_back(operand::make_label(label));
     func_->labels.insert({ addr, label });
 }
 
@@ -715,7 +715,7 @@ auto disassembler::disassemble_switch(instruction& inst) -> void
     auto addr = script_.read<i32>() + script_.pos();
     auto label = std::format("loc_{:X}", addr);
 
-    inst.data.emplace_back(label);
+    inst.data.push_back(operand::make_label(label));
     func_->labels.insert({ addr, label });
 }
 
@@ -730,11 +730,11 @@ auto disassembler::disassemble_end_switch(instruction& inst) -> void
             if (entry->opcode != opcode::OP_Switch || entry->data[0] != itr->second)
                 continue;
 
-            entry->data[0] = std::format("loc_{:X}", inst.index);
+            entry->data[0] = operand::make_label(std::format("loc_{:X}", inst.index));
 
             if (func_->labels.erase(script_.pos()); !func_->labels.contains(inst.index))
             {
-                func_->labels.try_emplace(inst.index, std::string{ entry->data[0] });
+                func_->labels.try_emplace(inst.index, entry->data[0].text);
             }
 
             break;
@@ -742,7 +742,7 @@ auto disassembler::disassemble_end_switch(instruction& inst) -> void
     }
 
     auto count = script_.read<u32>();
-    inst.data.push_back(std::format("{}", count));
+    inst.data.push_back(operand::make_int(count));
 
     for (auto i = 0u; i < count; i++)
     {
@@ -753,14 +753,14 @@ auto disassembler::disassemble_end_switch(instruction& inst) -> void
             if (auto const str = string_refs_.find(script_.pos() - 4); str != string_refs_.end())
             {
                 inst.data.push_back("case");
-                inst.data.push_back(std::format("{}", static_cast<i32>(switch_type::string)));
+                inst.data.push_back(operand::make_int(static_cast<i32>(switch_type::string)));
                 inst.data.push_back(str->second->name);
             }
             else if (value != 0 || i != count - 1)
             {
                 inst.data.push_back("case");
-                inst.data.push_back(std::format("{}", static_cast<i32>(switch_type::integer)));
-                inst.data.push_back(std::format("{}", value));
+                inst.data.push_back(operand::make_int(static_cast<i32>(switch_type::integer)));
+                inst.data.push_back(operand::make_int(value));
             }
             else
             {
@@ -776,14 +776,14 @@ auto disassembler::disassemble_end_switch(instruction& inst) -> void
             else if (value < 0x40000)
             {
                 inst.data.push_back("case");
-                inst.data.push_back(std::format("{}", static_cast<i32>(switch_type::string)));
+                inst.data.push_back(operand::make_int(static_cast<i32>(switch_type::string)));
                 inst.data.push_back(string_refs_.at(script_.pos() - 2)->name);
             }
             else
             {
                 inst.data.push_back("case");
-                inst.data.push_back(std::format("{}", static_cast<i32>(switch_type::integer)));
-                inst.data.push_back(std::format("{}", (value - 0x800000) & 0xFFFFFF));
+                inst.data.push_back(operand::make_int(static_cast<i32>(switch_type::integer)));
+                inst.data.push_back(operand::make_int((value - 0x800000) & 0xFFFFFF));
             }
         }
 
@@ -791,7 +791,7 @@ auto disassembler::disassemble_end_switch(instruction& inst) -> void
         auto label = std::format("loc_{:X}", addr);
 
         inst.size += 8;
-        inst.data.emplace_back(label);
+        inst.data.push_back(operand::make_label(label));
         func_->labels.insert({ addr, label });
     }
 }
@@ -11,27 +11,37 @@ namespace xsk::arc::t6
 extern std::array<std::pair<u8, opcode>, code_count> const code_list;
 extern std::array<std::pair<u32, char const*>, hash_count> const hash_list;
 
+auto tables() -> arc::tables const&
+{
+    static auto const shared = []
+    {
+        auto data = arc::tables{};
+
+        data.hash_map.reserve(hash_list.size());
+
+        for (auto const& entry : code_list)
+        {
+            data.add_code(entry.first, entry.second);
+        }
+
+        for (auto const& entry : hash_list)
+        {
+            data.hash_map.insert({ entry.first, entry.second });
+        }
+
+        return data;
+    }();
+
+    return shared;
+}
+
 } // namespace xsk::arc::t6
 
 namespace xsk::arc::t6::pc
 {
 
-context::context(arc::instance inst) : arc::context(props::none, engine::t6, endian::little, system::pc, inst, header_magic)
+context::context(arc::instance inst) : arc::context(props::none, engine::t6, endian::little, system::pc, inst, header_magic, tables())
 {
-    code_map_.reserve(code_list.size());
-    code_map_rev_.reserve(code_list.size());
-    hash_map_.reserve(hash_list.size());
-
-    for (auto const& entry : code_list)
-    {
-        code_map_.insert({ entry.first, entry.second });
-        code_map_rev_.insert({ entry.second, entry.first });
-    }
-
-    for (auto const& entry : hash_list)
-    {
-        hash_map_.insert({ entry.first, entry.second });
-    }
 }
 
 } // namespace xsk::arc::t6::pc
@@ -11,22 +11,32 @@ namespace xsk::arc::t7
 extern std::array<std::pair<u16, opcode>, code_count> const code_list;
 extern std::array<std::pair<u32, char const*>, hash_count> const hash_list;
 
-context::context(arc::instance inst) : arc::context(props::header72 | props::size64 | props::hashids | props::devstr | props::spaces | props::refvarg | props::foreach, engine::t7, endian::little, system::pc, inst, header_magic)
+auto tables() -> arc::tables const&
 {
-    code_map_.reserve(code_list.size());
-    code_map_rev_.reserve(code_list.size());
-    hash_map_.reserve(hash_list.size());
-
-    for (auto const& entry : code_list)
+    static auto const shared = []
     {
-        code_map_.insert({ entry.first, entry.second });
-        code_map_rev_.insert({ entry.second, entry.first });
-    }
+        auto data = arc::tables{};
 
-    for (auto const& entry : hash_list)
-    {
-        hash_map_.insert({ entry.first, entry.second });
-    }
+        data.hash_map.reserve(hash_list.size());
+
+        for (auto const& entry : code_list)
+        {
+            data.add_code(entry.first, entry.second);
+        }
+
+        for (auto const& entry : hash_list)
+        {
+            data.hash_map.insert({ entry.first, entry.second });
+        }
+
+        return data;
+    }();
+
+    return shared;
+}
+
+context::context(arc::instance inst) : arc::context(props::header72 | props::size64 | props::hashids | props::devstr | props::spaces | props::refvarg | props::foreach, engine::t7, endian::little, system::pc, inst, header_magic, tables())
+{
 }
 
 } // namespace xsk::arc::t7
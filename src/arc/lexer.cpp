@@ -4,6 +4,7 @@
 // that can be found in the LICENSE file.
 
 #include "xsk/stdinc.hpp"
+#include "xsk/utils/scan.hpp"
 #include "xsk/utils/string.hpp"
 #include "xsk/arc/lexer.hpp"
 #include "xsk/arc/context.hpp"
@@ -54,6 +55,13 @@ auto lexer::lex() -> token
         {
             case ' ':
             case '\t':
+                while (curr == ' ' || curr == '\t')
+                {
+                    loc_.step();
+                    spacing_ = (last == ' ' || last == '\t') ? ((spacing_ == spacing::null) ? spacing::empty : spacing::back) : spacing::none;
+                    advance();
+                }
+                [[fallthrough]];
             case '\r':
                 loc_.step();
                 continue;
@@ -104,6 +112,7 @@ auto lexer::lex() -> token
 
                             advance();
                             first = false;
+                            skip_comment('#');
                         }
                     }
                 }
@@ -129,6 +138,7 @@ auto lexer::lex() -> token
 
                         advance();
                         first = false;
+                        skip_comment('@');
                     }
                 }
                 else if (last == '*')
@@ -153,12 +163,16 @@ auto lexer::lex() -> token
 
                         advance();
                         first = false;
+                        skip_comment('*');
                     }
                 }
                 else if (last == '/')
                 {
                     while (true)
                     {
+                        if (auto const count = utils::scan::span(reader_.buffer_pos, reader_.available, '\n', '\\'); count != 0)
+                            skip(count, count);
+
                         if (reader_.ended())
                             break;
 
@@ -342,6 +356,17 @@ auto lexer::lex() -> token
 lex_string:
         while (true)
         {
+            if (auto const count = utils::scan::span(reader_.buffer_pos, reader_.available, '"', '\n', '\\'); count != 0)
+            {
+                if (buflen_ + count > 0x1000)
+                    throw error("lexer: max literal size exceeded");
+
+                std::memcpy(&buffer_[buflen_], reader_.buffer_pos, count);
+                buflen_ += count;
+                skip(count, count);
+                continue;
+            }
+
             if (reader_.ended())
                 throw comp_error(loc_, "unmatched string start ('\"')");
 
@@ -589,6 +614,46 @@ auto lexer::advance() -> void
         linewrap();
 }
 
+// same as count advance() calls, the bytes skipped must not hold a '\\'
+auto lexer::skip(usize count, usize columns) -> void
+{
+    reader_.buffer_pos += count;
+    reader_.available -= count;
+    reader_.last_byte = reader_.buffer_pos[-1];
+    reader_.curr_byte = reader_.available ? *reader_.buffer_pos : 0;
+    loc_.end.column += static_cast<location::counter_type>(columns);
+
+    if (reader_.curr_byte == '\\') [[unlikely]]
+        linewrap();
+}
+
+// jumps to the next byte that may end the comment, counting the lines passed
+auto lexer::skip_comment(char end) -> void
+{
+    if (reader_.last_byte == end)
+        return;
+
+    auto const data = reader_.buffer_pos;
+    auto const count = utils::scan::span(data, reader_.available, end, '\\');
+
+    if (count == 0)
+        return;
+
+    auto const lines = utils::scan::count(data, count, '\n');
+
+    if (lines == 0)
+        return skip(count, count);
+
+    auto last = count - 1;
+
+    while (data[last] != '\n')
+        last--;
+
+    loc_.lines(static_cast<location::counter_type>(lines));
+    loc_.step();
+    skip(count, count - last);
+}
+
 auto lexer::linewrap() -> void
 {
     while (reader_.curr_byte == '\\')
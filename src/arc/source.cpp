@@ -118,15 +118,15 @@ auto source::dump_instruction(instruction const& inst) -> void
     {
         case opcode::OP_GetString:
         case opcode::OP_GetIString:
-            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[0]));
+            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[0].text));
             break;
         case opcode::OP_GetAnimation:
-            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[0]));
-            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[1]));
+            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[0].text));
+            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[1].text));
             break;
         case opcode::OP_EndSwitch:
         {
-            auto count = static_cast<u32>(std::stoul(inst.data[0]));
+            auto count = static_cast<u32>(inst.data[0].as_int());
             auto index = 1;
 
             std::format_to(std::back_inserter(buf_), " {}\n", count);
@@ -135,14 +135,14 @@ auto source::dump_instruction(instruction const& inst) -> void
             {
                 if (inst.data[index] == "case")
                 {
-                    auto type = static_cast<switch_type>(std::stoul(inst.data[index + 1]));
-                    auto data = (type == switch_type::integer) ? std::format("{}", inst.data[index + 2]) : utils::string::to_literal(inst.data[index + 2]);
-                    std::format_to(std::back_inserter(buf_), "\t\t\t{} {} {}", inst.data[index], data, inst.data[index + 3]);
+                    auto type = static_cast<switch_type>(inst.data[index + 1].as_int());
+                    auto data = (type == switch_type::integer) ? inst.data[index + 2].to_string() : utils::string::to_literal(inst.data[index + 2].text);
+                    std::format_to(std::back_inserter(buf_), "\t\t\t{} {} {}", inst.data[index].text, data, inst.data[index + 3].text);
                     index += 4;
                 }
                 else if (inst.data[index] == "default")
                 {
-                    std::format_to(std::back_inserter(buf_), "\t\t\t{} {}", inst.data[index], inst.data[index + 1]);
+                    std::format_to(std::back_inserter(buf_), "\t\t\t{} {}", inst.data[index].text, inst.data[index + 1].text);
                     index += 2;
                 }
 
@@ -156,7 +156,7 @@ auto source::dump_instruction(instruction const& inst) -> void
         default:
             for (auto const& entry : inst.data)
             {
-                std::format_to(std::back_inserter(buf_), " {}", entry);
+                std::format_to(std::back_inserter(buf_), " {}", entry.to_string());
             }
             break;
     }
@@ -825,32 +825,32 @@ auto source::dump_stmt_prof_end(stmt_prof_end const& stm) -> void
 
 auto source::dump_stmt_jmp(stmt_jmp const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_jmp( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_jmp( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_back(stmt_jmp_back const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_jmp_back( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_jmp_back( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_cond(stmt_jmp_cond const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_jmp_cond( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_jmp_cond( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_true(stmt_jmp_true const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_jmp_expr_true( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_jmp_expr_true( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_false(stmt_jmp_false const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_jmp_expr_false( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_jmp_expr_false( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_switch(stmt_jmp_switch const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_switch( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_switch( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_endswitch(stmt_jmp_endswitch const&) -> void
@@ -860,7 +860,7 @@ auto source::dump_stmt_jmp_endswitch(stmt_jmp_endswitch const&) -> void
 
 auto source::dump_stmt_jmp_dev(stmt_jmp_dev const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_jmp_dev( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_jmp_dev( loc_{:X} )", stm.value);
 }
 
 auto source::dump_expr(expr const& exp) -> void
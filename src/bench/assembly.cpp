@@ -0,0 +1,129 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/utils/file.hpp"
+#include "xsk/utils/string.hpp"
+#include "bench.hpp"
+
+namespace xsk::bench
+{
+
+namespace
+{
+
+// the line split & per line regex that source::parse_assembly used before the tokenizer
+auto legacy_lines(u8 const* data, usize size) -> std::vector<std::string>
+{
+    auto lines = std::vector<std::string>{};
+    auto current = std::string{};
+
+    for (auto i = 0u; i < size; ++i)
+    {
+        auto c = data[i];
+        if (c == '\n')
+        {
+            lines.push_back(current);
+            current.clear();
+        }
+        else if (c != '\t' && c != '\r')
+            current += c;
+    }
+
+    if (!current.empty())
+        lines.push_back(current);
+
+    return lines;
+}
+
+auto legacy_code(std::string& line) -> std::vector<std::string>
+{
+    auto data = std::vector<std::string>{};
+    auto exp = std::regex{ R"(([_A-Za-z0-9\-]+|\"(?:\\.|[^\"])*?\"|\'(?:\\.|[^\'])*?\')(?:\s+|$))" };
+
+    for (auto i = std::sregex_iterator{ line.begin(), line.end(), exp }; i != std::sregex_iterator{}; ++i)
+    {
+        data.push_back(i->format("$1"));
+    }
+
+    return data;
+}
+
+auto legacy_tokenize(std::vector<u8> const& data) -> usize
+{
+    auto count = usize{ 0 };
+
+    for (auto& line : legacy_lines(data.data(), data.size()))
+    {
+        if (line == "" || line.starts_with("//") || line.starts_with("sub:") || line.starts_with("end:") || line.starts_with("loc_"))
+            continue;
+
+        count += legacy_code(line).size();
+    }
+
+    return count;
+}
+
+// same line walk as source::parse_assembly, without building the instructions
+auto tokenize(std::vector<u8> const& data) -> usize
+{
+    auto const text = std::string_view{ reinterpret_cast<char const*>(data.data()), data.size() };
+    auto opdata = std::vector<std::string_view>{};
+    auto count = usize{ 0 };
+
+    for (auto pos = usize{ 0 }; pos < text.size(); )
+    {
+        auto end = text.find('\n', pos);
+
+        if (end == std::string_view::npos)
+            end = text.size();
+
+        auto line = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        while (!line.empty() && (line.front() == '\t' || line.front() == ' '))
+            line.remove_prefix(1);
+
+        while (!line.empty() && (line.back() == '\r' || line.back() == '\t' || line.back() == ' '))
+            line.remove_suffix(1);
+
+        if (line.empty() || line.starts_with("//") || line.starts_with("sub:") || line.starts_with("end:") || line.starts_with("loc_"))
+            continue;
+
+        utils::string::parse_code(line, opdata);
+        count += opdata.size();
+    }
+
+    return count;
+}
+
+} // namespace
+
+// gscasm tokenizer against the regex path it replaced, then the whole parse_assembly
+auto run_assembly(args const& args) -> i32
+{
+    if (args.size() < 2)
+        throw std::runtime_error("expected <game> <file.gscasm>");
+
+    auto ctx = make_gsc(args[0]);
+    auto const data = utils::file::read(std::filesystem::path{ args[1] });
+    auto const repeat = repeat_count(args, 2);
+    auto legacy = usize{ 0 };
+    auto current = usize{ 0 };
+    auto functions = usize{ 0 };
+
+    auto const time_legacy = measure(repeat, [&]() { legacy = legacy_tokenize(data); });
+    auto const time_current = measure(repeat, [&]() { current = tokenize(data); });
+    auto const time_parse = measure(repeat, [&]() { functions = ctx->source().parse_assembly(data)->functions.size(); });
+
+    std::cout << std::format("{}: {} bytes, {} functions\n", args[1], data.size(), functions);
+    std::cout << std::format("regex tokenizer:  {:10.3f} ms {:10.2f} MB/s {} operands\n", time_legacy * 1000.0, throughput(data.size(), time_legacy), legacy);
+    std::cout << std::format("single pass:      {:10.3f} ms {:10.2f} MB/s {} operands\n", time_current * 1000.0, throughput(data.size(), time_current), current);
+    std::cout << std::format("parse_assembly:   {:10.3f} ms {:10.2f} MB/s\n", time_parse * 1000.0, throughput(data.size(), time_parse));
+
+    return 0;
+}
+
+} // namespace xsk::bench
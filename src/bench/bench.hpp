@@ -0,0 +1,28 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#pragma once
+
+#include "xsk/gsc/context.hpp"
+#include "xsk/arc/context.hpp"
+
+namespace xsk::bench
+{
+
+using args = std::vector<std::string_view>;
+
+auto measure(u32 repeat, std::function<void()> const& func) -> double;
+auto throughput(usize size, double time) -> double;
+auto repeat_count(args const& args, usize index) -> u32;
+auto make_gsc(std::string_view game) -> std::unique_ptr<gsc::context>;
+auto make_arc(std::string_view game) -> std::unique_ptr<arc::context>;
+
+auto run_assembly(args const& args) -> i32;
+auto run_switch(args const& args) -> i32;
+auto run_lexer(args const& args) -> i32;
+auto run_lexer_check(args const& args) -> i32;
+auto run_decompiler(args const& args) -> i32;
+
+} // namespace xsk::bench
@@ -0,0 +1,52 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/utils/file.hpp"
+#include "bench.hpp"
+
+namespace xsk::bench
+{
+
+// disassemble & decompile time of a compiled script, the decompiler builds a flow graph with
+// dominator trees for every function to structure it
+auto run_decompiler(args const& args) -> i32
+{
+    if (args.size() < 2)
+        throw std::runtime_error("expected <game> <file.gsc>");
+
+    auto ctx = make_gsc(args[0]);
+    auto data = utils::file::read(std::filesystem::path{ args[1] });
+    auto const repeat = repeat_count(args, 2);
+    auto const outasm = ctx->compiler().compile(std::string{ args[1] }, data);
+    auto const [script, stack, devmap] = ctx->assembler().assemble(*outasm);
+
+    // the assembler owns its buffers, keep a copy for the runs
+    auto const script_data = std::vector<u8>{ script.data, script.data + script.size };
+    auto const stack_data = std::vector<u8>{ stack.data, stack.data + stack.size };
+    auto functions = usize{ 0 };
+    auto instructions = usize{ 0 };
+
+    auto const time_disasm = measure(repeat, [&]()
+    {
+        auto const disasm = ctx->disassembler().disassemble(script_data, stack_data);
+        functions = disasm->functions.size();
+        instructions = 0;
+
+        for (auto const& func : disasm->functions)
+            instructions += func->instructions.size();
+    });
+
+    auto const disasm = ctx->disassembler().disassemble(script_data, stack_data);
+    auto const time_decomp = measure(repeat, [&]() { ctx->decompiler().decompile(*disasm); });
+
+    std::cout << std::format("{}: {} bytes of bytecode, {} functions, {} instructions\n", args[1], script_data.size(), functions, instructions);
+    std::cout << std::format("disassemble: {:10.3f} ms\n", time_disasm * 1000.0);
+    std::cout << std::format("decompile:   {:10.3f} ms {:10.2f} MB/s of bytecode\n", time_decomp * 1000.0, throughput(script_data.size(), time_decomp));
+
+    return 0;
+}
+
+} // namespace xsk::bench
@@ -0,0 +1,332 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/utils/file.hpp"
+#include "xsk/gsc/lexer.hpp"
+#include "xsk/arc/lexer.hpp"
+#include "bench.hpp"
+
+#include <random>
+
+namespace xsk::bench
+{
+
+namespace
+{
+
+struct mark
+{
+    bool string;
+    i32 line;
+    i32 column;
+
+    auto operator==(mark const&) const -> bool = default;
+};
+
+// random script text, the names & strings between the skipped regions record where they start
+struct generator
+{
+    std::mt19937 rng;
+    std::string text;
+    std::vector<mark> marks;
+    usize names;
+    i32 line;
+    i32 column;
+
+    explicit generator(u32 seed) : rng{ seed }, names{ 0 }, line{ 1 }, column{ 1 }
+    {
+    }
+
+    auto pick(u32 count) -> u32
+    {
+        return std::uniform_int_distribution<u32>{ 0, count - 1 }(rng);
+    }
+
+    // the lexer counts one column per byte and a line per '\n', line wraps included
+    auto put(char c) -> void
+    {
+        text.push_back(c);
+
+        if (c == '\n')
+        {
+            line++;
+            column = 1;
+        }
+        else
+        {
+            column++;
+        }
+    }
+
+    auto put(std::string_view data) -> void
+    {
+        for (auto const c : data)
+            put(c);
+    }
+
+    // only a byte read before the wrap joins the lines, not the start of the file. linewrap
+    // reads one byte too far when a \r\n wrap is followed by a line break, so those are left out
+    auto wrap() -> void
+    {
+        if (text.empty())
+            put(' ');
+
+        put("\\\n");
+    }
+
+    auto space() -> void
+    {
+        static constexpr std::string_view blanks[] = { " ", "\t", "  ", " \t ", "\n", "\r\n", "\n\n" };
+        put(blanks[pick(std::size(blanks))]);
+    }
+
+    // body of a comment closed by end & '/', or of a line comment when end is 0
+    auto body(char end) -> void
+    {
+        static constexpr std::string_view chars = "abcXYZ019 \t\r*/#@\"'.;{}()&|<>";
+
+        for (auto count = pick(40); count > 0; count--)
+        {
+            auto c = chars[pick(chars.size())];
+
+            // the wrap would join the closing pair
+            if (pick(16) == 0 && (end == 0 || text.back() != end))
+            {
+                wrap();
+                continue;
+            }
+
+            if (end != 0 && pick(8) == 0)
+                c = '\n';
+
+            if (c == '\r' && end == 0)
+                continue;
+
+            if (c == '/' && end != 0 && !text.empty() && text.back() == end)
+                continue;
+
+            put(c);
+
+            // block comments step over their line breaks, the next byte is on column 2
+            if (c == '\n')
+                column++;
+        }
+    }
+
+    auto string() -> void
+    {
+        static constexpr std::string_view chars = "abcXYZ019 \t*/#@'.;{}";
+        static constexpr std::string_view escapes[] = { "\\n", "\\t", "\\r", "\\\"", "\\\\" };
+
+        marks.push_back({ true, line, column });
+        put('"');
+
+        for (auto count = pick(30); count > 0; count--)
+        {
+            auto const kind = pick(10);
+
+            if (kind == 0)
+                put(escapes[pick(std::size(escapes))]);
+            else if (kind == 1 && text.back() != '\\')
+            {
+                // a wrap starts the token location over
+                wrap();
+                marks.back() = { true, line, column };
+            }
+            else
+                put(chars[pick(chars.size())]);
+        }
+
+        put('"');
+    }
+
+    auto piece() -> void
+    {
+        switch (pick(9))
+        {
+            case 0:
+            case 1:
+            case 2:
+                marks.push_back({ false, line, column });
+                put(std::format("v{}", names++));
+                break;
+            case 3:
+                string();
+                break;
+            case 4:
+                put("//");
+                body(0);
+                put('\n');
+                break;
+            case 5:
+                put("/*");
+                body('*');
+                put("*/");
+                break;
+            case 6:
+                put("/@");
+                body('@');
+                put("@/");
+                break;
+            case 7:
+                put("/#");
+                body('#');
+                put("#/");
+                break;
+            default:
+                wrap();
+                break;
+        }
+
+        space();
+    }
+};
+
+template<typename Lexer, typename Token>
+auto collect(Lexer& lexer, std::vector<mark>& marks) -> usize
+{
+    auto count = usize{ 0 };
+
+    for (auto tok = lexer.lex(); tok.type != Token::EOS; tok = lexer.lex())
+    {
+        if (tok.type == Token::NAME || tok.type == Token::STRING)
+            marks.push_back({ tok.type == Token::STRING, tok.pos.begin.line, tok.pos.begin.column });
+
+        count++;
+    }
+
+    return count;
+}
+
+auto escape(std::string_view data) -> std::string
+{
+    auto res = std::string{};
+
+    for (auto const c : data)
+    {
+        if (c == '\n') res += "\\n";
+        else if (c == '\r') res += "\\r";
+        else if (c == '\t') res += "\\t";
+        else if (c == '\\') res += "\\\\";
+        else res += c;
+    }
+
+    return res;
+}
+
+} // namespace
+
+// tokens per second of the gsc or arc lexer over a whole file
+auto run_lexer(args const& args) -> i32
+{
+    if (args.size() < 2)
+        throw std::runtime_error("expected <game> <file>");
+
+    auto const data = utils::file::read(std::filesystem::path{ args[1] });
+    auto const name = std::string{ args[1] };
+    auto const repeat = repeat_count(args, 2);
+    auto tokens = usize{ 0 };
+    auto time = 0.0;
+
+    if (args[0] == "t6")
+    {
+        auto ctx = make_arc(args[0]);
+        auto marks = std::vector<mark>{};
+
+        time = measure(repeat, [&]()
+        {
+            auto lexer = arc::lexer{ ctx.get(), name, reinterpret_cast<char const*>(data.data()), data.size() };
+            marks.clear();
+            tokens = collect<arc::lexer, arc::token>(lexer, marks);
+        });
+    }
+    else
+    {
+        auto ctx = make_gsc(args[0]);
+        auto marks = std::vector<mark>{};
+
+        time = measure(repeat, [&]()
+        {
+            auto arena = utils::arena{};
+            auto lexer = gsc::lexer{ ctx.get(), arena, name, reinterpret_cast<char const*>(data.data()), data.size() };
+            marks.clear();
+            tokens = collect<gsc::lexer, gsc::token>(lexer, marks);
+        });
+    }
+
+    std::cout << std::format("{}: {} bytes, {} tokens, {:.3f} ms, {:.2f} MB/s\n", args[1], data.size(), tokens, time * 1000.0, throughput(data.size(), time));
+
+    return 0;
+}
+
+// random inputs full of comments, dev blocks, strings & line wraps: every name and string
+// must start where the generator put it, which guards the bulk skip column arithmetic
+auto run_lexer_check(args const& args) -> i32
+{
+    if (args.empty())
+        throw std::runtime_error("expected <game>");
+
+    auto const inputs = (args.size() > 1) ? std::stoul(std::string{ args[1] }) : 500000ul;
+    auto const seed = (args.size() > 2) ? static_cast<u32>(std::stoul(std::string{ args[2] })) : 1u;
+    auto const name = std::string{ "check.gsc" };
+    auto gsc_ctx = (args[0] == "t6") ? nullptr : make_gsc(args[0]);
+    auto arc_ctx = (args[0] == "t6") ? make_arc(args[0]) : nullptr;
+    auto bytes = usize{ 0 };
+
+    for (auto i = 0u; i < inputs; i++)
+    {
+        auto gen = generator{ seed + i };
+        auto marks = std::vector<mark>{};
+
+        for (auto count = gen.pick(24) + 1; count > 0; count--)
+            gen.piece();
+
+        auto const data = gen.text.data();
+        auto const size = gen.text.size();
+
+        try
+        {
+            if (arc_ctx)
+            {
+                auto lexer = arc::lexer{ arc_ctx.get(), name, data, size };
+                collect<arc::lexer, arc::token>(lexer, marks);
+            }
+            else
+            {
+                auto arena = utils::arena{};
+                auto lexer = gsc::lexer{ gsc_ctx.get(), arena, name, data, size };
+                collect<gsc::lexer, gsc::token>(lexer, marks);
+            }
+        }
+        catch (std::exception const& e)
+        {
+            std::cout << std::format("error on input {} (seed {}): \"{}\"\n{}\n", i, seed + i, escape(gen.text), e.what());
+            return 1;
+        }
+
+        bytes += size;
+
+        if (marks != gen.marks)
+        {
+            auto const [got, want] = std::ranges::mismatch(marks, gen.marks);
+
+            std::cout << std::format("mismatch on input {} (seed {}): \"{}\"\n", i, seed + i, escape(gen.text));
+
+            if (got != marks.end() && want != gen.marks.end())
+                std::cout << std::format("lexed {}:{}, expected {}:{}\n", got->line, got->column, want->line, want->column);
+            else
+                std::cout << std::format("lexed {} tokens, expected {}\n", marks.size(), gen.marks.size());
+
+            return 1;
+        }
+    }
+
+    std::cout << std::format("{} inputs, {} bytes: all token locations match\n", inputs, bytes);
+
+    return 0;
+}
+
+} // namespace xsk::bench
@@ -0,0 +1,141 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/utils/file.hpp"
+#include "xsk/gsc/engine/iw5_pc.hpp"
+#include "xsk/gsc/engine/iw6_pc.hpp"
+#include "xsk/gsc/engine/iw7.hpp"
+#include "xsk/gsc/engine/iw8.hpp"
+#include "xsk/gsc/engine/iw9.hpp"
+#include "xsk/gsc/engine/s1_pc.hpp"
+#include "xsk/gsc/engine/s2.hpp"
+#include "xsk/gsc/engine/s4.hpp"
+#include "xsk/gsc/engine/h1.hpp"
+#include "xsk/gsc/engine/h2.hpp"
+#include "xsk/arc/engine/t6_pc.hpp"
+#include "bench.hpp"
+
+namespace xsk::bench
+{
+
+struct command
+{
+    std::string_view usage;
+    std::function<i32(args const&)> func;
+};
+
+std::map<std::string_view, command> const commands =
+{
+    { "asm", { "asm <game> <file.gscasm> [repeat]", run_assembly } },
+    { "decomp", { "decomp <game> <file.gsc> [repeat]", run_decompiler } },
+    { "switch", { "switch <game> <cases> [repeat] [save.gsc]", run_switch } },
+    { "lex", { "lex <game> <file> [repeat]", run_lexer } },
+    { "lexcheck", { "lexcheck <game> [inputs] [seed]", run_lexer_check } },
+};
+
+// best of the runs, the first ones warm the caches
+auto measure(u32 repeat, std::function<void()> const& func) -> double
+{
+    auto best = std::numeric_limits<double>::max();
+
+    for (auto i = 0u; i < std::max(repeat, 1u); i++)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        func();
+        best = std::min(best, std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count());
+    }
+
+    return best;
+}
+
+auto throughput(usize size, double time) -> double
+{
+    return (time > 0.0) ? static_cast<double>(size) / (1024.0 * 1024.0) / time : 0.0;
+}
+
+auto repeat_count(args const& args, usize index) -> u32
+{
+    return (index < args.size()) ? static_cast<u32>(std::stoul(std::string{ args[index] })) : 5;
+}
+
+auto make_gsc(std::string_view game) -> std::unique_ptr<gsc::context>
+{
+    auto ctx = std::unique_ptr<gsc::context>{};
+
+    if (game == "iw5") ctx = std::make_unique<gsc::iw5_pc::context>(gsc::instance::server);
+    else if (game == "iw6") ctx = std::make_unique<gsc::iw6_pc::context>(gsc::instance::server);
+    else if (game == "iw7") ctx = std::make_unique<gsc::iw7::context>(gsc::instance::server);
+    else if (game == "iw8") ctx = std::make_unique<gsc::iw8::context>(gsc::instance::server);
+    else if (game == "iw9") ctx = std::make_unique<gsc::iw9::context>(gsc::instance::server);
+    else if (game == "s1") ctx = std::make_unique<gsc::s1_pc::context>(gsc::instance::server);
+    else if (game == "s2") ctx = std::make_unique<gsc::s2::context>(gsc::instance::server);
+    else if (game == "s4") ctx = std::make_unique<gsc::s4::context>(gsc::instance::server);
+    else if (game == "h1") ctx = std::make_unique<gsc::h1::context>(gsc::instance::server);
+    else if (game == "h2") ctx = std::make_unique<gsc::h2::context>(gsc::instance::server);
+    else throw std::runtime_error(std::format("unsupported gsc game '{}'", game));
+
+    ctx->init(gsc::build::prod, [](gsc::context const*, std::string const& name) -> std::pair<gsc::buffer, std::vector<u8>>
+    {
+        return { {}, utils::file::read(std::filesystem::path{ name }) };
+    });
+
+    return ctx;
+}
+
+auto make_arc(std::string_view game) -> std::unique_ptr<arc::context>
+{
+    if (game != "t6")
+        throw std::runtime_error(std::format("unsupported arc game '{}'", game));
+
+    auto ctx = std::make_unique<arc::t6::pc::context>(arc::instance::server);
+
+    ctx->init(arc::build::prod, [](std::string const& name)
+    {
+        return utils::file::read(std::filesystem::path{ name });
+    });
+
+    return ctx;
+}
+
+auto usage() -> i32
+{
+    std::cout << "usage: gsc-bench <command> [args...]\n";
+
+    for (auto const& [name, entry] : commands)
+    {
+        std::cout << std::format("  {}\n", entry.usage);
+    }
+
+    return 1;
+}
+
+auto main(u32 argc, char** argv) -> i32
+{
+    if (argc < 2)
+        return usage();
+
+    auto const itr = commands.find(argv[1]);
+
+    if (itr == commands.end())
+        return usage();
+
+    try
+    {
+        return itr->second.func(args{ argv + 2, argv + argc });
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << std::format("[ERROR] {}\n", e.what());
+        return 1;
+    }
+}
+
+} // namespace xsk::bench
+
+int main(int argc, char** argv)
+{
+    return static_cast<int>(xsk::bench::main(argc, argv));
+}
@@ -0,0 +1,67 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/utils/file.hpp"
+#include "bench.hpp"
+
+namespace xsk::bench
+{
+
+namespace
+{
+
+// one switch with the given cases, then an if/else chain half as long
+auto make_script(usize cases) -> std::string
+{
+    auto data = std::string{ "main(value)\n{\n    result = 0;\n\n    switch (value)\n    {\n" };
+
+    for (auto i = 0u; i < cases; i++)
+    {
+        data += std::format("        case {}:\n            result = {};\n            break;\n", i, i * 3);
+    }
+
+    data += "        default:\n            result = -1;\n            break;\n    }\n\n";
+
+    for (auto i = 0u; i < cases / 2; i++)
+    {
+        data += std::format("    {}if (result == {})\n        result = {};\n", i ? "else " : "", i, i + 1);
+    }
+
+    data += "\n    return result;\n}\n";
+    return data;
+}
+
+} // namespace
+
+// compile time of long switch & if/else chains, the label handling grew quadratic with them
+auto run_switch(args const& args) -> i32
+{
+    if (args.size() < 2)
+        throw std::runtime_error("expected <game> <cases>");
+
+    auto ctx = make_gsc(args[0]);
+    auto const cases = static_cast<usize>(std::stoul(std::string{ args[1] }));
+    auto const repeat = repeat_count(args, 2);
+    auto const script = make_script(cases);
+    auto size = usize{ 0 };
+
+    // the saved script compiles with any gsc-tool build, to compare against older ones
+    if (args.size() > 3)
+        utils::file::save(std::filesystem::path{ args[3] }, reinterpret_cast<u8 const*>(script.data()), script.size());
+
+    auto const time = measure(repeat, [&]()
+    {
+        auto data = std::vector<u8>{ script.begin(), script.end() };
+        auto outasm = ctx->compiler().compile("switch.gsc", data);
+        size = std::get<0>(ctx->assembler().assemble(*outasm)).size;
+    });
+
+    std::cout << std::format("{} cases, {} bytes of source: compile & assemble {:.3f} ms, {} bytes of bytecode\n", cases, script.size(), time * 1000.0, size);
+
+    return 0;
+}
+
+} // namespace xsk::bench
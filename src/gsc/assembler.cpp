@@ -21,6 +21,13 @@ auto assembler::assemble(assembly const& data) -> std::tuple<buffer, buffer, buf
     stack_.clear();
     devmap_.clear();
     devmap_count_ = 0;
+    functions_.clear();
+
+    // index symbols once, calls & jumps are resolved per instruction
+    for (auto const& func : data.functions)
+    {
+        functions_.try_emplace(func->name, func->index);
+    }
 
     devmap_.pos(sizeof(u32));
     script_.write<u8>(ctx_->opcode_id(opcode::OP_End));
@@ -41,6 +48,12 @@ auto assembler::assemble(assembly const& data) -> std::tuple<buffer, buffer, buf
 auto assembler::assemble_function(function const& func) -> void
 {
     func_ = &func;
+    labels_.clear();
+
+    for (auto const& [addr, name] : func.labels)
+    {
+        labels_.try_emplace(name, addr);
+    }
 
     stack_.write<u32>(static_cast<u32>(func.size));
 
@@ -157,30 +170,30 @@ auto assembler::assemble_instruction(instruction const& inst) -> void
             break;
         case opcode::OP_GetByte:
         case opcode::OP_GetNegByte:
-            script_.write<u8>(static_cast<u8>(std::stoul(inst.data[0])));
+            script_.write<u8>(static_cast<u8>(inst.data[0].as_int()));
             break;
         case opcode::OP_GetUnsignedShort:
         case opcode::OP_GetNegUnsignedShort:
-            script_.write<u16>(static_cast<u16>(std::stoul(inst.data[0])));
+            script_.write<u16>(static_cast<u16>(inst.data[0].as_int()));
             break;
         case opcode::OP_GetUnsignedInt:
         case opcode::OP_GetNegUnsignedInt:
-            script_.write<u32>(static_cast<u32>(std::stoul(inst.data[0])));
+            script_.write<u32>(static_cast<u32>(inst.data[0].as_int()));
             break;
         case opcode::OP_GetInteger:
-            script_.write<i32>(std::stoi(inst.data[0]));
+            script_.write<i32>(static_cast<i32>(inst.data[0].as_int()));
             break;
         case opcode::OP_GetInteger64:
-            script_.write<i64>(std::stoll(inst.data[0]));
+            script_.write<i64>(inst.data[0].as_int());
             break;
         case opcode::OP_GetFloat:
-            script_.write<f32>(std::stof(inst.data[0]));
+            script_.write<f32>(inst.data[0].as_float());
             break;
         case opcode::OP_GetVector:
             script_.align((ctx_->endian() == endian::little) ? 1 : 4);
-            script_.write<f32>(std::stof(inst.data[0]));
-            script_.write<f32>(std::stof(inst.data[1]));
-            script_.write<f32>(std::stof(inst.data[2]));
+            script_.write<f32>(inst.data[0].as_float());
+            script_.write<f32>(inst.data[1].as_float());
+            script_.write<f32>(inst.data[2].as_float());
             break;
         case opcode::OP_GetString:
         case opcode::OP_GetIString:
@@ -188,30 +201,30 @@ auto assembler::assemble_instruction(instruction const& inst) -> void
                 script_.write<u32>(0);
             else
                 script_.write<u16>(0);
-            stack_.write_cstr(encrypt_string(inst.data[0]));
+            stack_.write_cstr(encrypt_string(inst.data[0].text));
             break;
         case opcode::OP_GetAnimation:
             if (ctx_->props() & props::str4)
                 script_.write<u64>(0);
             else
                 script_.write<u32>(0);
-            stack_.write_cstr(encrypt_string(inst.data[0]));
-            stack_.write_cstr(encrypt_string(inst.data[1]));
+            stack_.write_cstr(encrypt_string(inst.data[0].text));
+            stack_.write_cstr(encrypt_string(inst.data[1].text));
             break;
         case opcode::OP_GetAnimTree:
             script_.write<u8>(0);
-            stack_.write_cstr(encrypt_string(inst.data[0]));
+            stack_.write_cstr(encrypt_string(inst.data[0].text));
             break;
         case opcode::OP_GetUnkxHash:
-            script_.write<u32>(std::stoul(inst.data[0], nullptr, 16));
+            script_.write<u32>(static_cast<u32>(inst.data[0].as_hash()));
             break;
         case opcode::OP_GetStatHash:
         case opcode::OP_GetEnumHash:
         case opcode::OP_GetDvarHash:
-            script_.write<u64>(std::stoull(inst.data[0], nullptr, 16));
+            script_.write<u64>(inst.data[0].as_hash());
             break;
         case opcode::OP_waittillmatch:
-            script_.write<u8>(static_cast<u8>(std::stoul(inst.data[0])));
+            script_.write<u8>(static_cast<u8>(inst.data[0].as_int()));
             break;
         case opcode::OP_ClearLocalVariableFieldCached:
         case opcode::OP_SetLocalVariableFieldCached:
@@ -223,16 +236,16 @@ auto assembler::assemble_instruction(instruction const& inst) -> void
         case opcode::OP_SafeSetWaittillVariableFieldCached:
         case opcode::OP_EvalLocalVariableObjectCached:
         case opcode::OP_EvalLocalArrayCached:
-            script_.write<u8>(static_cast<u8>(std::stoul(inst.data[0])));
+            script_.write<u8>(static_cast<u8>(inst.data[0].as_int()));
             break;
         case opcode::OP_CreateLocalVariable:
         case opcode::OP_EvalNewLocalArrayRefCached0:
         case opcode::OP_SafeCreateVariableFieldCached:
         case opcode::OP_SetNewLocalVariableFieldCached0:
             if (ctx_->props() & props::hash)
-                script_.write<u64>(ctx_->hash_id(inst.data[0]));
+                script_.write<u64>(ctx_->hash_id(inst.data[0].text));
             else
-                script_.write<u8>(static_cast<u8>(std::stoul(inst.data[0])));
+                script_.write<u8>(static_cast<u8>(inst.data[0].as_int()));
             break;
         case opcode::OP_EvalSelfFieldVariable:
         case opcode::OP_SetLevelFieldVariableField:
@@ -254,7 +267,7 @@ auto assembler::assemble_instruction(instruction const& inst) -> void
         case opcode::OP_ScriptChildThreadCallPointer:
         case opcode::OP_ScriptMethodThreadCallPointer:
         case opcode::OP_ScriptMethodChildThreadCallPointer:
-            script_.write<u8>(static_cast<u8>(std::stoul(inst.data[0])));
+            script_.write<u8>(static_cast<u8>(inst.data[0].as_int()));
             break;
         case opcode::OP_GetLocalFunction:
         case opcode::OP_ScriptLocalFunctionCall2:
@@ -334,10 +347,10 @@ auto assembler::assemble_field(instruction const& inst) -> void
 {
     if (ctx_->props() & props::hash)
     {
-        return script_.write<u64>(ctx_->hash_id(inst.data[0]));
+        return script_.write<u64>(ctx_->hash_id(inst.data[0].text));
     }
 
-    auto id = ctx_->token_id(inst.data[0]);
+    auto id = ctx_->token_id(inst.data[0].text);
 
     if (id == 0) id = 0xFFFFFFFF;
 
@@ -353,22 +366,22 @@ auto assembler::assemble_field(instruction const& inst) -> void
         else
             stack_.write<u16>(0);
 
-        stack_.write_cstr(encrypt_string(inst.data[0]));
+        stack_.write_cstr(encrypt_string(inst.data[0].text));
     }
 }
 
 auto assembler::assemble_params(instruction const& inst) -> void
 {
-    auto count = std::stoul(inst.data[0]);
+    auto count = static_cast<usize>(inst.data[0].as_int());
 
     script_.write<u8>(static_cast<u8>(count));
 
     for (auto i = 1u; i <= count; i++)
     {
         if (ctx_->props() & props::hash)
-            script_.write<u64>(ctx_->hash_id(inst.data[i]));
+            script_.write<u64>(ctx_->hash_id(inst.data[i].text));
         else
-            script_.write<u8>(static_cast<u8>(std::stoi(inst.data[i])));
+            script_.write<u8>(static_cast<u8>(inst.data[i].as_int()));
     }
 }
 
@@ -379,8 +392,8 @@ auto assembler::assemble_call_far(instruction const& inst, bool thread) -> void
         return assemble_call_far2(inst, thread);
     }
 
-    auto file_id = ctx_->token_id(inst.data[0]);
-    auto func_id = ctx_->token_id(inst.data[1]);
+    auto file_id = ctx_->token_id(inst.data[0].text);
+    auto func_id = ctx_->token_id(inst.data[1].text);
 
     if (ctx_->props() & props::tok4)
         stack_.write<u32>(file_id);
@@ -390,9 +403,9 @@ auto assembler::assemble_call_far(instruction const& inst, bool thread) -> void
     if (file_id == 0)
     {
         if (ctx_->props() & props::extension)
-            stack_.write_cstr(encrypt_string(inst.data[0] + (ctx_->instance() == instance::server ? ".gsc" : ".csc")));
+            stack_.write_cstr(encrypt_string(inst.data[0].text + (ctx_->instance() == instance::server ? ".gsc" : ".csc")));
         else
-            stack_.write_cstr(encrypt_string(inst.data[0]));
+            stack_.write_cstr(encrypt_string(inst.data[0].text));
     }
 
     if (ctx_->props() & props::tok4)
@@ -401,50 +414,50 @@ auto assembler::assemble_call_far(instruction const& inst, bool thread) -> void
         stack_.write<u16>(static_cast<u16>(func_id));
 
     if (func_id == 0)
-        stack_.write_cstr(encrypt_string(inst.data[1]));
+        stack_.write_cstr(encrypt_string(inst.data[1].text));
 
     script_.write<u8>(0);
     script_.write<u16>(0);
 
     if (thread)
     {
-        script_.write<u8>(static_cast<u8>(std::stoi(inst.data[2])));
+        script_.write<u8>(static_cast<u8>(inst.data[2].as_int()));
     }
 }
 
 auto assembler::assemble_call_far2(instruction const& inst, bool thread) -> void
 {
-    if (inst.data[0].empty())
+    if (inst.data[0].text.empty())
     {
-        script_.write<i32>(static_cast<i32>(resolve_function(inst.data[1]) - inst.index - 1));
+        script_.write<i32>(static_cast<i32>(resolve_function(inst.data[1].text) - inst.index - 1));
         stack_.write<u64>(0);
         stack_.write<u64>(0);
     }
     else
     {
-        auto path = inst.data[0];
+        auto path = inst.data[0].text;
 
         if (!path.starts_with("_id_"))
             path.append(ctx_->instance() == instance::server ? ".gsc" : ".csc");
 
         script_.write<u32>(0);
         stack_.write<u64>(ctx_->path_id(path));
-        stack_.write<u64>(ctx_->hash_id(inst.data[1]));
+        stack_.write<u64>(ctx_->hash_id(inst.data[1].text));
     }
 
     if (thread)
     {
-        script_.write<u8>(static_cast<u8>(std::stoi(inst.data[2])));
+        script_.write<u8>(static_cast<u8>(inst.data[2].as_int()));
     }
 }
 
 auto assembler::assemble_call_local(instruction const& inst, bool thread) -> void
 {
-    assemble_offset(static_cast<i32>(resolve_function(inst.data[0]) - inst.index - 1));
+    assemble_offset(static_cast<i32>(resolve_function(inst.data[0].text) - inst.index - 1));
 
     if (thread)
     {
-        script_.write<u8>(static_cast<u8>(std::stoi(inst.data[1])));
+        script_.write<u8>(static_cast<u8>(inst.data[1].as_int()));
     }
 }
 
@@ -452,17 +465,17 @@ auto assembler::assemble_call_builtin(instruction const& inst, bool method, bool
 {
     if (args)
     {
-        script_.write<u8>(static_cast<u8>(std::stoi(inst.data[1])));
+        script_.write<u8>(static_cast<u8>(inst.data[1].as_int()));
     }
 
     if (ctx_->props() & props::hash)
     {
-        stack_.write_cstr(std::format("#xS{:x}", ctx_->hash_id(inst.data[0])));
+        stack_.write_cstr(std::format("#xS{:x}", ctx_->hash_id(inst.data[0].text)));
         script_.write<u16>(0);
     }
     else
     {
-        script_.write<u16>(method ? ctx_->meth_id(inst.data[0]) : ctx_->func_id(inst.data[0]));
+        script_.write<u16>(method ? ctx_->meth_id(inst.data[0].text) : ctx_->func_id(inst.data[0].text));
     }
 }
 
@@ -489,7 +502,7 @@ auto assembler::assemble_switch(instruction const& inst) -> void
 
 auto assembler::assemble_switch_table(instruction const& inst) -> void
 {
-    auto count = std::stoul(inst.data[0]);
+    auto count = static_cast<usize>(inst.data[0].as_int());
     auto index = inst.index + 3u;
 
     script_.write<u16>(static_cast<u16>(count));
@@ -498,20 +511,20 @@ auto assembler::assemble_switch_table(instruction const& inst) -> void
     {
         if (inst.data[1 + (4 * i)] == "case")
         {
-            auto type = static_cast<switch_type>(std::stoul(inst.data[1 + (4 * i) + 1]));
+            auto type = static_cast<switch_type>(inst.data[1 + (4 * i) + 1].as_int());
 
             if (type == switch_type::integer)
             {
                 if (ctx_->engine() == engine::iw9)
-                    script_.write<u32>(std::stoi(inst.data[1 + (4 * i) + 2])); //signed?
+                    script_.write<u32>(static_cast<u32>(inst.data[1 + (4 * i) + 2].as_int())); //signed?
                 else
-                    script_.write<u32>((std::stoi(inst.data[1 + (4 * i) + 2]) & 0xFFFFFF) + 0x800000);
+                    script_.write<u32>(static_cast<u32>((inst.data[1 + (4 * i) + 2].as_int() & 0xFFFFFF) + 0x800000));
             }
             else
             {
                 // TODO: Sledgehammer's shenanigans (string id == 0)
                 script_.write<u32>((ctx_->engine() == engine::iw9) ? 0 : i + 1);
-                stack_.write_cstr(encrypt_string(inst.data[1 + (4 * i) + 2]));
+                stack_.write_cstr(encrypt_string(inst.data[1 + (4 * i) + 2].text));
             }
 
             auto addr = resolve_label(inst.data[1 + (4 * i) + 3]);
@@ -563,28 +576,28 @@ auto assembler::assemble_offset(i32 offs) -> void
 
 auto assembler::resolve_function(std::string const& name) const -> usize
 {
-    for (auto const& entry : assembly_->functions)
+    if (auto const itr = functions_.find(name); itr != functions_.end())
     {
-        if (entry->name == name)
-        {
-            return entry->index;
-        }
+        return itr->second;
     }
 
     throw asm_error(std::format("couldn't resolve local function address of {}", name));
 }
 
-auto assembler::resolve_label(std::string const& name) const -> usize
+auto assembler::resolve_label(operand const& label) const -> usize
 {
-    for (auto const& entry : func_->labels)
+    // compiled labels arrive already resolved to their address
+    if (label.type == operand::kind::label && label.text.empty())
     {
-        if (entry.second == name)
-        {
-            return entry.first;
-        }
+        return static_cast<usize>(label.integer);
+    }
+
+    if (auto const itr = labels_.find(label.text); itr != labels_.end())
+    {
+        return itr->second;
     }
 
-    throw asm_error(std::format("couldn't resolve label address of {}", name));
+    throw asm_error(std::format("couldn't resolve label address of {}", label.text));
 }
 
 auto assembler::encrypt_string(std::string const& str) -> std::string
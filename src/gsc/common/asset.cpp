@@ -44,31 +44,60 @@ auto asset::serialize() -> std::vector<u8>
 
 auto asset::deserialize(std::vector<std::uint8_t> const& data) -> void
 {
+    auto view = asset_view{};
+    view.deserialize(data.data(), data.size());
+
+    name = std::string{ view.name };
+    compressedLen = view.compressedLen;
+    len = view.len;
+    bytecodeLen = view.bytecodeLen;
+    buffer.assign(view.buffer, view.buffer + view.compressedLen);
+    bytecode.assign(view.bytecode, view.bytecode + view.bytecodeLen);
+}
+
+auto asset_view::serialize(std::ostream& stream) const -> void
+{
+    stream.write(name.data(), name.size());
+    stream.put('\0');
+    stream.write(reinterpret_cast<char const*>(&compressedLen), 4);
+    stream.write(reinterpret_cast<char const*>(&len), 4);
+    stream.write(reinterpret_cast<char const*>(&bytecodeLen), 4);
+    stream.write(reinterpret_cast<char const*>(buffer), compressedLen ? compressedLen : len);
+    stream.write(reinterpret_cast<char const*>(bytecode), bytecodeLen);
+}
+
+auto asset_view::deserialize(u8 const* data, usize size) -> void
+{
+    auto const end = std::find(data, data + size, u8{ 0 });
+
+    if (end == data + size || static_cast<usize>(end - data) + 13 > size)
+    {
+        throw std::runtime_error("script file deserialize error");
+    }
+
     auto pos = usize{ 0 };
 
-    name = std::string{ reinterpret_cast<char const*>(data.data()) };
+    name = std::string_view{ reinterpret_cast<char const*>(data), static_cast<usize>(end - data) };
     pos += name.size() + 1;
 
-    compressedLen = *reinterpret_cast<u32 const*>(data.data() + pos);
+    compressedLen = *reinterpret_cast<u32 const*>(data + pos);
     pos += 4;
 
-    len = *reinterpret_cast<u32 const*>(data.data() + pos);
+    len = *reinterpret_cast<u32 const*>(data + pos);
     pos += 4;
 
-    bytecodeLen = *reinterpret_cast<u32 const*>(data.data() + pos);
+    bytecodeLen = *reinterpret_cast<u32 const*>(data + pos);
     pos += 4;
 
-    if ((compressedLen + bytecodeLen + name.size() + 13) != data.size())
+    if ((usize{ compressedLen } + bytecodeLen + name.size() + 13) != size)
     {
         throw std::runtime_error("script file deserialize error");
     }
 
-    buffer.resize(compressedLen);
-    std::memcpy(buffer.data(), data.data() + pos, compressedLen);
-    pos += buffer.size();
+    buffer = data + pos;
+    pos += compressedLen;
 
-    bytecode.resize(bytecodeLen);
-    std::memcpy(bytecode.data(), data.data() + pos, bytecodeLen);
+    bytecode = data + pos;
 }
 
 } // namespace xsk::gsc
@@ -5,11 +5,42 @@
 
 #include "xsk/stdinc.hpp"
 #include "xsk/gsc/common/location.hpp"
+#include "xsk/gsc/common/assembly.hpp"
 #include "xsk/gsc/common/ast.hpp"
 
 namespace xsk::gsc
 {
 
+namespace
+{
+
+thread_local utils::arena* node_pool = nullptr;
+
+} // namespace
+
+auto node_deleter::operator()(node* ptr) const -> void
+{
+    if (ptr->pooled_)
+        ptr->~node();
+    else
+        delete ptr;
+}
+
+node_arena::node_arena(utils::arena& nodes) : prev_{ node_pool }
+{
+    node_pool = &nodes;
+}
+
+node_arena::~node_arena()
+{
+    node_pool = prev_;
+}
+
+auto node::allocate(usize size, usize align) -> void*
+{
+    return node_pool ? node_pool->allocate(size, align) : nullptr;
+}
+
 auto node::is_special_stmt() -> bool
 {
     switch (kind_)
@@ -117,21 +148,21 @@ auto expr_binary::precedence() -> u8
 }
 
 template<typename T>
-auto node::as(node::ptr) -> std::unique_ptr<T>
+auto node::as(node::ptr) -> typename T::ptr
 {
     static_assert(std::is_same_v<T, node>, "invalid cast");
 }
 
 template<>
-auto node::as(node::ptr from) -> std::unique_ptr<expr>
+auto node::as<expr>(node::ptr from) -> expr::ptr
 {
-    return std::unique_ptr<expr>(static_cast<expr*>(from.release()));
+    return expr::ptr(static_cast<expr*>(from.release()));
 }
 
 template<>
-auto node::as(node::ptr from) -> std::unique_ptr<stmt>
+auto node::as<stmt>(node::ptr from) -> stmt::ptr
 {
-    return std::unique_ptr<stmt>(static_cast<stmt*>(from.release()));
+    return stmt::ptr(static_cast<stmt*>(from.release()));
 }
 
 expr::expr(type t) : node{ t } {}
@@ -718,31 +749,31 @@ stmt_clear::stmt_clear(location const& loc, std::string const& index) : stmt{ ty
 {
 }
 
-stmt_jmp::stmt_jmp(location const& loc, std::string const& value) : stmt{ type::stmt_jmp, loc }, value{ value }
+stmt_jmp::stmt_jmp(location const& loc, usize value) : stmt{ type::stmt_jmp, loc }, value{ value }
 {
 }
 
-stmt_jmp_back::stmt_jmp_back(location const& loc, std::string const& value) : stmt{ type::stmt_jmp_back, loc }, value{ value }
+stmt_jmp_back::stmt_jmp_back(location const& loc, usize value) : stmt{ type::stmt_jmp_back, loc }, value{ value }
 {
 }
 
-stmt_jmp_cond::stmt_jmp_cond(location const& loc, expr::ptr test, std::string const& value) : stmt{ type::stmt_jmp_cond, loc }, test{ std::move(test) }, value{ value }
+stmt_jmp_cond::stmt_jmp_cond(location const& loc, expr::ptr test, usize value) : stmt{ type::stmt_jmp_cond, loc }, test{ std::move(test) }, value{ value }
 {
 }
 
-stmt_jmp_true::stmt_jmp_true(location const& loc, expr::ptr test, std::string const& value) : stmt{ type::stmt_jmp_true, loc }, test{ std::move(test) }, value{ value }
+stmt_jmp_true::stmt_jmp_true(location const& loc, expr::ptr test, usize value) : stmt{ type::stmt_jmp_true, loc }, test{ std::move(test) }, value{ value }
 {
 }
 
-stmt_jmp_false::stmt_jmp_false(location const& loc, expr::ptr test, std::string const& value) : stmt{ type::stmt_jmp_false, loc }, test{ std::move(test) }, value{ value }
+stmt_jmp_false::stmt_jmp_false(location const& loc, expr::ptr test, usize value) : stmt{ type::stmt_jmp_false, loc }, test{ std::move(test) }, value{ value }
 {
 }
 
-stmt_jmp_switch::stmt_jmp_switch(location const& loc, expr::ptr test, std::string const& value) : stmt{ type::stmt_jmp_switch, loc }, test{ std::move(test) }, value{ value }
+stmt_jmp_switch::stmt_jmp_switch(location const& loc, expr::ptr test, usize value) : stmt{ type::stmt_jmp_switch, loc }, test{ std::move(test) }, value{ value }
 {
 }
 
-stmt_jmp_endswitch::stmt_jmp_endswitch(location const& loc, std::vector<std::string> data) : stmt{ type::stmt_jmp_endswitch, loc }, data{ std::move(data) }
+stmt_jmp_endswitch::stmt_jmp_endswitch(location const& loc, std::vector<operand> data) : stmt{ type::stmt_jmp_endswitch, loc }, data{ std::move(data) }
 {
 }
 
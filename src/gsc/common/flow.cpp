@@ -0,0 +1,226 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/gsc/common/assembly.hpp"
+#include "xsk/gsc/common/flow.hpp"
+
+namespace xsk::gsc
+{
+
+namespace
+{
+
+auto has_label(instruction const& inst) -> bool
+{
+    for (auto const& entry : inst.data)
+    {
+        if (entry.type == operand::kind::label)
+            return true;
+    }
+
+    return false;
+}
+
+auto falls_through(opcode op) -> bool
+{
+    switch (op)
+    {
+        case opcode::OP_End:
+        case opcode::OP_Return:
+        case opcode::OP_jump:
+        case opcode::OP_jumpback:
+        case opcode::OP_switch:
+            return false;
+        default:
+            return true;
+    }
+}
+
+// cooper, harvey & kennedy: refine the immediate dominators in reverse postorder until they settle
+template<typename Next, typename Prev>
+auto dominators(usize size, u32 root, Next next, Prev prev) -> std::vector<u32>
+{
+    auto visited = std::vector<bool>(size, false);
+    auto order = std::vector<u32>(size, flowgraph::none);
+    auto rpo = std::vector<u32>{};
+    auto stack = std::vector<std::pair<u32, usize>>{ { root, 0 } };
+
+    visited[root] = true;
+
+    while (!stack.empty())
+    {
+        auto const node = stack.back().first;
+        auto const edge = stack.back().second++;
+        auto const& succs = next(node);
+
+        if (edge < succs.size())
+        {
+            if (!visited[succs[edge]])
+            {
+                visited[succs[edge]] = true;
+                stack.push_back({ succs[edge], 0 });
+            }
+        }
+        else
+        {
+            order[node] = static_cast<u32>(rpo.size());
+            rpo.push_back(node);
+            stack.pop_back();
+        }
+    }
+
+    std::ranges::reverse(rpo);
+
+    auto idom = std::vector<u32>(size, flowgraph::none);
+    idom[root] = root;
+
+    for (auto changed = true; changed; )
+    {
+        changed = false;
+
+        for (auto const node : rpo)
+        {
+            if (node == root)
+                continue;
+
+            auto dom = flowgraph::none;
+
+            for (auto const pred : prev(node))
+            {
+                if (idom[pred] == flowgraph::none)
+                    continue;
+
+                if (dom == flowgraph::none)
+                {
+                    dom = pred;
+                    continue;
+                }
+
+                auto a = pred;
+
+                while (a != dom)
+                {
+                    while (order[a] < order[dom]) a = idom[a];
+                    while (order[dom] < order[a]) dom = idom[dom];
+                }
+            }
+
+            if (idom[node] != dom)
+            {
+                idom[node] = dom;
+                changed = true;
+            }
+        }
+    }
+
+    idom[root] = flowgraph::none;
+    return idom;
+}
+
+} // namespace
+
+auto flowgraph::build(function const& func) -> void
+{
+    blocks.clear();
+    latches.clear();
+
+    auto ended = true;
+
+    for (auto const& inst : func.instructions)
+    {
+        if (ended || func.labels.contains(inst->index))
+            blocks.push_back(block{ inst->index, inst->index, none, none, {}, {} });
+
+        blocks.back().last = inst->index;
+        ended = has_label(*inst) || !falls_through(inst->opcode);
+    }
+
+    auto index = 0u;
+
+    for (auto const& inst : func.instructions)
+    {
+        if (index + 1 < blocks.size() && blocks[index + 1].begin == inst->index)
+            index++;
+
+        if (inst->index != blocks[index].last)
+            continue;
+
+        auto& succs = blocks[index].succs;
+
+        for (auto const& entry : inst->data)
+        {
+            if (entry.type != operand::kind::label)
+                continue;
+
+            if (auto const dest = find(entry.as_label()); dest != nullptr)
+                succs.push_back(static_cast<u32>(dest - blocks.data()));
+        }
+
+        if (falls_through(inst->opcode) && index + 1 < blocks.size())
+            succs.push_back(index + 1);
+
+        if (inst->opcode == opcode::OP_jumpback)
+            latches.push_back(index);
+    }
+
+    for (auto i = 0u; i < blocks.size(); i++)
+    {
+        for (auto const succ : blocks[i].succs)
+        {
+            auto& preds = blocks[succ].preds;
+
+            if (preds.empty() || preds.back() != i)
+                preds.push_back(i);
+        }
+    }
+
+    if (blocks.empty())
+        return;
+
+    auto const size = static_cast<u32>(blocks.size());
+    auto const idom = dominators(size, 0, [&](u32 i) -> auto const& { return blocks[i].succs; }, [&](u32 i) -> auto const& { return blocks[i].preds; });
+
+    // post dominators are the dominators of the reversed graph, rooted at a virtual exit after the last block
+    auto exits = std::vector<u32>{};
+    auto const exit = std::vector<u32>{ size };
+
+    for (auto i = 0u; i < size; i++)
+    {
+        if (blocks[i].succs.empty())
+            exits.push_back(i);
+    }
+
+    auto const ipdom = dominators(size + 1, size, [&](u32 i) -> auto const& { return (i == size) ? exits : blocks[i].preds; }, [&](u32 i) -> auto const& { return blocks[i].succs.empty() ? exit : blocks[i].succs; });
+
+    for (auto i = 0u; i < size; i++)
+    {
+        blocks[i].idom = idom[i];
+        blocks[i].ipdom = (ipdom[i] == size) ? none : ipdom[i];
+    }
+}
+
+auto flowgraph::find(usize offset) const -> block const*
+{
+    auto const itr = std::ranges::lower_bound(blocks, offset, {}, &block::begin);
+
+    if (itr == blocks.end() || itr->begin != offset)
+        return nullptr;
+
+    return &*itr;
+}
+
+auto flowgraph::dominates(u32 dom, u32 index) const -> bool
+{
+    for (; index != none; index = blocks[index].idom)
+    {
+        if (index == dom)
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace xsk::gsc
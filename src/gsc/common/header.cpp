@@ -0,0 +1,187 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/utils/file.hpp"
+#include "xsk/utils/reader.hpp"
+#include "xsk/utils/writer.hpp"
+#include "xsk/gsc/common/types.hpp"
+
+namespace xsk::gsc
+{
+
+namespace
+{
+
+constexpr auto header_magic = u32{ 0x48534758 };
+constexpr auto header_version = u32{ 1 };
+
+auto write_text(utils::writer& out, std::string_view text) -> void
+{
+    out.write<u32>(static_cast<u32>(text.size()));
+    out.write_string(std::string{ text });
+}
+
+auto read_text(utils::reader& in) -> std::string_view
+{
+    auto const size = in.read<u32>();
+
+    if (in.pos() + size > in.size())
+        throw utils::reader::error("reader: out of bounds");
+
+    auto const text = std::string_view{ reinterpret_cast<char const*>(in.data() + in.pos()), size };
+    in.seek(size);
+    return text;
+}
+
+} // namespace
+
+auto header_cache::find(std::string const& name) -> std::pair<header::ptr, header_defines::ptr>
+{
+    auto lock = std::lock_guard{ mutex_ };
+    auto const itr = slots_.find(name);
+
+    if (itr == slots_.end())
+        return {};
+
+    return { itr->second.data, itr->second.defines };
+}
+
+auto header_cache::insert(header::ptr data) -> void
+{
+    auto lock = std::lock_guard{ mutex_ };
+    auto& entry = slots_[data->name];
+    entry = slot{ std::move(data), nullptr };
+}
+
+// defines recorded from a replay are kept only while their header is still the cached one
+auto header_cache::publish(header_defines::ptr defines) -> void
+{
+    auto lock = std::lock_guard{ mutex_ };
+    auto const itr = slots_.find(defines->source->name);
+
+    if (itr != slots_.end() && itr->second.data == defines->source && itr->second.defines == nullptr)
+        itr->second.defines = std::move(defines);
+}
+
+auto header_cache::clear() -> void
+{
+    auto lock = std::lock_guard{ mutex_ };
+    slots_.clear();
+}
+
+auto header_cache::save(std::filesystem::path const& file) -> void
+{
+    auto out = utils::writer{};
+    auto count = u32{ 0 };
+
+    out.write<u32>(header_magic);
+    out.write<u32>(header_version);
+    out.write<u32>(0);
+
+    {
+        auto lock = std::lock_guard{ mutex_ };
+
+        for (auto const& [name, entry] : slots_)
+        {
+            if (entry.data->error)
+                continue;
+
+            write_text(out, entry.data->name);
+            write_text(out, entry.data->data);
+            out.write<u8>(entry.data->dev);
+            out.write<u32>(static_cast<u32>(entry.data->tokens.size()));
+
+            for (auto const& tok : entry.data->tokens)
+            {
+                out.write<u8>(tok.type);
+                out.write<u8>(static_cast<u8>(tok.space));
+                out.write<i32>(tok.pos.begin.line);
+                out.write<i32>(tok.pos.begin.column);
+                out.write<i32>(tok.pos.end.line);
+                out.write<i32>(tok.pos.end.column);
+                write_text(out, tok.data);
+            }
+
+            count++;
+        }
+    }
+
+    auto const size = out.pos();
+    out.pos(8);
+    out.write<u32>(count);
+
+    // concurrent runs sharing a cache directory replace the file whole
+    auto const temp = utils::file::temp_path(file);
+
+    try
+    {
+        utils::file::save(temp, out.data(), size);
+        std::filesystem::rename(temp, file);
+    }
+    catch (std::exception const&)
+    {
+        auto ec = std::error_code{};
+        std::filesystem::remove(temp, ec);
+    }
+}
+
+// a missing, stale or damaged file leaves the cache empty, headers are lexed again on use
+auto header_cache::load(std::filesystem::path const& file) -> void
+{
+    if (!utils::file::exists(file))
+        return;
+
+    auto slots = std::unordered_map<std::string, slot>{};
+
+    try
+    {
+        auto const data = utils::file::read(file);
+        auto in = utils::reader{ data };
+
+        if (in.read<u32>() != header_magic || in.read<u32>() != header_version)
+            return;
+
+        auto const count = in.read<u32>();
+
+        for (auto i = 0u; i < count; i++)
+        {
+            auto entry = std::make_shared<header>();
+            entry->name = read_text(in);
+            entry->data = read_text(in);
+            entry->dev = in.read<u8>() != 0;
+
+            auto const size = in.read<u32>();
+            entry->tokens.reserve(size);
+
+            for (auto j = 0u; j < size; j++)
+            {
+                auto const type = static_cast<token::kind>(in.read<u8>());
+                auto const space = static_cast<spacing>(in.read<u8>());
+                auto pos = location{ &entry->name };
+                pos.begin.line = in.read<i32>();
+                pos.begin.column = in.read<i32>();
+                pos.end.line = in.read<i32>();
+                pos.end.column = in.read<i32>();
+                entry->tokens.push_back(token{ type, space, pos, entry->strings.store(read_text(in)) });
+            }
+
+            if (entry->tokens.empty() || entry->tokens.back().type != token::EOS)
+                return;
+
+            auto& res = slots[entry->name];
+            res = slot{ std::move(entry), nullptr };
+        }
+    }
+    catch (std::exception const&)
+    {
+        return;
+    }
+
+    auto lock = std::lock_guard{ mutex_ };
+    slots_.merge(slots);
+}
+
+} // namespace xsk::gsc
@@ -9,7 +9,7 @@
 namespace xsk::gsc
 {
 
-scope::scope() : abort{ scope::abort_none }, create_count{ 0 }, public_count{ 0 }, is_last{ false }
+scope::scope() : abort{ scope::abort_none }, loc_end{ 0 }, loc_cont{ 0 }, loc_break{ 0 }, create_count{ 0 }, public_count{ 0 }, is_last{ false }
 {
 }
 
@@ -64,12 +64,12 @@ auto token::to_string() -> std::string
         case token::RBRACE: return "}";
         case token::LPAREN: return "(";
         case token::RPAREN: return ")";
-        case token::NAME: return data;
-        case token::PATH: return data;
-        case token::STRING: return data;
-        case token::ISTRING: return data;
-        case token::INT: return data;
-        case token::FLT: return data;
+        case token::NAME: return std::string{ data };
+        case token::PATH: return std::string{ data };
+        case token::STRING: return std::string{ data };
+        case token::ISTRING: return std::string{ data };
+        case token::INT: return std::string{ data };
+        case token::FLT: return std::string{ data };
         case token::DEVBEGIN: return "/#";
         case token::DEVEND: return "#/";
         case token::INLINE: return "#inline";
@@ -22,11 +22,200 @@ auto compiler::compile(program const& data) -> assembly::ptr
 
 auto compiler::compile(std::string const& file, std::vector<u8>& data) -> assembly::ptr
 {
+    ctx_->init_dependencies();
+
     auto prog = ctx_->source().parse_program(file, data);
     return compile(*prog);
 }
 
+// functions are lowered by workers from offset 0, then rebased and stitched in script order
+auto compiler::compile(program const& data, utils::thread_pool& pool) -> assembly::ptr
+{
+    struct unit
+    {
+        decl_function const* func;
+        std::string animname;
+        usize animtree;
+        function::ptr data;
+        sourcepos pos;
+        bool animload;
+        std::exception_ptr error;
+    };
+
+    auto funcs = 0u;
+
+    for (auto const& dec : data.declarations)
+    {
+        if (dec->is<decl_function>())
+            funcs++;
+        else if (dec->is<decl_constant>() && funcs != 0)
+            return compile(data);
+    }
+
+    if (pool.size() < 2 || funcs < 2)
+        return compile(data);
+
+    emit_symbols(data);
+
+    auto units = std::vector<unit>{};
+    auto animtree = usize{ 0 };
+
+    try
+    {
+        for (auto const& dec : data.declarations)
+        {
+            if (!dec->is<decl_function>())
+            {
+                emit_decl(*dec);
+                animtree += dec->is<decl_usingtree>() ? 1 : 0;
+                continue;
+            }
+
+            units.push_back(unit{ &dec->as<decl_function>(), animname_, animtree, nullptr, {}, false, nullptr });
+        }
+    }
+    catch (...)
+    {
+        units.push_back(unit{ nullptr, {}, 0, nullptr, {}, false, std::current_exception() });
+    }
+
+    while (workers_.size() < pool.size())
+    {
+        workers_.push_back(std::make_unique<compiler>(ctx_));
+    }
+
+    for (auto& worker : workers_)
+    {
+        worker->assembly_ = assembly::make();
+        worker->localfuncs_ = localfuncs_;
+        worker->constants_ = constants_;
+    }
+
+    pool.run(units.size(), [&](usize index, usize worker)
+    {
+        auto& self = *workers_[worker];
+        auto& entry = units[index];
+
+        if (entry.func == nullptr)
+            return;
+
+        self.index_ = 0;
+        self.debug_pos_ = { -1, -1 };
+        self.animname_ = entry.animname;
+        self.animload_ = false;
+
+        try
+        {
+            self.emit_decl_function(*entry.func);
+            entry.data = std::move(self.assembly_->functions.back());
+            entry.pos = self.debug_pos_;
+            entry.animload = self.animload_;
+        }
+        catch (...)
+        {
+            entry.error = std::current_exception();
+        }
+
+        self.assembly_->functions.clear();
+    });
+
+    for (auto& worker : workers_)
+    {
+        worker->assembly_.reset();
+        worker->function_.reset();
+        worker->scopes_.clear();
+    }
+
+    animtree = 0;
+
+    for (auto& entry : units)
+    {
+        if (entry.error)
+            std::rethrow_exception(entry.error);
+
+        if (entry.animtree != animtree)
+        {
+            animtree = entry.animtree;
+            animload_ = false;
+        }
+
+        animname_ = entry.animname;
+
+        auto& func = entry.data;
+
+        // big endian vectors are padded to the absolute offset, those functions are lowered again in place
+        if (ctx_->endian() == endian::big && (index_ & 3) != 0 && std::ranges::any_of(func->instructions, [](auto const& inst) { return inst->opcode == opcode::OP_GetVector; }))
+        {
+            emit_decl_function(*entry.func);
+            continue;
+        }
+
+        if (animload_ && entry.animload)
+        {
+            for (auto& inst : func->instructions)
+            {
+                if (inst->opcode == opcode::OP_GetAnimation || inst->opcode == opcode::OP_GetAnimTree)
+                {
+                    inst->data[0] = "";
+                    break;
+                }
+            }
+        }
+
+        for (auto& inst : func->instructions)
+        {
+            inst->index += index_;
+
+            if (inst->pos.line == -1)
+                inst->pos = debug_pos_;
+
+            for (auto& arg : inst->data)
+            {
+                if (arg.type == operand::kind::label)
+                    arg.integer += static_cast<i64>(index_);
+            }
+        }
+
+        auto labels = std::unordered_map<usize, std::string>{};
+
+        for (auto const& [index, name] : func->labels)
+        {
+            labels.insert({ index + index_, std::format("loc_{:X}", index + index_) });
+        }
+
+        func->labels = std::move(labels);
+        func->index = index_;
+        index_ += func->size;
+        animload_ = animload_ || entry.animload;
+
+        if (entry.pos.line != -1)
+            debug_pos_ = entry.pos;
+
+        assembly_->functions.push_back(std::move(func));
+    }
+
+    return std::move(assembly_);
+}
+
+auto compiler::compile(std::string const& file, std::vector<u8>& data, utils::thread_pool& pool) -> assembly::ptr
+{
+    ctx_->init_dependencies();
+
+    auto prog = ctx_->source().parse_program(file, data);
+    return compile(*prog, pool);
+}
+
 auto compiler::emit_program(program const& prog) -> void
+{
+    emit_symbols(prog);
+
+    for (auto const& dec : prog.declarations)
+    {
+        emit_decl(*dec);
+    }
+}
+
+auto compiler::emit_symbols(program const& prog) -> void
 {
     assembly_ = assembly::make();
     localfuncs_.clear();
@@ -60,20 +249,12 @@ auto compiler::emit_program(program const& prog) -> void
                 throw comp_error(dec->loc(), std::format("function name '{}' already defined as builtin", name));
             }
 
-            for (auto const& entry : localfuncs_)
+            if (!localfuncs_.insert(name).second)
             {
-                if (entry == name)
-                    throw comp_error(dec->loc(), std::format("function name '{}' already defined as local function", name));
+                throw comp_error(dec->loc(), std::format("function name '{}' already defined as local function", name));
             }
-
-            localfuncs_.push_back(dec->as<decl_function>().name->value);
         }
     }
-
-    for (auto const& dec : prog.declarations)
-    {
-        emit_decl(*dec);
-    }
 }
 
 auto compiler::emit_decl(decl const& dec) -> void
@@ -121,7 +302,9 @@ auto compiler::emit_decl_constant(decl_constant const& constant) -> void
 
 auto compiler::emit_decl_function(decl_function const& func) -> void
 {
-    label_idx_ = 0;
+    labels_.assign(1, 0);
+    aliases_.assign(1, 0);
+    label_index_.clear();
     can_break_ = false;
     can_continue_ = false;
     scopes_.clear();
@@ -141,6 +324,7 @@ auto compiler::emit_decl_function(decl_function const& func) -> void
     emit_expr_parameters(*func.params, *scp);
     emit_stmt_comp(*func.body, *scp, true);
     emit_opcode(opcode::OP_End);
+    resolve_labels();
 
     function_->size = index_ - function_->index;
     assembly_->functions.push_back(std::move(function_));
@@ -323,7 +507,7 @@ auto compiler::emit_stmt_waittill(stmt_waittill const& stm, scope& scp) -> void
 
     for (auto const& entry : stm.args->list)
     {
-        emit_opcode(opcode::OP_SafeSetWaittillVariableFieldCached, std::format("{}", variable_create(entry->as<expr_identifier>(), scp)));
+        emit_opcode(opcode::OP_SafeSetWaittillVariableFieldCached, operand::make_int(variable_create(entry->as<expr_identifier>(), scp)));
     }
 
     emit_opcode(opcode::OP_clearparams);
@@ -334,7 +518,7 @@ auto compiler::emit_stmt_waittillmatch(stmt_waittillmatch const& stm, scope& scp
     emit_expr_arguments(*stm.args, scp);
     emit_expr(*stm.event, scp);
     emit_expr(*stm.obj, scp);
-    emit_opcode(opcode::OP_waittillmatch, std::format("{}", stm.args->list.size()));
+    emit_opcode(opcode::OP_waittillmatch, operand::make_int(stm.args->list.size()));
     emit_opcode(opcode::OP_waittillmatch2);
     emit_opcode(opcode::OP_clearparams);
 }
@@ -356,12 +540,12 @@ auto compiler::emit_stmt_if(stmt_if const& stm, scope& scp, bool last) -> void
     if (stm.test->is<expr_not>())
     {
         emit_expr(*stm.test->as<expr_not>().rvalue, scp);
-        emit_opcode(opcode::OP_JumpOnTrue, end_loc);
+        emit_opcode(opcode::OP_JumpOnTrue, operand::make_label(end_loc));
     }
     else
     {
         emit_expr(*stm.test, scp);
-        emit_opcode(opcode::OP_JumpOnFalse, end_loc);
+        emit_opcode(opcode::OP_JumpOnFalse, operand::make_label(end_loc));
     }
 
     auto& scp_body = scopes_.at(stm.body.get());
@@ -384,12 +568,12 @@ auto compiler::emit_stmt_ifelse(stmt_ifelse const& stm, scope& scp, bool last) -
     if (stm.test->is<expr_not>())
     {
         emit_expr(*stm.test->as<expr_not>().rvalue, scp);
-        emit_opcode(opcode::OP_JumpOnTrue, else_loc);
+        emit_opcode(opcode::OP_JumpOnTrue, operand::make_label(else_loc));
     }
     else
     {
         emit_expr(*stm.test, scp);
-        emit_opcode(opcode::OP_JumpOnFalse, else_loc);
+        emit_opcode(opcode::OP_JumpOnFalse, operand::make_label(else_loc));
     }
 
     auto& scp_then = scopes_.at(stm.stmt_if.get());
@@ -403,7 +587,7 @@ auto compiler::emit_stmt_ifelse(stmt_ifelse const& stm, scope& scp, bool last) -
     if (scp_then->abort == scope::abort_none)
         childs.push_back(scp_then.get());
 
-    last ? emit_opcode(opcode::OP_End) : emit_opcode(opcode::OP_jump, end_loc);
+    last ? emit_opcode(opcode::OP_End) : emit_opcode(opcode::OP_jump, operand::make_label(end_loc));
 
     insert_label(else_loc);
 
@@ -456,19 +640,19 @@ auto compiler::emit_stmt_while(stmt_while const& stm, scope& scp) -> void
         if (stm.test->is<expr_not>())
         {
             emit_expr(*stm.test->as<expr_not>().rvalue, scp);
-            emit_opcode(opcode::OP_JumpOnTrue, break_loc);
+            emit_opcode(opcode::OP_JumpOnTrue, operand::make_label(break_loc));
         }
         else
         {
             emit_expr(*stm.test, scp);
-            emit_opcode(opcode::OP_JumpOnFalse, break_loc);
+            emit_opcode(opcode::OP_JumpOnFalse, operand::make_label(break_loc));
         }
     }
 
     emit_stmt(*stm.body, *scp_body, false);
 
     insert_label(continue_loc);
-    emit_opcode(opcode::OP_jumpback, begin_loc);
+    emit_opcode(opcode::OP_jumpback, operand::make_label(begin_loc));
 
     insert_label(break_loc);
 
@@ -518,16 +702,16 @@ auto compiler::emit_stmt_dowhile(stmt_dowhile const& stm, scope& scp) -> void
         if (stm.test->is<expr_not>())
         {
             emit_expr(*stm.test->as<expr_not>().rvalue, scp);
-            emit_opcode(opcode::OP_JumpOnTrue, break_loc);
+            emit_opcode(opcode::OP_JumpOnTrue, operand::make_label(break_loc));
         }
         else
         {
             emit_expr(*stm.test, scp);
-            emit_opcode(opcode::OP_JumpOnFalse, break_loc);
+            emit_opcode(opcode::OP_JumpOnFalse, operand::make_label(break_loc));
         }
     }
 
-    emit_opcode(opcode::OP_jumpback, begin_loc);
+    emit_opcode(opcode::OP_jumpback, operand::make_label(begin_loc));
 
     insert_label(break_loc);
 
@@ -579,12 +763,12 @@ auto compiler::emit_stmt_for(stmt_for const& stm, scope& scp) -> void
         if (stm.test->is<expr_not>())
         {
             emit_expr(*stm.test->as<expr_not>().rvalue, scp);
-            emit_opcode(opcode::OP_JumpOnTrue, break_loc);
+            emit_opcode(opcode::OP_JumpOnTrue, operand::make_label(break_loc));
         }
         else
         {
             emit_expr(*stm.test, scp);
-            emit_opcode(opcode::OP_JumpOnFalse, break_loc);
+            emit_opcode(opcode::OP_JumpOnFalse, operand::make_label(break_loc));
         }
     }
 
@@ -604,7 +788,7 @@ auto compiler::emit_stmt_for(stmt_for const& stm, scope& scp) -> void
     scp_iter->init(continue_blks_);
 
     emit_stmt(*stm.iter, *scp_iter, false);
-    emit_opcode(opcode::OP_jumpback, begin_loc);
+    emit_opcode(opcode::OP_jumpback, operand::make_label(begin_loc));
 
     insert_label(break_loc);
 
@@ -636,7 +820,7 @@ auto compiler::emit_stmt_foreach(stmt_foreach const& stm, scope& scp) -> void
     emit_expr_variable(*stm.array, scp);
 
     if (ctx_->props() & props::farcall)
-        emit_opcode(opcode::OP_CallBuiltin, { "getfirstarraykey"s, "1"s });
+        emit_opcode(opcode::OP_CallBuiltin, { "getfirstarraykey"s, operand::make_int(1) });
     else
         emit_opcode(opcode::OP_CallBuiltin1, "getfirstarraykey");
 
@@ -670,13 +854,13 @@ auto compiler::emit_stmt_foreach(stmt_foreach const& stm, scope& scp) -> void
     else
         emit_opcode(opcode::OP_CallBuiltin1, "isdefined");
 
-    emit_opcode(opcode::OP_JumpOnFalse, break_loc);
+    emit_opcode(opcode::OP_JumpOnFalse, operand::make_label(break_loc));
 
     can_break_ = true;
     can_continue_ = true;
 
     emit_expr_variable(*stm.key, *scp_body);
-    emit_opcode(opcode::OP_EvalLocalArrayCached, std::format("{}", variable_access(stm.array->as<expr_identifier>(), *scp_body)));
+    emit_opcode(opcode::OP_EvalLocalArrayCached, operand::make_int(variable_access(stm.array->as<expr_identifier>(), *scp_body)));
     emit_expr_variable_ref(*stm.value, *scp_body, true);
 
     if (ctx_->props() & props::foreach && stm.use_key)
@@ -701,12 +885,12 @@ auto compiler::emit_stmt_foreach(stmt_foreach const& stm, scope& scp) -> void
     emit_expr_variable(*stm.array, *scp_iter);
 
     if (ctx_->props() & props::farcall)
-        emit_opcode(opcode::OP_CallBuiltin, { "getnextarraykey"s, "2"s });
+        emit_opcode(opcode::OP_CallBuiltin, { "getnextarraykey"s, operand::make_int(2) });
     else
         emit_opcode(opcode::OP_CallBuiltin2, "getnextarraykey");
 
     emit_expr_variable_ref(*stm.key, *scp_iter, true);
-    emit_opcode(opcode::OP_jumpback, begin_loc);
+    emit_opcode(opcode::OP_jumpback, operand::make_label(begin_loc));
 
     insert_label(break_loc);
     emit_expr_clear_local(stm.array->as<expr_identifier>(), scp);
@@ -729,14 +913,14 @@ auto compiler::emit_stmt_switch(stmt_switch const& stm, scope& scp) -> void
     auto break_loc = create_label();
 
     emit_expr(*stm.test, scp);
-    emit_opcode(opcode::OP_switch, table_loc);
+    emit_opcode(opcode::OP_switch, operand::make_label(table_loc));
 
     can_break_ = true;
 
-    auto data = std::vector<std::string>{};
-    data.push_back(std::format("{}", stm.body->block->list.size()));
+    auto data = std::vector<operand>{};
+    data.push_back(operand::make_int(stm.body->block->list.size()));
 
-    auto loc_default = std::string{};
+    auto loc_default = u32{ 0 };
     auto has_default = false;
     scope* default_ctx = nullptr;
 
@@ -750,15 +934,15 @@ auto compiler::emit_stmt_switch(stmt_switch const& stm, scope& scp) -> void
 
             if (entry->as<stmt_case>().value->is<expr_integer>())
             {
-                data.push_back(std::format("{}", static_cast<i32>(switch_type::integer)));
-                data.push_back(entry->as<stmt_case>().value->as<expr_integer>().value);
-                data.push_back(insert_label());
+                data.push_back(operand::make_int(static_cast<i32>(switch_type::integer)));
+                data.push_back(operand::make_int(std::stoll(entry->as<stmt_case>().value->as<expr_integer>().value)));
+                data.push_back(operand::make_label(insert_label()));
             }
             else if (entry->as<stmt_case>().value->is<expr_string>())
             {
-                data.push_back(std::format("{}", static_cast<std::underlying_type_t<switch_type>>(switch_type::string)));
+                data.push_back(operand::make_int(static_cast<i32>(switch_type::string)));
                 data.push_back(entry->as<stmt_case>().value->as<expr_string>().value);
-                data.push_back(insert_label());
+                data.push_back(operand::make_label(insert_label()));
             }
             else
             {
@@ -799,7 +983,7 @@ auto compiler::emit_stmt_switch(stmt_switch const& stm, scope& scp) -> void
     if (has_default)
     {
         data.push_back("default");
-        data.push_back(loc_default);
+        data.push_back(operand::make_label(loc_default));
 
         if (default_ctx->abort == scope::abort_none)
             break_blks_.push_back(default_ctx);
@@ -832,7 +1016,7 @@ auto compiler::emit_stmt_default(stmt_default const& stm, scope&) -> void
 
 auto compiler::emit_stmt_break(stmt_break const& stm, scope& scp) -> void
 {
-    if (!can_break_ /*|| scp.abort != scope::abort_none*/ || scp.loc_break == "")
+    if (!can_break_ /*|| scp.abort != scope::abort_none*/ || scp.loc_break == 0)
         throw comp_error(stm.loc(), "illegal break statement");
 
     if (scp.abort == scope::abort_none)
@@ -842,12 +1026,12 @@ auto compiler::emit_stmt_break(stmt_break const& stm, scope& scp) -> void
         scp.abort = scope::abort_break;
     }
 
-    emit_opcode(opcode::OP_jump, scp.loc_break);
+    emit_opcode(opcode::OP_jump, operand::make_label(scp.loc_break));
 }
 
 auto compiler::emit_stmt_continue(stmt_continue const& stm, scope& scp) -> void
 {
-    if (!can_continue_ /*|| scp.abort != scope::abort_none*/ || scp.loc_cont == "")
+    if (!can_continue_ /*|| scp.abort != scope::abort_none*/ || scp.loc_cont == 0)
         throw comp_error(stm.loc(), "illegal continue statement");
 
     if (scp.abort == scope::abort_none)
@@ -857,7 +1041,7 @@ auto compiler::emit_stmt_continue(stmt_continue const& stm, scope& scp) -> void
         scp.abort = scope::abort_continue;
     }
 
-    emit_opcode(opcode::OP_jump, scp.loc_cont);
+    emit_opcode(opcode::OP_jump, operand::make_label(scp.loc_cont));
 }
 
 auto compiler::emit_stmt_return(stmt_return const& stm, scope& scp) -> void
@@ -1106,7 +1290,7 @@ auto compiler::emit_expr_clear_local(expr_identifier const& exp, scope& scp) ->
     if (index == 0)
         emit_opcode(opcode::OP_ClearLocalVariableFieldCached0);
     else
-        emit_opcode(opcode::OP_ClearLocalVariableFieldCached, std::format("{}", index));
+        emit_opcode(opcode::OP_ClearLocalVariableFieldCached, operand::make_int(index));
 }
 
 auto compiler::emit_expr_increment(expr_increment const& exp, scope& scp, bool is_stmt) -> void
@@ -1145,16 +1329,16 @@ auto compiler::emit_expr_ternary(expr_ternary const& exp, scope& scp) -> void
     if (exp.test->is<expr_not>())
     {
         emit_expr(*exp.test->as<expr_not>().rvalue, scp);
-        emit_opcode(opcode::OP_JumpOnTrue, else_loc);
+        emit_opcode(opcode::OP_JumpOnTrue, operand::make_label(else_loc));
     }
     else
     {
         emit_expr(*exp.test, scp);
-        emit_opcode(opcode::OP_JumpOnFalse, else_loc);
+        emit_opcode(opcode::OP_JumpOnFalse, operand::make_label(else_loc));
     }
 
     emit_expr(*exp.true_expr, scp);
-    emit_opcode(opcode::OP_jump, end_loc);
+    emit_opcode(opcode::OP_jump, operand::make_label(end_loc));
 
     insert_label(else_loc);
     emit_expr(*exp.false_expr, scp);
@@ -1168,7 +1352,7 @@ auto compiler::emit_expr_binary(expr_binary const& exp, scope& scp) -> void
         auto label = create_label();
 
         emit_expr(*exp.lvalue, scp);
-        emit_opcode(opcode::OP_JumpOnFalseExpr, label);
+        emit_opcode(opcode::OP_JumpOnFalseExpr, operand::make_label(label));
 
         if (exp.rvalue->is<expr_not>() && (ctx_->props() & props::boolnotand))
         {
@@ -1188,7 +1372,7 @@ auto compiler::emit_expr_binary(expr_binary const& exp, scope& scp) -> void
         auto label = create_label();
 
         emit_expr(*exp.lvalue, scp);
-        emit_opcode(opcode::OP_JumpOnTrueExpr, label);
+        emit_opcode(opcode::OP_JumpOnTrueExpr, operand::make_label(label));
 
         if (exp.rvalue->is<expr_not>() && (ctx_->props() & props::boolnotand))
         {
@@ -1301,7 +1485,7 @@ auto compiler::emit_expr_call_pointer(expr_pointer const& exp, scope& scp, bool
     emit_expr_arguments(*exp.args, scp);
     emit_expr(*exp.func, scp);
 
-    auto argcount = std::format("{}", exp.args->list.size());
+    auto argcount = operand::make_int(exp.args->list.size());
 
     switch (exp.mode)
     {
@@ -1338,7 +1522,7 @@ auto compiler::emit_expr_call_function(expr_function const& exp, scope& scp, boo
 
     emit_expr_arguments(*exp.args, scp);
 
-    auto argcount = std::format("{}", exp.args->list.size());
+    auto argcount = operand::make_int(exp.args->list.size());
 
     if (type == call::type::local)
     {
@@ -1443,7 +1627,7 @@ auto compiler::emit_expr_method_pointer(expr_pointer const& exp, expr const& obj
     emit_expr(obj, scp);
     emit_expr(*exp.func, scp);
 
-    auto argcount = std::format("{}", exp.args->list.size());
+    auto argcount = operand::make_int(exp.args->list.size());
 
     switch (exp.mode)
     {
@@ -1481,7 +1665,7 @@ auto compiler::emit_expr_method_function(expr_function const& exp, expr const& o
     emit_expr_arguments(*exp.args, scp);
     emit_expr(obj, scp);
 
-    auto argcount = std::format("{}", exp.args->list.size());
+    auto argcount = operand::make_int(exp.args->list.size());
 
     if (type == call::type::local)
     {
@@ -1580,15 +1764,15 @@ auto compiler::emit_expr_parameters(expr_parameters const& exp, scope& scp) -> v
 
         if (num)
         {
-            auto data = std::vector<std::string>{};
+            auto data = std::vector<operand>{};
             auto size = (ctx_->props() & props::hash) ? num * 8 : num;
 
-            data.push_back(std::format("{}", num));
+            data.push_back(operand::make_int(num));
 
             for (auto const& entry : exp.list)
             {
                 auto index = variable_initialize(*entry, scp);
-                data.push_back((ctx_->props() & props::hash) ? entry->value : std::format("{}", index));
+                data.push_back((ctx_->props() & props::hash) ? operand{ entry->value } : operand::make_int(index));
             }
 
             emit_opcode(opcode::OP_FormalParams, data);
@@ -1606,7 +1790,7 @@ auto compiler::emit_expr_parameters(expr_parameters const& exp, scope& scp) -> v
         {
             if (!variable_initialized(*entry, scp))
             {
-                emit_opcode(opcode::OP_SafeCreateVariableFieldCached, std::format("{}", variable_initialize(*entry, scp)));
+                emit_opcode(opcode::OP_SafeCreateVariableFieldCached, operand::make_int(variable_initialize(*entry, scp)));
             }
             else
             {
@@ -1615,7 +1799,7 @@ auto compiler::emit_expr_parameters(expr_parameters const& exp, scope& scp) -> v
                 if (index == 0)
                     emit_opcode(opcode::OP_SafeSetVariableFieldCached0);
                 else
-                    emit_opcode(opcode::OP_SafeSetVariableFieldCached, std::format("{}", index));
+                    emit_opcode(opcode::OP_SafeSetVariableFieldCached, operand::make_int(index));
             }
         }
 
@@ -1688,11 +1872,11 @@ auto compiler::emit_expr_tuple(expr_tuple const& exp, scope& scp) -> void
         if (index == 0)
             emit_opcode(opcode::OP_GetZero);
         else
-            emit_opcode(opcode::OP_GetByte, std::format("{}", index));
+            emit_opcode(opcode::OP_GetByte, operand::make_int(index));
 
         index++;
 
-        emit_opcode(opcode::OP_EvalLocalArrayCached, std::format("{}", variable_access(exp.temp->as<expr_identifier>(), scp)));
+        emit_opcode(opcode::OP_EvalLocalArrayCached, operand::make_int(variable_access(exp.temp->as<expr_identifier>(), scp)));
 
         emit_expr_variable_ref(*entry, scp, true);
     }
@@ -1740,7 +1924,7 @@ auto compiler::emit_expr_array_ref(expr_array const& exp, scope& scp, bool set)
             if (!variable_initialized(exp.obj->as<expr_identifier>(), scp))
             {
                 auto index = variable_initialize(exp.obj->as<expr_identifier>(), scp);
-                emit_opcode(opcode::OP_EvalNewLocalArrayRefCached0, (ctx_->props() & props::hash) ? exp.obj->as<expr_identifier>().value : std::format("{}", index));
+                emit_opcode(opcode::OP_EvalNewLocalArrayRefCached0, (ctx_->props() & props::hash) ? operand{ exp.obj->as<expr_identifier>().value } : operand::make_int(index));
 
                 // trigger if nested array for lvalue 'var[1][2] = 3;' set is in outer array
                 //if (!set) throw comp_error(exp.loc(), "INTERNAL: VAR CREATED BUT NOT SET");
@@ -1752,7 +1936,7 @@ auto compiler::emit_expr_array_ref(expr_array const& exp, scope& scp, bool set)
                 if (index == 0)
                     emit_opcode(opcode::OP_EvalLocalArrayRefCached0);
                 else
-                    emit_opcode(opcode::OP_EvalLocalArrayRefCached, std::format("{}", index));
+                    emit_opcode(opcode::OP_EvalLocalArrayRefCached, operand::make_int(index));
             }
 
             if (set) emit_opcode(opcode::OP_SetVariableField);
@@ -1793,7 +1977,7 @@ auto compiler::emit_expr_field_ref(expr_field const& exp, scope& scp, bool set)
             if (set) emit_opcode(opcode::OP_SetVariableField);
             break;
         case node::expr_identifier:
-            emit_opcode(opcode::OP_EvalLocalVariableObjectCached, std::format("{}", variable_access(exp.obj->as<expr_identifier>(), scp)));
+            emit_opcode(opcode::OP_EvalLocalVariableObjectCached, operand::make_int(variable_access(exp.obj->as<expr_identifier>(), scp)));
             emit_opcode(opcode::OP_EvalFieldVariableRef, field);
             if (set) emit_opcode(opcode::OP_SetVariableField);
             break;
@@ -1828,7 +2012,7 @@ auto compiler::emit_expr_local_ref(expr_identifier const& exp, scope& scp, bool
         if (!variable_initialized(exp, scp))
         {
             auto index = variable_initialize(exp, scp);
-            emit_opcode(opcode::OP_SetNewLocalVariableFieldCached0, (ctx_->props() & props::hash) ? exp.value : std::format("{}", index));
+            emit_opcode(opcode::OP_SetNewLocalVariableFieldCached0, (ctx_->props() & props::hash) ? operand{ exp.value } : operand::make_int(index));
         }
         else
         {
@@ -1837,7 +2021,7 @@ auto compiler::emit_expr_local_ref(expr_identifier const& exp, scope& scp, bool
             if (index == 0)
                 emit_opcode(opcode::OP_SetLocalVariableFieldCached0);
             else
-                emit_opcode(opcode::OP_SetLocalVariableFieldCached, std::format("{}", index));
+                emit_opcode(opcode::OP_SetLocalVariableFieldCached, operand::make_int(index));
         }
     }
     else
@@ -1847,7 +2031,7 @@ auto compiler::emit_expr_local_ref(expr_identifier const& exp, scope& scp, bool
         if (index == 0)
             emit_opcode(opcode::OP_EvalLocalVariableRefCached0);
         else
-            emit_opcode(opcode::OP_EvalLocalVariableRefCached, std::format("{}", index));
+            emit_opcode(opcode::OP_EvalLocalVariableRefCached, operand::make_int(index));
     }
 }
 
@@ -1875,7 +2059,7 @@ auto compiler::emit_expr_array(expr_array const& exp, scope& scp) -> void
 
     if (exp.obj->is<expr_identifier>())
     {
-        emit_opcode(opcode::OP_EvalLocalArrayCached, std::format("{}", variable_access(exp.obj->as<expr_identifier>(), scp)));
+        emit_opcode(opcode::OP_EvalLocalArrayCached, operand::make_int(variable_access(exp.obj->as<expr_identifier>(), scp)));
     }
     else
     {
@@ -1920,7 +2104,7 @@ auto compiler::emit_expr_field(expr_field const& exp, scope& scp) -> void
             emit_opcode(opcode::OP_EvalFieldVariable, field);
             break;
         case node::expr_identifier:
-            emit_opcode(opcode::OP_EvalLocalVariableObjectCached, std::format("{}", variable_access(exp.obj->as<expr_identifier>(), scp)));
+            emit_opcode(opcode::OP_EvalLocalVariableObjectCached, operand::make_int(variable_access(exp.obj->as<expr_identifier>(), scp)));
             emit_opcode(opcode::OP_EvalFieldVariable, field);
             break;
         default:
@@ -1962,7 +2146,7 @@ auto compiler::emit_expr_local(expr_identifier const& exp, scope& scp) -> void
             emit_opcode(opcode::OP_EvalLocalVariableCached5);
             break;
         default:
-            emit_opcode(opcode::OP_EvalLocalVariableCached, std::format("{}", index));
+            emit_opcode(opcode::OP_EvalLocalVariableCached, operand::make_int(index));
             break;
     }
 }
@@ -1997,7 +2181,7 @@ auto compiler::emit_expr_object(expr const& exp, scope& scp) -> void
             emit_opcode(opcode::OP_CastFieldObject);
             break;
         case node::expr_identifier:
-            emit_opcode(opcode::OP_EvalLocalVariableObjectCached, std::format("{}", variable_access(exp.as<expr_identifier>(), scp)));
+            emit_opcode(opcode::OP_EvalLocalVariableObjectCached, operand::make_int(variable_access(exp.as<expr_identifier>(), scp)));
             break;
         default:
             throw comp_error(exp.loc(), "not an object");
@@ -2006,25 +2190,25 @@ auto compiler::emit_expr_object(expr const& exp, scope& scp) -> void
 
 auto compiler::emit_expr_vector(expr_vector const& exp, scope& scp) -> void
 {
-    auto data = std::vector<std::string>{};
+    auto data = std::vector<operand>{};
     auto isexpr = false;
 
     if (exp.x->is<expr_integer>())
-        data.push_back(exp.x->as<expr_integer>().value);
+        data.push_back(operand::make_vector(std::stof(exp.x->as<expr_integer>().value)));
     else if (exp.x->is<expr_float>())
-        data.push_back(exp.x->as<expr_float>().value);
+        data.push_back(operand::make_vector(std::stof(exp.x->as<expr_float>().value)));
     else isexpr = true;
 
     if (exp.y->is<expr_integer>())
-        data.push_back(exp.y->as<expr_integer>().value);
+        data.push_back(operand::make_vector(std::stof(exp.y->as<expr_integer>().value)));
     else if (exp.y->is<expr_float>())
-        data.push_back(exp.y->as<expr_float>().value);
+        data.push_back(operand::make_vector(std::stof(exp.y->as<expr_float>().value)));
     else isexpr = true;
 
     if (exp.z->is<expr_integer>())
-        data.push_back(exp.z->as<expr_integer>().value);
+        data.push_back(operand::make_vector(std::stof(exp.z->as<expr_integer>().value)));
     else if (exp.z->is<expr_float>())
-        data.push_back(exp.z->as<expr_float>().value);
+        data.push_back(operand::make_vector(std::stof(exp.z->as<expr_float>().value)));
     else isexpr = true;
 
     if (!isexpr)
@@ -2097,7 +2281,7 @@ auto compiler::emit_expr_string(expr_string const& exp) -> void
 
 auto compiler::emit_expr_float(expr_float const& exp) -> void
 {
-    emit_opcode(opcode::OP_GetFloat, exp.value);
+    emit_opcode(opcode::OP_GetFloat, operand::make_float(std::stof(exp.value)));
 }
 
 auto compiler::emit_expr_integer(expr_integer const& exp) -> void
@@ -2110,19 +2294,19 @@ auto compiler::emit_expr_integer(expr_integer const& exp) -> void
     }
     else if (value > 0 && value < 256)
     {
-        emit_opcode(opcode::OP_GetByte, exp.value);
+        emit_opcode(opcode::OP_GetByte, operand::make_int(value));
     }
     else if (value < 0 && value > -256)
     {
-        emit_opcode(opcode::OP_GetNegByte, exp.value.substr(1));
+        emit_opcode(opcode::OP_GetNegByte, operand::make_int(-value));
     }
     else if (value > 0 && value < 65536)
     {
-        emit_opcode(opcode::OP_GetUnsignedShort, exp.value);
+        emit_opcode(opcode::OP_GetUnsignedShort, operand::make_int(value));
     }
     else if (value < 0 && value > -65536)
     {
-        emit_opcode(opcode::OP_GetNegUnsignedShort, exp.value.substr(1));
+        emit_opcode(opcode::OP_GetNegUnsignedShort, operand::make_int(-value));
     }
     else
     {
@@ -2130,20 +2314,20 @@ auto compiler::emit_expr_integer(expr_integer const& exp) -> void
         {
             if (value > 0 && value < 4294967296)
             {
-                emit_opcode(opcode::OP_GetUnsignedInt, exp.value);
+                emit_opcode(opcode::OP_GetUnsignedInt, operand::make_int(value));
             }
             else if  (value < 0 && value > -4294967296)
             {
-                emit_opcode(opcode::OP_GetNegUnsignedInt, exp.value.substr(1));
+                emit_opcode(opcode::OP_GetNegUnsignedInt, operand::make_int(-value));
             }
             else
             {
-                emit_opcode(opcode::OP_GetInteger64, exp.value);
+                emit_opcode(opcode::OP_GetInteger64, operand::make_int(value));
             }
         }
         else
         {
-             emit_opcode(opcode::OP_GetInteger, exp.value);
+             emit_opcode(opcode::OP_GetInteger, operand::make_int(value));
         }
     }
 }
@@ -2155,7 +2339,7 @@ auto compiler::emit_expr_false(expr_false const&) -> void
 
 auto compiler::emit_expr_true(expr_true const&) -> void
 {
-    emit_opcode(opcode::OP_GetByte, "1");
+    emit_opcode(opcode::OP_GetByte, operand::make_int(1));
 }
 
 auto compiler::emit_create_local_vars(scope& scp) -> void
@@ -2164,7 +2348,7 @@ auto compiler::emit_create_local_vars(scope& scp) -> void
     {
         for (auto i = scp.create_count; i < scp.public_count; i++)
         {
-            emit_opcode(opcode::OP_CreateLocalVariable, (ctx_->props() & props::hash) ? scp.vars[i].name : std::format("{}", scp.vars[i].create));
+            emit_opcode(opcode::OP_CreateLocalVariable, (ctx_->props() & props::hash) ? operand{ scp.vars[i].name } : operand::make_int(scp.vars[i].create));
             scp.vars[i].init = true;
         }
 
@@ -2180,7 +2364,7 @@ auto compiler::emit_remove_local_vars(scope& scp) -> void
 
         if (count > 0)
         {
-            emit_opcode(opcode::OP_RemoveLocalVariables, std::format("{}", count));
+            emit_opcode(opcode::OP_RemoveLocalVariables, operand::make_int(count));
         }
     }
 }
@@ -2198,7 +2382,7 @@ auto compiler::emit_opcode(opcode op) -> void
     index_ += inst->size;
 }
 
-auto compiler::emit_opcode(opcode op, std::string const& data) -> void
+auto compiler::emit_opcode(opcode op, operand data) -> void
 {
     function_->instructions.push_back(instruction::make());
 
@@ -2206,13 +2390,13 @@ auto compiler::emit_opcode(opcode op, std::string const& data) -> void
     inst->opcode = op;
     inst->size = ctx_->opcode_size(op);
     inst->index = index_;
-    inst->data.push_back(data);
+    inst->data.push_back(std::move(data));
     inst->pos = debug_pos_;
 
     index_ += inst->size;
 }
 
-auto compiler::emit_opcode(opcode op, std::vector<std::string> const& data) -> void
+auto compiler::emit_opcode(opcode op, std::vector<operand> data) -> void
 {
     function_->instructions.push_back(instruction::make());
 
@@ -2220,7 +2404,7 @@ auto compiler::emit_opcode(opcode op, std::vector<std::string> const& data) -> v
     inst->opcode = op;
     inst->size = ctx_->opcode_size(op);
     inst->index = index_;
-    inst->data = data;
+    inst->data = std::move(data);
     inst->pos = debug_pos_;
 
     index_ += inst->size;
@@ -2734,7 +2918,7 @@ auto compiler::variable_initialize(expr_identifier const& exp, scope& scp) -> u8
                     if (!scp.vars[j].init)
                     {
                         scp.vars[j].init = true;
-                        emit_opcode(opcode::OP_CreateLocalVariable, (ctx_->props() & props::hash) ? scp.vars[j].name : std::format("{}", scp.vars[j].create));
+                        emit_opcode(opcode::OP_CreateLocalVariable, (ctx_->props() & props::hash) ? operand{ scp.vars[j].name } : operand::make_int(scp.vars[j].create));
                     }
                 }
 
@@ -2760,7 +2944,7 @@ auto compiler::variable_create(expr_identifier const& exp, scope& scp) -> u8
         {
             if (!var.init)
             {
-                emit_opcode(opcode::OP_CreateLocalVariable, (ctx_->props() & props::hash) ? var.name : std::format("{}", var.create));
+                emit_opcode(opcode::OP_CreateLocalVariable, (ctx_->props() & props::hash) ? operand{ var.name } : operand::make_int(var.create));
                 var.init = true;
                 scp.create_count++;
             }
@@ -2803,13 +2987,10 @@ auto compiler::resolve_function_type(expr_function const& exp, std::string& path
     if (ctx_->func_exists(name) || ctx_->meth_exists(name))
         return call::type::builtin;
 
-    for (auto const& entry : localfuncs_)
-    {
-        if (entry == name)
-            return call::type::local;
-    }
+    if (localfuncs_.contains(name))
+        return call::type::local;
 
-    if (ctx_->is_includecall(name, path))
+    if (resolve_include(exp.loc(), name, path))
         return call::type::far;
 
     throw comp_error(exp.loc(), "couldn't determine function call type");
@@ -2837,18 +3018,31 @@ auto compiler::resolve_reference_type(expr_reference const& exp, std::string& pa
         return call::type::builtin;
     }
 
-    for (auto const& entry : localfuncs_)
-    {
-        if (entry == name)
-            return call::type::local;
-    }
+    if (localfuncs_.contains(name))
+        return call::type::local;
 
-    if (ctx_->is_includecall(name, path))
+    if (resolve_include(exp.loc(), name, path))
         return call::type::far;
 
     throw comp_error(exp.loc(), "couldn't determine function reference type");
 }
 
+auto compiler::resolve_include(location const& loc, std::string const& name, std::string& path) -> bool
+{
+    auto const paths = ctx_->find_includecall(name);
+
+    if (paths == nullptr)
+        return false;
+
+    if (paths->size() > 1)
+    {
+        throw comp_error(loc, std::format("function '{}' is ambiguous, defined in include files '{}' and '{}'", name, paths->at(0), paths->at(1)));
+    }
+
+    path = paths->front();
+    return true;
+}
+
 auto compiler::is_constant_condition(expr const& exp) -> bool
 {
     switch (exp.kind())
@@ -2873,59 +3067,74 @@ auto compiler::is_constant_condition(expr const& exp) -> bool
     return false;
 }
 
-auto compiler::insert_label(std::string const& name) -> void
+auto compiler::insert_label(u32 label) -> void
 {
-    auto const itr = function_->labels.find(index_);
-
-    if (itr != function_->labels.end())
+    // a label already bound here absorbs the new one, jumps are patched once in resolve_labels
+    if (auto const itr = label_index_.find(index_); itr != label_index_.end())
     {
-       for (auto& inst : function_->instructions)
-       {
-           switch (inst->opcode)
-           {
-                case opcode::OP_JumpOnFalse:
-                case opcode::OP_JumpOnTrue:
-                case opcode::OP_JumpOnFalseExpr:
-                case opcode::OP_JumpOnTrueExpr:
-                case opcode::OP_jump:
-                case opcode::OP_jumpback:
-                case opcode::OP_switch:
-                    if (inst->data[0] == name)
-                        inst->data[0] = itr->second;
-                    break;
-                case opcode::OP_endswitch:
-                default:
-                    break;
-           }
-       }
+        aliases_[label] = itr->second;
     }
     else
     {
-        function_->labels.insert({ index_, name });
+        label_index_.insert({ index_, label });
+        labels_[label] = index_;
     }
 }
 
-auto compiler::insert_label() -> std::string
+auto compiler::insert_label() -> u32
 {
-    auto const itr = function_->labels.find(index_);
-
-    if (itr != function_->labels.end())
+    if (auto const itr = label_index_.find(index_); itr != label_index_.end())
     {
-       return itr->second;
+        return itr->second;
     }
-    else
+
+    auto const label = create_label();
+    insert_label(label);
+    return label;
+}
+
+auto compiler::create_label() -> u32
+{
+    auto const label = static_cast<u32>(labels_.size());
+    labels_.push_back(0);
+    aliases_.push_back(label);
+    return label;
+}
+
+auto compiler::find_label(u32 label) -> u32
+{
+    while (aliases_[label] != label)
     {
-        label_idx_++;
-        auto name = std::format("loc_{}", label_idx_);
-        function_->labels.insert({ index_, name });
-        return name;
+        aliases_[label] = aliases_[aliases_[label]];
+        label = aliases_[label];
     }
+
+    return label;
 }
 
-auto compiler::create_label() -> std::string
+auto compiler::resolve_labels() -> void
 {
-    label_idx_++;
-    return std::format("loc_{}", label_idx_);
+    for (auto const& inst : function_->instructions)
+    {
+        for (auto& entry : inst->data)
+        {
+            if (entry.type != operand::kind::label)
+                continue;
+
+            auto const label = find_label(static_cast<u32>(entry.integer));
+            auto const itr = label_index_.find(labels_[label]);
+
+            if (itr == label_index_.end() || itr->second != label)
+                throw error(std::format("unresolved label in function {}", function_->name));
+
+            entry.integer = static_cast<i64>(labels_[label]);
+        }
+    }
+
+    for (auto const& [index, label] : label_index_)
+    {
+        function_->labels.insert({ index, std::format("loc_{:X}", index) });
+    }
 }
 
 } // namespace xsk::gsc
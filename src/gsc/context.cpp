@@ -11,17 +11,65 @@ namespace xsk::gsc
 
 extern std::array<std::pair<opcode, std::string_view>, opcode_count> const opcode_list;
 
-context::context(gsc::props props, gsc::engine engine, gsc::endian endian, gsc::system system, gsc::instance inst, u32 str_count)
-    : props_{ props }, engine_{ engine }, endian_{ endian }, system_{ system }, instance_{ inst }, str_count_{ str_count },
-      source_{ this }, assembler_{ this }, disassembler_{ this }, compiler_{ this }, decompiler_{ this }
+auto opcode_map() -> std::array<std::string_view, 256> const&
 {
-    opcode_map_.reserve(opcode_list.size());
-    opcode_map_rev_.reserve(opcode_list.size());
+    static auto const shared = []
+    {
+        auto data = std::array<std::string_view, 256>{};
 
-    for (auto const& entry : opcode_list)
+        for (auto const& entry : opcode_list)
+        {
+            data[static_cast<u8>(entry.first)] = entry.second;
+        }
+
+        return data;
+    }();
+
+    return shared;
+}
+
+auto opcode_map_rev() -> std::unordered_map<std::string_view, opcode> const&
+{
+    static auto const shared = []
+    {
+        auto data = std::unordered_map<std::string_view, opcode>{};
+        data.reserve(opcode_list.size());
+
+        for (auto const& entry : opcode_list)
+        {
+            data.insert({ entry.second, entry.first });
+        }
+
+        return data;
+    }();
+
+    return shared;
+}
+
+auto tables::add_code(u8 id, opcode op) -> void
+{
+    // keep the first id of an opcode, like the map insertion did
+    if (code_map[code_map_rev[static_cast<u8>(op)]] != op)
+    {
+        code_map_rev[static_cast<u8>(op)] = id;
+    }
+
+    code_map[id] = op;
+}
+
+context::context(gsc::props props, gsc::engine engine, gsc::endian endian, gsc::system system, gsc::instance inst, u32 str_count, gsc::tables const& tables)
+    : props_{ props }, engine_{ engine }, endian_{ endian }, system_{ system }, instance_{ inst }, str_count_{ str_count },
+      source_{ this }, assembler_{ this }, disassembler_{ this }, compiler_{ this }, decompiler_{ this }, optimizer_{ this }, tables_{ tables },
+      headers_{ std::make_shared<header_cache>() }
+{
+    for (auto i = 0u; i < decode_table_.size(); i++)
     {
-        opcode_map_.insert({ entry.first, entry.second });
-        opcode_map_rev_.insert({ entry.second, entry.first });
+        auto const op = tables_.code_map[i];
+
+        if (op != opcode::vm_invalid)
+        {
+            decode_table_[i] = { op, static_cast<u8>(instruction_size(op)) };
+        }
     }
 }
 
@@ -35,7 +83,9 @@ auto context::cleanup() -> void
 {
     header_files_.clear();
     include_cache_.clear();
+    include_funcs_.clear();
     includes_.clear();
+    dependencies_.clear();
 }
 
 auto context::engine_name() const -> std::string_view
@@ -58,6 +108,31 @@ auto context::engine_name() const -> std::string_view
 }
 
 auto context::opcode_size(opcode op) const -> usize
+{
+    auto const size = instruction_size(op);
+
+    if (size == 0)
+    {
+        throw error(std::format("couldn't resolve instruction size for '{}'", opcode_name(op)));
+    }
+
+    return size;
+}
+
+auto context::opcode_decode(u8 id) const -> decode_entry const&
+{
+    auto const& entry = decode_table_[id];
+
+    if (entry.size == 0)
+    {
+        // unknown byte or opcode without a size, report it like the lookups do
+        opcode_size(opcode_enum(id));
+    }
+
+    return entry;
+}
+
+auto context::instruction_size(opcode op) const -> usize
 {
     switch (op)
     {
@@ -279,17 +354,17 @@ auto context::opcode_size(opcode op) const -> usize
         case opcode::OP_iw9_144:
         case opcode::OP_iw9_166:
         default:
-            throw error(std::format("couldn't resolve instruction size for '{}'", opcode_name(op)));
+            return 0;
     }
 }
 
 auto context::opcode_id(opcode op) const -> u8
 {
-    auto const itr = code_map_rev_.find(op);
+    auto const id = tables_.code_map_rev[static_cast<u8>(op)];
 
-    if (itr != code_map_rev_.end())
+    if (op != opcode::vm_invalid && tables_.code_map[id] == op)
     {
-        return itr->second;
+        return id;
     }
 
     throw error(std::format("couldn't resolve opcode id for '{}'", opcode_name(op)));
@@ -297,21 +372,22 @@ auto context::opcode_id(opcode op) const -> u8
 
 auto context::opcode_name(opcode op) const -> std::string
 {
-    auto const itr = opcode_map_.find(op);
+    auto const name = opcode_map()[static_cast<u8>(op)];
 
-    if (itr != opcode_map_.end())
+    if (!name.empty())
     {
-        return std::string{ itr->second };
+        return std::string{ name };
     }
 
     throw std::runtime_error(std::format("couldn't resolve opcode string for enum '{}'", static_cast<std::underlying_type_t<opcode>>(op)));
 }
 
-auto context::opcode_enum(std::string const& name) const -> opcode
+auto context::opcode_enum(std::string_view name) const -> opcode
 {
-    auto const itr = opcode_map_rev_.find(name);
+    auto const& map = opcode_map_rev();
+    auto const itr = map.find(name);
 
-    if (itr != opcode_map_rev_.end())
+    if (itr != map.end())
     {
         return itr->second;
     }
@@ -321,11 +397,11 @@ auto context::opcode_enum(std::string const& name) const -> opcode
 
 auto context::opcode_enum(u8 id) const -> opcode
 {
-    auto const itr = code_map_.find(id);
+    auto const op = tables_.code_map[id];
 
-    if (itr != code_map_.end())
+    if (op != opcode::vm_invalid)
     {
-        return itr->second;
+        return op;
     }
 
     throw error(std::format("couldn't resolve opcode enum for '{:02X}'", id));
@@ -338,23 +414,37 @@ auto context::func_id(std::string const& name) const -> u16
         return static_cast<u16>(std::stoul(name.substr(6), nullptr, 16));
     }
 
-    auto const itr = func_map_rev_.find(name);
+    auto const itr = tables_.func_map_rev.find(name);
 
-    if (itr != func_map_rev_.end())
+    if (itr != tables_.func_map_rev.end())
     {
         return itr->second;
     }
 
+    auto const added = func_map_rev_.find(name);
+
+    if (added != func_map_rev_.end())
+    {
+        return added->second;
+    }
+
     throw error(std::format("couldn't resolve builtin function id for {}", name));
 }
 
 auto context::func_name(u16 id) const -> std::string
 {
-    auto const itr = func_map_.find(id);
+    auto const name = tables_.func_map.find(id);
 
-    if (itr != func_map_.end())
+    if (!name.empty())
     {
-        return std::string{ itr->second };
+        return std::string{ name };
+    }
+
+    auto const added = func_map_.find(id);
+
+    if (added != func_map_.end())
+    {
+        return std::string{ added->second };
     }
 
     return std::format("_func_{:04X}", id);
@@ -387,9 +477,9 @@ auto context::func2_id(std::string const& name) const -> u64
 
 auto context::func2_name(u64 id) const -> std::string
 {
-    auto const itr = func_map2_.find(id);
+    auto const itr = tables_.func_map2.find(id);
 
-    if (itr != func_map2_.end())
+    if (itr != tables_.func_map2.end())
     {
         return std::string{ itr->second };
     }
@@ -397,25 +487,31 @@ auto context::func2_name(u64 id) const -> std::string
     return std::format("_func_{:16X}", id);
 }
 
+// engine builtins together with the ones registered by func_add
+auto context::func_map() const -> std::unordered_map<std::string_view, u16>
+{
+    auto res = tables_.func_map_rev;
+    res.insert(func_map_rev_.begin(), func_map_rev_.end());
+    return res;
+}
+
 auto context::func_exists(std::string const& name) const -> bool
 {
     if (name.starts_with("_func_")) return true;
 
     if (props_ & props::hash)
     {
-        return func_map2_.contains(func2_id(name));
+        return tables_.func_map2.contains(func2_id(name));
     }
     else
     {
-        return func_map_rev_.contains(name);
+        return tables_.func_map_rev.contains(name) || func_map_rev_.contains(name);
     }
 }
 
 auto context::func_add(std::string const& name, u16 id) -> void
 {
-    auto const itr = func_map_rev_.find(name);
-
-    if (itr != func_map_rev_.end())
+    if (tables_.func_map_rev.contains(name) || func_map_rev_.contains(name))
     {
         throw error(std::format("builtin function '{}' already defined", name));
     }
@@ -446,23 +542,37 @@ auto context::meth_id(std::string const& name) const -> u16
         return static_cast<u16>(std::stoul(name.substr(6), nullptr, 16));
     }
 
-    auto const itr = meth_map_rev_.find(name);
+    auto const itr = tables_.meth_map_rev.find(name);
 
-    if (itr != meth_map_rev_.end())
+    if (itr != tables_.meth_map_rev.end())
     {
         return itr->second;
     }
 
+    auto const added = meth_map_rev_.find(name);
+
+    if (added != meth_map_rev_.end())
+    {
+        return added->second;
+    }
+
     throw error(std::format("couldn't resolve builtin method id for {}", name));
 }
 
 auto context::meth_name(u16 id) const -> std::string
 {
-    auto const itr = meth_map_.find(id);
+    auto const name = tables_.meth_map.find(id);
 
-    if (itr != meth_map_.end())
+    if (!name.empty())
     {
-        return std::string{ itr->second };
+        return std::string{ name };
+    }
+
+    auto const added = meth_map_.find(id);
+
+    if (added != meth_map_.end())
+    {
+        return std::string{ added->second };
     }
 
     return std::format("_meth_{:04X}", id);
@@ -495,9 +605,9 @@ auto context::meth2_id(std::string const& name) const -> u64
 
 auto context::meth2_name(u64 id) const -> std::string
 {
-    auto const itr = meth_map2_.find(id);
+    auto const itr = tables_.meth_map2.find(id);
 
-    if (itr != meth_map2_.end())
+    if (itr != tables_.meth_map2.end())
     {
         return std::string{ itr->second };
     }
@@ -506,25 +616,31 @@ auto context::meth2_name(u64 id) const -> std::string
 }
 
 
+// engine builtins together with the ones registered by meth_add
+auto context::meth_map() const -> std::unordered_map<std::string_view, u16>
+{
+    auto res = tables_.meth_map_rev;
+    res.insert(meth_map_rev_.begin(), meth_map_rev_.end());
+    return res;
+}
+
 auto context::meth_exists(std::string const& name) const -> bool
 {
     if (name.starts_with("_meth_")) return true;
 
     if (props_ & props::hash)
     {
-        return meth_map2_.contains(meth2_id(name));
+        return tables_.meth_map2.contains(meth2_id(name));
     }
     else
     {
-        return meth_map_rev_.contains(name);
+        return tables_.meth_map_rev.contains(name) || meth_map_rev_.contains(name);
     }
 }
 
 auto context::meth_add(std::string const& name, u16 id) -> void
 {
-    auto const itr = meth_map_rev_.find(name);
-
-    if (itr != meth_map_rev_.end())
+    if (tables_.meth_map_rev.contains(name) || meth_map_rev_.contains(name))
     {
         throw error(std::format("builtin method '{}' already defined", name));
     }
@@ -555,9 +671,9 @@ auto context::token_id(std::string const& name) const -> u32
         return static_cast<u32>(std::stoul(name.substr(4), nullptr, 16));
     }
 
-    auto const itr = token_map_rev_.find(name);
+    auto const itr = tables_.token_map_rev.find(name);
 
-    if (itr != token_map_rev_.end())
+    if (itr != tables_.token_map_rev.end())
     {
         return itr->second;
     }
@@ -567,11 +683,11 @@ auto context::token_id(std::string const& name) const -> u32
 
 auto context::token_name(u32 id) const -> std::string
 {
-    auto const itr = token_map_.find(id);
+    auto const name = tables_.token_map.find(id);
 
-    if (itr != token_map_.end())
+    if (!name.empty())
     {
-        return std::string{ itr->second };
+        return std::string{ name };
     }
 
     return std::format("_id_{:04X}", id);
@@ -608,9 +724,9 @@ auto context::path_id(std::string const& name) const -> u64
 
 auto context::path_name(u64 id) const -> std::string
 {
-    auto const itr = path_map_.find(id);
+    auto const itr = tables_.path_map.find(id);
 
-    if (itr != path_map_.end())
+    if (itr != tables_.path_map.end())
     {
         return std::string{ itr->second };
     }
@@ -645,9 +761,9 @@ auto context::hash_id(std::string const& name) const -> u64
 
 auto context::hash_name(u64 id) const -> std::string
 {
-   auto const itr = hash_map_.find(id);
+   auto const itr = tables_.hash_map.find(id);
 
-    if (itr != hash_map_.end())
+    if (itr != tables_.hash_map.end())
     {
         return std::string{ itr->second };
     }
@@ -675,6 +791,8 @@ auto context::make_token(std::string_view str) const -> std::string
 
 auto context::load_header(std::string const& name) -> std::tuple<std::string const*, char const*, usize>
 {
+    add_dependency(name);
+
     auto const itr = header_files_.find(name);
 
     if (itr != header_files_.end())
@@ -706,14 +824,19 @@ auto context::load_include(std::string const& name) -> bool
             return false;
         }
 
-        includes_.insert(name);
-
-        if (include_cache_.contains(name))
-            return true;
+        auto const path = *includes_.insert(name).first;
 
         auto filename = name;
         filename += (instance_ == gsc::instance::server) ? ".gsc" : ".csc";
 
+        add_dependency(filename);
+
+        if (auto const itr = include_cache_.find(name); itr != include_cache_.end())
+        {
+            add_includefuncs(path, itr->second);
+            return true;
+        }
+
         auto file = fs_callback_(this, filename);
 
         if ((file.first.data == nullptr || file.first.size == 0) && file.second.empty())
@@ -734,7 +857,8 @@ auto context::load_include(std::string const& name) -> bool
                 }
             }
 
-            include_cache_.insert({ name, std::move(funcs) });
+            auto const itr = include_cache_.insert({ name, std::move(funcs) }).first;
+            add_includefuncs(path, itr->second);
         }
         else
         {
@@ -748,7 +872,8 @@ auto context::load_include(std::string const& name) -> bool
                 funcs.push_back(fun->name);
             }
 
-            include_cache_.insert({ name, std::move(funcs) });
+            auto const itr = include_cache_.insert({ name, std::move(funcs) }).first;
+            add_includefuncs(path, itr->second);
         }
 
         return true;
@@ -762,23 +887,49 @@ auto context::load_include(std::string const& name) -> bool
 auto context::init_includes() -> void
 {
     includes_.clear();
+    include_funcs_.clear();
+}
+
+auto context::init_dependencies() -> void
+{
+    dependencies_.clear();
+}
+
+// drops the cached header or include read under a dependency name
+auto context::invalidate(std::string const& name) -> void
+{
+    auto const ext = (instance_ == gsc::instance::server) ? ".gsc"sv : ".csc"sv;
+
+    header_files_.erase(name);
+
+    if (name.ends_with(ext))
+        include_cache_.erase(name.substr(0, name.size() - ext.size()));
 }
 
-auto context::is_includecall(std::string const& name, std::string& path) -> bool
+auto context::add_dependency(std::string const& name) -> void
 {
-    for (auto const& inc : includes_)
+    if (std::find(dependencies_.begin(), dependencies_.end(), name) == dependencies_.end())
     {
-        for (auto const& fun : include_cache_.at(std::string{ inc }))
-        {
-            if (name == fun)
-            {
-                path = inc;
-                return true;
-            }
-        }
+        dependencies_.push_back(name);
+    }
+}
+
+auto context::add_includefuncs(std::string_view path, std::vector<std::string> const& funcs) -> void
+{
+    for (auto const& fun : funcs)
+    {
+        auto& paths = include_funcs_[fun];
+
+        if (paths.empty() || paths.back() != path)
+            paths.push_back(path);
     }
+}
 
-    return false;
+// include files defining the function, in include order
+auto context::find_includecall(std::string const& name) const -> std::vector<std::string_view> const*
+{
+    auto const itr = include_funcs_.find(name);
+    return (itr != include_funcs_.end()) ? &itr->second : nullptr;
 }
 
 extern std::array<std::pair<opcode, std::string_view>, opcode_count> const opcode_list
@@ -11,14 +11,19 @@
 namespace xsk::gsc
 {
 
-decompiler::decompiler(context const* ctx) : ctx_{ ctx }
+decompiler::decompiler(context const* ctx) : ctx_{ ctx }, log_{ &std::cout }
 {
 }
 
 auto decompiler::decompile(assembly const& data) -> program::ptr
 {
+    // leftovers of a failed run point into the previous program's arena
+    func_.reset();
+    stack_ = {};
     program_ = program::make();
 
+    auto scope = node_arena{ program_->nodes };
+
     for (auto const& func : data.functions)
     {
         decompile_function(*func);
@@ -27,14 +32,95 @@ auto decompiler::decompile(assembly const& data) -> program::ptr
     return std::move(program_);
 }
 
+// functions only share the read-only context, each worker builds them in its own arena
+auto decompiler::decompile(assembly const& data, utils::thread_pool& pool) -> program::ptr
+{
+    if (pool.size() < 2 || data.functions.size() < 2)
+        return decompile(data);
+
+    struct unit
+    {
+        std::vector<decl::ptr> decls;
+        std::ostringstream log;
+        std::exception_ptr error;
+    };
+
+    func_.reset();
+    stack_ = {};
+    program_ = program::make();
+
+    while (workers_.size() < pool.size())
+    {
+        workers_.push_back(std::make_unique<decompiler>(ctx_));
+    }
+
+    for (auto& worker : workers_)
+    {
+        worker->program_ = program::make();
+    }
+
+    auto units = std::vector<unit>(data.functions.size());
+
+    pool.run(units.size(), [&](usize index, usize worker)
+    {
+        auto& self = *workers_[worker];
+        auto& entry = units[index];
+        auto scope = node_arena{ self.program_->nodes };
+
+        self.log_ = &entry.log;
+
+        try
+        {
+            self.decompile_function(*data.functions[index]);
+        }
+        catch (...)
+        {
+            entry.error = std::current_exception();
+        }
+
+        entry.decls = std::move(self.program_->declarations);
+        self.program_->declarations.clear();
+        self.log_ = &std::cout;
+    });
+
+    for (auto& worker : workers_)
+    {
+        worker->func_.reset();
+        worker->stack_ = {};
+        program_->nodes.merge(std::move(worker->program_->nodes));
+        worker->program_.reset();
+    }
+
+    // stitched in script order, warnings and the first error come out as a serial run would
+    for (auto& entry : units)
+    {
+        std::cout << entry.log.str();
+
+        if (entry.error)
+            std::rethrow_exception(entry.error);
+
+        for (auto& dec : entry.decls)
+        {
+            program_->declarations.push_back(std::move(dec));
+        }
+    }
+
+    return std::move(program_);
+}
+
 auto decompiler::decompile_function(function const& func) -> void
 {
     expr_labels_.clear();
     tern_labels_.clear();
     in_waittill_ = false;
-    labels_ = func.labels;
+    labels_.clear();
+
+    for (auto const& [offset, name] : func.labels)
+        labels_.insert(offset);
+
     locs_ = {};
     stack_ = {};
+    flow_.build(func);
 
     auto loc = location{ nullptr, static_cast<i32>(func.index) };
     auto name = expr_identifier::make(loc, func.name);
@@ -49,7 +135,7 @@ auto decompiler::decompile_function(function const& func) -> void
 
     if (!stack_.empty())
     {
-        std::cout << std::format("[WRN]: orphan stack data at function {}\n", func.name);
+        *log_ << std::format("[WRN]: orphan stack data at function {}\n", func.name);
         //throw decomp_error("stack isn't empty at function end");
     }
 
@@ -93,37 +179,37 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         case opcode::OP_GetInteger:
         case opcode::OP_GetInteger64:
         {
-            stack_.push(expr_integer::make(loc, inst.data[0]));
+            stack_.push(expr_integer::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_GetNegByte:
         case opcode::OP_GetNegUnsignedShort:
         case opcode::OP_GetNegUnsignedInt:
         {
-            stack_.push(expr_integer::make(loc, "-" + inst.data[0]));
+            stack_.push(expr_integer::make(loc, "-" + inst.data[0].to_string()));
             break;
         }
         case opcode::OP_GetFloat:
         {
-            stack_.push(expr_float::make(loc, inst.data[0]));
+            stack_.push(expr_float::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_GetVector:
         {
-            auto x = expr_float::make(loc, inst.data[0]);
-            auto y = expr_float::make(loc, inst.data[1]);
-            auto z = expr_float::make(loc, inst.data[2]);
+            auto x = expr_float::make(loc, inst.data[0].to_string());
+            auto y = expr_float::make(loc, inst.data[1].to_string());
+            auto z = expr_float::make(loc, inst.data[2].to_string());
             stack_.push(expr_vector::make(loc, std::move(x), std::move(y), std::move(z)));
             break;
         }
         case opcode::OP_GetString:
         {
-            stack_.push(expr_string::make(loc, inst.data[0]));
+            stack_.push(expr_string::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_GetIString:
         {
-            stack_.push(expr_istring::make(loc, inst.data[0]));
+            stack_.push(expr_istring::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_GetUndefined:
@@ -162,20 +248,20 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         }
         case opcode::OP_GetAnimation:
         {
-            if (!inst.data[0].empty())
+            if (!inst.data[0].text.empty())
             {
-                auto dec = decl_usingtree::make(loc, expr_string::make(loc, inst.data[0]));
+                auto dec = decl_usingtree::make(loc, expr_string::make(loc, inst.data[0].to_string()));
                 program_->declarations.push_back(std::move(dec));
             }
 
-            stack_.push(expr_animation::make(loc, inst.data[1]));
+            stack_.push(expr_animation::make(loc, inst.data[1].to_string()));
             break;
         }
         case opcode::OP_GetAnimTree:
         {
-            if (!inst.data[0].empty())
+            if (!inst.data[0].text.empty())
             {
-                auto dec = decl_usingtree::make(loc, expr_string::make(loc, inst.data[0]));
+                auto dec = decl_usingtree::make(loc, expr_string::make(loc, inst.data[0].to_string()));
                 program_->declarations.push_back(std::move(dec));
             }
 
@@ -191,21 +277,21 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         case opcode::OP_GetBuiltinMethod:
         {
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_reference::make(loc, std::move(path), std::move(name)));
             break;
         }
         case opcode::OP_GetLocalFunction:
         {
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_reference::make(loc, std::move(path), std::move(name)));
             break;
         }
         case opcode::OP_GetFarFunction:
         {
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
             stack_.push(expr_reference::make(loc, std::move(path), std::move(name)));
             break;
         }
@@ -213,17 +299,17 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             if (in_waittill_)
             {
-                stack_.push(expr_var_create::make(loc, inst.data[0]));
+                stack_.push(expr_var_create::make(loc, inst.data[0].to_string()));
             }
             else
             {
-                func_->body->block->list.push_back(stmt_create::make(loc, inst.data[0]));
+                func_->body->block->list.push_back(stmt_create::make(loc, inst.data[0].to_string()));
             }
             break;
         }
         case opcode::OP_RemoveLocalVariables:
         {
-            func_->body->block->list.push_back(stmt_remove::make(loc, inst.data[0]));
+            func_->body->block->list.push_back(stmt_remove::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_EvalLocalVariableCached0:
@@ -258,13 +344,13 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         }
         case opcode::OP_EvalLocalVariableCached:
         {
-            stack_.push(expr_var_access::make(loc, inst.data[0]));
+            stack_.push(expr_var_access::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_EvalLocalArrayCached:
         {
             auto key = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            auto obj = expr_var_access::make(loc, inst.data[0]);
+            auto obj = expr_var_access::make(loc, inst.data[0].to_string());
             stack_.push(expr_array::make(key->loc(), std::move(obj), std::move(key)));
             break;
         }
@@ -278,7 +364,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         case opcode::OP_EvalNewLocalArrayRefCached0:
         {
             auto key = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            auto obj = expr_var_create::make(loc, inst.data[0]);
+            auto obj = expr_var_create::make(loc, inst.data[0].to_string());
             stack_.push(expr_array::make(key->loc(), std::move(obj), std::move(key)));
             break;
         }
@@ -292,7 +378,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         case opcode::OP_EvalLocalArrayRefCached:
         {
             auto key = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            auto obj = expr_var_access::make(loc, inst.data[0]);
+            auto obj = expr_var_access::make(loc, inst.data[0].to_string());
             stack_.push(expr_array::make(key->loc(), std::move(obj), std::move(key)));
             break;
         }
@@ -345,7 +431,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_call::make(loc, expr_function::make(loc, std::move(path), std::move(name), std::move(args), call::mode::normal)));
             break;
         }
@@ -353,7 +439,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             auto var = std::move(stack_.top()); stack_.pop();
             loc = var->loc();
@@ -375,7 +461,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
 
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             auto var = std::move(stack_.top()); stack_.pop();
             loc = var->loc();
@@ -394,9 +480,9 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
-            for (auto i = std::stoul(inst.data[1]); i > 0; i--)
+            for (auto i = inst.data[1].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -410,9 +496,9 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
-            for (auto i = std::stoul(inst.data[1]); i > 0; i--)
+            for (auto i = inst.data[1].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -429,9 +515,9 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
 
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
-            for (auto i = std::stoul(inst.data[1]); i > 0; i--)
+            for (auto i = inst.data[1].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -448,9 +534,9 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
 
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
-            for (auto i = std::stoul(inst.data[1]); i > 0; i--)
+            for (auto i = inst.data[1].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -463,16 +549,16 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         case opcode::OP_ScriptFarFunctionCall2:
         {
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
             stack_.push(expr_call::make(loc, expr_function::make(loc, std::move(path), std::move(name), std::move(args), call::mode::normal)));
             break;
         }
         case opcode::OP_ScriptFarFunctionCall:
         {
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
             auto var = std::move(stack_.top()); stack_.pop();
             loc = var->loc();
@@ -493,8 +579,8 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             loc = obj->loc();
 
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
             auto var = std::move(stack_.top()); stack_.pop();
             loc = var->loc();
@@ -512,10 +598,10 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         case opcode::OP_ScriptFarThreadCall:
         {
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
-            for (auto i = std::stoul(inst.data[2]); i > 0; i--)
+            for (auto i = inst.data[2].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -528,10 +614,10 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         case opcode::OP_ScriptFarChildThreadCall:
         {
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
-            for (auto i = std::stoul(inst.data[2]); i > 0; i--)
+            for (auto i = inst.data[2].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -547,10 +633,10 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             loc = obj->loc();
 
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
-            for (auto i = std::stoul(inst.data[2]); i > 0; i--)
+            for (auto i = inst.data[2].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -566,10 +652,10 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             loc = obj->loc();
 
             auto args = expr_arguments::make(loc);
-            auto path = expr_path::make(loc, inst.data[0]);
-            auto name = expr_identifier::make(loc, inst.data[1]);
+            auto path = expr_path::make(loc, inst.data[0].to_string());
+            auto name = expr_identifier::make(loc, inst.data[1].to_string());
 
-            for (auto i = std::stoul(inst.data[2]); i > 0; i--)
+            for (auto i = inst.data[2].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -620,7 +706,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto func = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = func->loc();
 
-            for (auto i = std::stoul(inst.data[0]); i > 0; i--)
+            for (auto i = inst.data[0].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -636,7 +722,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto func = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = func->loc();
 
-            for (auto i = std::stoul(inst.data[0]); i > 0; i--)
+            for (auto i = inst.data[0].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -653,7 +739,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = obj->loc();
 
-            for (auto i = std::stoul(inst.data[0]); i > 0; i--)
+            for (auto i = inst.data[0].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -670,7 +756,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = obj->loc();
 
-            for (auto i = std::stoul(inst.data[0]); i > 0; i--)
+            for (auto i = inst.data[0].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -686,7 +772,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto func = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = func->loc();
 
-            for (auto i = std::stoul(inst.data[0]); i > 0; i--)
+            for (auto i = inst.data[0].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -703,7 +789,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = obj->loc();
 
-            for (auto i = std::stoul(inst.data[0]); i > 0; i--)
+            for (auto i = inst.data[0].as_int(); i > 0; i--)
             {
                 auto var = std::move(stack_.top()); stack_.pop();
                 loc = var->loc();
@@ -717,7 +803,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_call::make(loc, expr_function::make(loc, std::move(path), std::move(name), std::move(args), call::mode::builtin)));
             break;
         }
@@ -725,7 +811,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             for (auto i = 1u; i > 0; i--)
             {
@@ -741,7 +827,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             for (auto i = 2u; i > 0; i--)
             {
@@ -757,7 +843,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             for (auto i = 3u; i > 0; i--)
             {
@@ -773,7 +859,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             for (auto i = 4u; i > 0; i--)
             {
@@ -789,7 +875,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             for (auto i = 5u; i > 0; i--)
             {
@@ -805,9 +891,9 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
-            for (auto i = std::stoul(inst.data[1]); i > 0; i--)
+            for (auto i = inst.data[1].as_int(); i > 0; i--)
             {
                 auto var = node::as<expr>(std::move(stack_.top())); stack_.pop();
                 loc = var->loc();
@@ -823,7 +909,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             loc = obj->loc();
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_method::make(loc, std::move(obj), expr_function::make(loc, std::move(path), std::move(name), std::move(args), call::mode::builtin)));
             break;
         }
@@ -832,7 +918,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             for (auto i = 1u; i > 0; i--)
             {
@@ -849,7 +935,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             for (auto i = 2u; i > 0; i--)
             {
@@ -866,7 +952,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             for (auto i = 3u; i > 0; i--)
             {
@@ -883,7 +969,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             for (auto i = 4u; i > 0; i--)
             {
@@ -900,7 +986,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
             for (auto i = 5u; i > 0; i--)
             {
@@ -918,9 +1004,9 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             loc = obj->loc();
             auto args = expr_arguments::make(loc);
             auto path = expr_path::make(loc);
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
 
-            for (auto i = std::stoul(inst.data[1]); i > 0; i--)
+            for (auto i = inst.data[1].as_int(); i > 0; i--)
             {
                 auto var = node::as<expr>(std::move(stack_.top())); stack_.pop();
                 loc = var->loc();
@@ -1092,7 +1178,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto event = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = event->loc();
 
-            for (auto i = std::stoul(inst.data[0]); i > 0; i--)
+            for (auto i = inst.data[0].as_int(); i > 0; i--)
             {
                 auto arg = node::as<expr>(std::move(stack_.top())); stack_.pop();
                 loc = arg->loc();
@@ -1173,56 +1259,56 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         case opcode::OP_EvalLevelFieldVariable:
         {
             auto obj = expr_level::make(loc);
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(loc, std::move(obj), std::move(field)));
             break;
         }
         case opcode::OP_EvalAnimFieldVariable:
         {
             auto obj = expr_anim::make(loc);
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(loc, std::move(obj), std::move(field)));
             break;
         }
         case opcode::OP_EvalSelfFieldVariable:
         {
             auto obj = expr_self::make(loc);
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(loc, std::move(obj), std::move(field)));
             break;
         }
         case opcode::OP_EvalFieldVariable:
         {
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(obj->loc(), std::move(obj), std::move(field)));
             break;
         }
         case opcode::OP_EvalLevelFieldVariableRef:
         {
             auto obj = expr_level::make(loc);
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(loc, std::move(obj), std::move(field)));
             break;
         }
         case opcode::OP_EvalAnimFieldVariableRef:
         {
             auto obj = expr_anim::make(loc);
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(loc, std::move(obj), std::move(field)));
             break;
         }
         case opcode::OP_EvalSelfFieldVariableRef:
         {
             auto obj = expr_self::make(loc);
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(loc, std::move(obj), std::move(field)));
             break;
         }
         case opcode::OP_EvalFieldVariableRef:
         {
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             stack_.push(expr_field::make(obj->loc(), std::move(obj), std::move(field)));
             break;
         }
@@ -1230,7 +1316,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             auto obj = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = obj->loc();
-            auto name = expr_identifier::make(loc, inst.data[0]);
+            auto name = expr_identifier::make(loc, inst.data[0].to_string());
             auto field = expr_field::make(loc, std::move(obj), std::move(name));
             auto undef = expr_undefined::make(loc);
             auto exp = expr_assign::make(loc, std::move(field), std::move(undef), expr_assign::op::eq);
@@ -1239,7 +1325,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         }
         case opcode::OP_SafeCreateVariableFieldCached:
         {
-            auto name = (ctx_->props() & props::hash) ? inst.data[0] : std::format("var_{}", inst.data[0]);
+            auto name = (ctx_->props() & props::hash) ? inst.data[0].to_string() : std::format("var_{}", inst.data[0].as_int());
             func_->params->list.push_back(expr_identifier::make(loc, name));
             break;
         }
@@ -1247,7 +1333,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         {
             if (stack_.top()->kind() != node::expr_var_create)
             {
-                stack_.push(expr_var_access::make(loc, inst.data[0]));
+                stack_.push(expr_var_access::make(loc, inst.data[0].to_string()));
             }
             break;
         }
@@ -1261,7 +1347,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         }
         case opcode::OP_SafeSetVariableFieldCached:
         {
-            if (auto index = func_->params->list.size() - 1 - std::stoul(inst.data[0]); index > func_->params->list.size())
+            if (auto index = func_->params->list.size() - 1 - inst.data[0].as_int(); index > func_->params->list.size())
                 func_->params->list.push_back(expr_identifier::make(loc, "¡ERROR!"));
             else
                 func_->params->list.push_back(expr_identifier::make(loc, func_->params->list.at(index)->as<expr_identifier>().value));
@@ -1274,7 +1360,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         }
         case opcode::OP_EvalLocalVariableRefCached:
         {
-            stack_.push(expr_var_access::make(loc, inst.data[0]));
+            stack_.push(expr_var_access::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_SetLevelFieldVariableField:
@@ -1282,7 +1368,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto rvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = rvalue->loc();
             auto obj = expr_level::make(loc);
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             auto lvalue = expr_field::make(loc, std::move(obj), std::move(field));
             auto exp = expr_assign::make(loc, std::move(lvalue), std::move(rvalue), expr_assign::op::eq);
             func_->body->block->list.push_back(stmt_expr::make(loc, std::move(exp)));
@@ -1315,7 +1401,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto rvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = rvalue->loc();
             auto obj = expr_anim::make(loc);
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             auto lvalue = expr_field::make(loc, std::move(obj), std::move(field));
             auto exp = expr_assign::make(loc, std::move(lvalue), std::move(rvalue), expr_assign::op::eq);
             func_->body->block->list.push_back(stmt_expr::make(loc, std::move(exp)));
@@ -1326,7 +1412,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto rvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = rvalue->loc();
             auto obj = expr_self::make(loc);
-            auto field = expr_identifier::make(loc, inst.data[0]);
+            auto field = expr_identifier::make(loc, inst.data[0].to_string());
             auto lvalue = expr_field::make(loc, std::move(obj), std::move(field));
             auto exp = expr_assign::make(loc, std::move(lvalue), std::move(rvalue), expr_assign::op::eq);
             func_->body->block->list.push_back(stmt_expr::make(loc, std::move(exp)));
@@ -1343,7 +1429,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         }
         case opcode::OP_SetNewLocalVariableFieldCached0:
         {
-            auto lvalue = expr_var_create::make(loc, inst.data[0]);
+            auto lvalue = expr_var_create::make(loc, inst.data[0].to_string());
             auto rvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = rvalue->loc();
 
@@ -1373,7 +1459,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         }
         case opcode::OP_SetLocalVariableFieldCached:
         {
-            auto lvalue = expr_var_access::make(loc, inst.data[0]);
+            auto lvalue = expr_var_access::make(loc, inst.data[0].to_string());
             auto rvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = rvalue->loc();
             auto exp = expr_assign::make(loc, std::move(lvalue), std::move(rvalue), expr_assign::op::eq);
@@ -1382,7 +1468,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         }
         case opcode::OP_ClearLocalVariableFieldCached:
         {
-            func_->body->block->list.push_back(stmt_clear::make(loc, inst.data[0]));
+            func_->body->block->list.push_back(stmt_clear::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_ClearLocalVariableFieldCached0:
@@ -1392,7 +1478,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         }
         case opcode::OP_EvalLocalVariableObjectCached:
         {
-            stack_.push(expr_var_access::make(loc, inst.data[0]));
+            stack_.push(expr_var_access::make(loc, inst.data[0].to_string()));
             break;
         }
         case opcode::OP_BoolNot:
@@ -1410,7 +1496,7 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         case opcode::OP_switch:
         {
             auto test = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            func_->body->block->list.push_back(stmt_jmp_switch::make(test->loc(), std::move(test), inst.data[0]));
+            func_->body->block->list.push_back(stmt_jmp_switch::make(test->loc(), std::move(test), inst.data[0].as_label()));
             break;
         }
         case opcode::OP_endswitch:
@@ -1420,13 +1506,13 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         }
         case opcode::OP_jump:
         {
-            func_->body->block->list.push_back(stmt_jmp::make(loc, inst.data[0]));
-            if (stack_.size() != 0) tern_labels_.push_back(inst.data[0]);
+            func_->body->block->list.push_back(stmt_jmp::make(loc, inst.data[0].as_label()));
+            if (stack_.size() != 0) tern_labels_.push_back(inst.data[0].as_label());
             break;
         }
         case opcode::OP_jumpback:
         {
-            func_->body->block->list.push_back(stmt_jmp_back::make(loc, inst.data[0]));
+            func_->body->block->list.push_back(stmt_jmp_back::make(loc, inst.data[0].as_label()));
             break;
         }
         case opcode::OP_JumpOnTrue:
@@ -1434,36 +1520,36 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
             auto lvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             loc = lvalue->loc();
             auto test = expr_not::make(loc, std::move(lvalue));
-            func_->body->block->list.push_back(stmt_jmp_cond::make(loc, std::move(test), inst.data[0]));
+            func_->body->block->list.push_back(stmt_jmp_cond::make(loc, std::move(test), inst.data[0].as_label()));
             break;
         }
         case opcode::OP_JumpOnFalse:
         {
             auto test = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            func_->body->block->list.push_back(stmt_jmp_cond::make(test->loc(), std::move(test), inst.data[0]));
+            func_->body->block->list.push_back(stmt_jmp_cond::make(test->loc(), std::move(test), inst.data[0].as_label()));
             break;
         }
         case opcode::OP_JumpOnTrueExpr:
         {
             auto test = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            stack_.push(stmt_jmp_true::make(test->loc(), std::move(test), inst.data[0]));
-            expr_labels_.push_back(inst.data[0]);
+            stack_.push(stmt_jmp_true::make(test->loc(), std::move(test), inst.data[0].as_label()));
+            expr_labels_.push_back(inst.data[0].as_label());
             break;
         }
         case opcode::OP_JumpOnFalseExpr:
         {
             auto test = node::as<expr>(std::move(stack_.top())); stack_.pop();
-            stack_.push(stmt_jmp_false::make(test->loc(), std::move(test), inst.data[0]));
-            expr_labels_.push_back(inst.data[0]);
+            stack_.push(stmt_jmp_false::make(test->loc(), std::move(test), inst.data[0].as_label()));
+            expr_labels_.push_back(inst.data[0].as_label());
             break;
         }
         case opcode::OP_FormalParams:
         {
-            auto count = std::stoi(inst.data[0]);
+            auto count = inst.data[0].as_int();
 
             for (auto i = 1; i <= count; i++)
             {
-                auto name = (ctx_->props() & props::hash) ? inst.data[i] : std::format("var_{}", inst.data[i]);
+                auto name = (ctx_->props() & props::hash) ? inst.data[i].to_string() : std::format("var_{}", inst.data[i].as_int());
                 func_->params->list.push_back(expr_identifier::make(loc, name));
             }
             break;
@@ -1488,22 +1574,22 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
         }
         case opcode::OP_GetStatHash:
         {
-            stack_.push(expr_string::make(loc, std::format("stat_{}", inst.data[0])));
+            stack_.push(expr_string::make(loc, std::format("stat_{}", inst.data[0].to_string())));
             break;
         }
         case opcode::OP_GetUnkxHash:
         {
-            stack_.push(expr_string::make(loc, std::format("hunk_{}", inst.data[0])));
+            stack_.push(expr_string::make(loc, std::format("hunk_{}", inst.data[0].to_string())));
             break;
         }
         case opcode::OP_GetEnumHash:
         {
-            stack_.push(expr_string::make(loc, std::format("enum_{}", inst.data[0])));
+            stack_.push(expr_string::make(loc, std::format("enum_{}", inst.data[0].to_string())));
             break;
         }
         case opcode::OP_GetDvarHash:
         {
-            stack_.push(expr_string::make(loc, std::format("dvar_{}", inst.data[0])));
+            stack_.push(expr_string::make(loc, std::format("dvar_{}", inst.data[0].to_string())));
             break;
         }
         case opcode::OP_waittillmatch2:
@@ -1518,14 +1604,12 @@ auto decompiler::decompile_instruction(instruction const& inst) -> void
 
 auto decompiler::decompile_expressions(instruction const& inst) -> void
 {
-    auto const itr = labels_.find(inst.index);
-
-    if (itr == labels_.end())
+    if (!labels_.contains(inst.index))
         return;
 
-    for (auto const& exp : expr_labels_)
+    for (auto const exp : expr_labels_)
     {
-        if (exp == itr->second)
+        if (exp == inst.index)
         {
             auto rvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             auto jump = std::move(stack_.top()); stack_.pop();
@@ -1548,9 +1632,9 @@ auto decompiler::decompile_expressions(instruction const& inst) -> void
         }
     }
 
-    for (auto const& tern : tern_labels_)
+    for (auto const tern : tern_labels_)
     {
-        if (tern == itr->second)
+        if (tern == inst.index)
         {
             auto rvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
             auto lvalue = node::as<expr>(std::move(stack_.top())); stack_.pop();
@@ -1583,50 +1667,51 @@ auto decompiler::decompile_statements(stmt_list& stm) -> void
 
 auto decompiler::decompile_loops(stmt_list& stm) -> void
 {
-    if (stm.list.size() == 0)
-        return;
-
-    for (auto i = static_cast<i32>(stm.list.size() - 1); i >= 0; i--)
+    // each loop closes with a jump back to a block dominating it, the last one in the list is the outermost
+    for (auto latch = flow_.latches.rbegin(); latch != flow_.latches.rend(); latch++)
     {
-        if (stm.list.at(i)->is<stmt_jmp_back>())
-        {
-            auto break_loc = last_location_index(stm, i) ? locs_.end : stm.list.at(i + 1)->label();
-            auto start = find_location_index(stm, stm.list.at(i)->as<stmt_jmp_back>().value);
+        auto const& block = flow_.blocks[*latch];
+        auto const itr = std::ranges::lower_bound(stm.list, block.last, {}, [](auto const& entry) { return entry->label(); });
 
-            if (i > 0 && stm.list.at(i - 1)->is<stmt_jmp_cond>())
-            {
-                if (i - 1 == static_cast<i32>(start)) // condition belongs to empty loop
-                {
-                    decompile_while(stm, start, i);
-                    i = static_cast<i32>(stm.list.size());
-                    continue;
-                }
-                else if (static_cast<usize>(i) < find_location_index(stm, stm.list.at(i - 1)->as<stmt_jmp_cond>().value))
-                {
-                    decompile_dowhile(stm, i - 1, i);
-                    i = static_cast<i32>(stm.list.size());
-                    continue;
-                }
-            }
+        if (itr == stm.list.end() || (*itr)->label() != block.last || !(*itr)->is<stmt_jmp_back>())
+            continue;
 
-            if (i == static_cast<i32>(start)) // empty inf loop
-            {
-                decompile_inf(stm, start, i);
-            }
-            else if (!stm.list.at(start)->is<stmt_jmp_cond>()) // no condition
-            {
-                decompile_inf(stm, start, i);
-            }
-            else if (stm.list.at(start)->as<stmt_jmp_cond>().value != break_loc) // condition belong to other stmt
+        if (block.succs.empty() || !flow_.dominates(block.succs[0], *latch))
+            throw decomp_error(std::format("irreducible loop at 'loc_{:X}'", block.last));
+
+        auto const i = static_cast<usize>(itr - stm.list.begin());
+        auto const break_loc = last_location_index(stm, i) ? locs_.end : stm.list.at(i + 1)->label();
+        auto const start = find_location_index(stm, stm.list.at(i)->as<stmt_jmp_back>().value);
+
+        if (i > 0 && stm.list.at(i - 1)->is<stmt_jmp_cond>())
+        {
+            if (i - 1 == start) // condition belongs to empty loop
             {
-                decompile_inf(stm, start, i);
+                decompile_while(stm, start, i);
+                continue;
             }
-            else // condition belong to loop
+            else if (i < find_location_index(stm, stm.list.at(i - 1)->as<stmt_jmp_cond>().value))
             {
-                decompile_loop(stm, start, i);
+                decompile_dowhile(stm, i - 1, i);
+                continue;
             }
+        }
 
-            i = static_cast<i32>(stm.list.size());
+        if (i == start) // empty inf loop
+        {
+            decompile_inf(stm, start, i);
+        }
+        else if (!stm.list.at(start)->is<stmt_jmp_cond>()) // no condition
+        {
+            decompile_inf(stm, start, i);
+        }
+        else if (stm.list.at(start)->as<stmt_jmp_cond>().value != break_loc) // condition belong to other stmt
+        {
+            decompile_inf(stm, start, i);
+        }
+        else // condition belong to loop
+        {
+            decompile_loop(stm, start, i);
         }
     }
 }
@@ -1653,6 +1738,21 @@ auto decompiler::decompile_ifelses(stmt_list& stm) -> void
         {
             auto j = find_location_index(stm, entry->as<stmt_jmp_cond>().value) - 1;
             auto last_loc = locs_.end;
+            auto const join = find_location_join(stm, i);
+
+            // the graph settles the plain shapes, the checks below are left with the ones
+            // the bytecode can't tell apart, like a continue or return closing the scope
+            if (join == entry->as<stmt_jmp_cond>().value && !stm.list.at(j)->is<stmt_jmp>() && !stm.list.at(j)->is<stmt_return>())
+            {
+                decompile_if(stm, i, j); // both paths meet at the branch target
+                continue;
+            }
+
+            if (stm.list.at(j)->is<stmt_jmp>() && stm.list.at(j)->as<stmt_jmp>().value == join && join != entry->as<stmt_jmp_cond>().value && join != locs_.cnt && join != locs_.brk)
+            {
+                decompile_ifelse(stm, i, j); // the scope jumps over the else to where both paths meet
+                continue;
+            }
 
             if (stm.list.at(j)->is<stmt_jmp>())
             {
@@ -1731,7 +1831,7 @@ auto decompiler::decompile_ifelses(stmt_list& stm) -> void
                     }
                 }
 
-                if (locs_.brk != "" || locs_.cnt != "")
+                if (locs_.brk != locjmp::none || locs_.cnt != locjmp::none)
                 {
                     decompile_if(stm, i, j); // inside a loop cant be last
                 }
@@ -1789,7 +1889,7 @@ auto decompiler::decompile_aborts(stmt_list& stm) -> void
             }
             else
             {
-                std::cout << std::format("[WRN]: unresolved jump to '{}', maybe incomplete for loop at {}\n", jmp, func_->name->value);
+                *log_ << std::format("[WRN]: unresolved jump to 'loc_{:X}', maybe incomplete for loop at {}\n", jmp, func_->name->value);
             }
         }
     }
@@ -2255,24 +2355,24 @@ auto decompiler::decompile_foreach(stmt_list& stm, usize begin, usize end) -> vo
 auto decompiler::decompile_switch(stmt_list& stm, usize begin, usize end) -> void
 {
     auto const& data = stm.list[end]->as<stmt_jmp_endswitch>().data;
-    auto count = std::stoul(data[0]);
+    auto count = static_cast<usize>(data[0].as_int());
     auto index = 1u;
 
     for (auto i = 0u; i < count; i++)
     {
         if (data[index] == "case")
         {
-            auto type = static_cast<switch_type>(std::stoul(data[index + 1]));
-            auto pos = find_location_index(stm, data[index + 3]);
+            auto type = static_cast<switch_type>(data[index + 1].as_int());
+            auto pos = find_location_index(stm, data[index + 3].as_label());
             auto loc = stm.list[pos]->loc();
-            auto exp = (type == switch_type::integer) ? expr::ptr{ expr_integer::make(loc, data[index + 2]) } : expr::ptr{ expr_string::make(loc, data[index + 2]) };
+            auto exp = (type == switch_type::integer) ? expr::ptr{ expr_integer::make(loc, data[index + 2].to_string()) } : expr::ptr{ expr_string::make(loc, data[index + 2].to_string()) };
             while (stm.list[pos]->is<stmt_case>()) pos++;
             stm.list.insert(stm.list.begin() + pos, stmt_case::make(loc, std::move(exp), stmt_list::make(loc)));
             index += 4;
         }
         else if (data[index] == "default")
         {
-            auto pos = find_location_index(stm, data[index + 1]);
+            auto pos = find_location_index(stm, data[index + 1].as_label());
             auto loc = stm.list[pos]->loc();
             while (stm.list[pos]->is<stmt_case>()) pos++;
             stm.list.insert(stm.list.begin() + pos, stmt_default::make(loc, stmt_list::make(loc)));
@@ -2292,7 +2392,7 @@ auto decompiler::decompile_switch(stmt_list& stm, usize begin, usize end) -> voi
     auto save = locs_;
     locs_.last = false;
     locs_.brk = last_location_index(stm, end) ? locs_.end : stm.list[end + 1]->label();
-    locs_.end = (last == end) ? stm.list[begin]->as<stmt_jmp_switch>().value : std::format("loc_{:X}", stm.list[end]->as<stmt_jmp_endswitch>().loc().begin.line + 1);
+    locs_.end = (last == end) ? stm.list[begin]->as<stmt_jmp_switch>().value : stm.list[end]->as<stmt_jmp_endswitch>().label() + 1;
 
     auto loc = stm.list[begin]->loc();
     auto test = std::move(stm.list[begin]->as<stmt_jmp_switch>().test);
@@ -2354,11 +2454,24 @@ auto decompiler::decompile_switch(stmt_list& stm, usize begin, usize end) -> voi
     stm.list.insert(stm.list.begin() + begin, stmt_switch::make(loc, std::move(test), stmt_comp::make(loc, std::move(body))));
 }
 
-auto decompiler::find_location_reference(stmt_list const& stm, usize begin, usize end, std::string const& loc) -> bool
+// statements keep the offset order of the instructions they were made from
+auto decompiler::find_location_reference(stmt_list const& stm, usize begin, usize end, usize loc) -> bool
 {
-    for (auto i = begin; i < end; i++)
+    auto const target = flow_.find(loc);
+
+    if (target == nullptr)
+        return false;
+
+    for (auto const pred : target->preds)
     {
-        auto const& entry = stm.list.at(i);
+        // a jump ends its block, the statement holding it is the last one starting before it
+        auto const itr = std::ranges::upper_bound(stm.list, flow_.blocks[pred].last, {}, [](auto const& entry) { return entry->label(); });
+        auto const index = static_cast<usize>(itr - stm.list.begin());
+
+        if (index <= begin || index > end)
+            continue;
+
+        auto const& entry = stm.list[index - 1];
 
         if (entry->is<stmt_jmp_cond>() && entry->as<stmt_jmp_cond>().value == loc)
         {
@@ -2373,22 +2486,37 @@ auto decompiler::find_location_reference(stmt_list const& stm, usize begin, usiz
     return false;
 }
 
-auto decompiler::find_location_index(stmt_list const& stm, std::string const& loc) -> usize
+// the block ending in the condition jump is the last one held by its statement
+auto decompiler::find_location_join(stmt_list const& stm, usize index) -> usize
 {
-    auto index = 0u;
+    auto const target = flow_.find(stm.list[index]->as<stmt_jmp_cond>().value);
+    auto join = flowgraph::none;
 
-    if (loc == locs_.end)
-        return stm.list.size();
+    if (target == nullptr)
+        return locjmp::none;
 
-    for (auto const& entry : stm.list)
+    for (auto const pred : target->preds)
     {
-        if (entry->label() == loc)
-            return index;
+        auto const itr = std::ranges::upper_bound(stm.list, flow_.blocks[pred].last, {}, [](auto const& entry) { return entry->label(); });
 
-        index++;
+        if (static_cast<usize>(itr - stm.list.begin()) == index + 1)
+            join = flow_.blocks[pred].ipdom;
     }
 
-    throw decomp_error(std::format("location '{}' not found", loc));
+    return (join == flowgraph::none) ? locjmp::none : flow_.blocks[join].begin;
+}
+
+auto decompiler::find_location_index(stmt_list const& stm, usize loc) -> usize
+{
+    if (loc == locs_.end)
+        return stm.list.size();
+
+    auto const itr = std::ranges::lower_bound(stm.list, loc, {}, [](auto const& entry) { return entry->label(); });
+
+    if (itr != stm.list.end() && (*itr)->label() == loc)
+        return static_cast<usize>(itr - stm.list.begin());
+
+    throw decomp_error(std::format("location 'loc_{:X}' not found", loc));
 }
 
 auto decompiler::last_location_index(stmt_list const& stm, usize index) -> bool
@@ -3116,7 +3244,7 @@ auto decompiler::process_expr_var_access(expr::ptr& exp, scope& scp) -> void
 
     if (scp.vars.size() <= index)
     {
-        std::cout << std::format("[WRN]: bad variable access {} at {} \n", index, func_->name->value);
+        *log_ << std::format("[WRN]: bad variable access {} at {} \n", index, func_->name->value);
     }
     else
     {
@@ -59,8 +59,9 @@ auto disassembler::dissasemble_function(function& func) -> void
     {
         auto inst = instruction::make();
         inst->index = script_.pos();
-        inst->opcode = ctx_->opcode_enum(script_.read<u8>());
-        inst->size = ctx_->opcode_size(inst->opcode);
+        auto const& code = ctx_->opcode_decode(script_.read<u8>());
+        inst->opcode = code.op;
+        inst->size = code.size;
 
         dissasemble_instruction(*inst);
 
@@ -153,30 +154,30 @@ auto disassembler::dissasemble_instruction(instruction& inst) -> void
             break;
         case opcode::OP_GetByte:
         case opcode::OP_GetNegByte:
-            inst.data.push_back(std::format("{}", script_.read<u8>()));
+            inst.data.push_back(operand::make_int(script_.read<u8>()));
             break;
         case opcode::OP_GetUnsignedShort:
         case opcode::OP_GetNegUnsignedShort:
-            inst.data.push_back(std::format("{}", script_.read<u16>()));
+            inst.data.push_back(operand::make_int(script_.read<u16>()));
             break;
         case opcode::OP_GetUnsignedInt:
         case opcode::OP_GetNegUnsignedInt:
-            inst.data.push_back(std::format("{}", script_.read<u32>()));
+            inst.data.push_back(operand::make_int(script_.read<u32>()));
             break;
         case opcode::OP_GetInteger:
-            inst.data.push_back(std::format("{}", script_.read<i32>()));
+            inst.data.push_back(operand::make_int(script_.read<i32>()));
             break;
         case opcode::OP_GetInteger64:
-            inst.data.push_back(std::format("{}", script_.read<i64>()));
+            inst.data.push_back(operand::make_int(script_.read<i64>()));
             break;
         case opcode::OP_GetFloat:
-            inst.data.push_back(utils::string::float_string(script_.read<f32>()));
+            inst.data.push_back(operand::make_float(script_.read<f32>()));
             break;
         case opcode::OP_GetVector:
             inst.size += script_.align((ctx_->endian() == endian::little) ? 1 : 4);
-            inst.data.push_back(utils::string::float_string(script_.read<f32>(), true));
-            inst.data.push_back(utils::string::float_string(script_.read<f32>(), true));
-            inst.data.push_back(utils::string::float_string(script_.read<f32>(), true));
+            inst.data.push_back(operand::make_vector(script_.read<f32>()));
+            inst.data.push_back(operand::make_vector(script_.read<f32>()));
+            inst.data.push_back(operand::make_vector(script_.read<f32>()));
             break;
         case opcode::OP_GetString:
         case opcode::OP_GetIString:
@@ -193,15 +194,15 @@ auto disassembler::dissasemble_instruction(instruction& inst) -> void
             inst.data.push_back(decrypt_string(stack_.read_cstr()));
             break;
         case opcode::OP_GetUnkxHash: // xhash : only used on unittests
-            inst.data.push_back(std::format("{:08X}", script_.read<u32>()));
+            inst.data.push_back(operand::make_hash(script_.read<u32>(), 8));
             break;
         case opcode::OP_GetStatHash: // xhash : "kill" -> 0xEF9582D72160F199
         case opcode::OP_GetEnumHash: // xhash : "WEAPON/AMMO_SLUGS" -> 0x6AA606A18241AD16  c++ enum ??
         case opcode::OP_GetDvarHash: // xhash : #d"mapname" -> 0x687FB8F9B7A23245
-            inst.data.push_back(std::format("{:016X}", script_.read<u64>()));
+            inst.data.push_back(operand::make_hash(script_.read<u64>(), 16));
             break;
         case opcode::OP_waittillmatch:
-            inst.data.push_back(std::format("{}", script_.read<u8>()));
+            inst.data.push_back(operand::make_int(script_.read<u8>()));
             break;
         case opcode::OP_ClearLocalVariableFieldCached:
         case opcode::OP_SetLocalVariableFieldCached:
@@ -213,13 +214,13 @@ auto disassembler::dissasemble_instruction(instruction& inst) -> void
         case opcode::OP_SafeSetWaittillVariableFieldCached:
         case opcode::OP_EvalLocalVariableObjectCached:
         case opcode::OP_EvalLocalArrayCached:
-            inst.data.push_back(std::format("{}", script_.read<u8>()));
+            inst.data.push_back(operand::make_int(script_.read<u8>()));
             break;
         case opcode::OP_CreateLocalVariable:
         case opcode::OP_EvalNewLocalArrayRefCached0:
         case opcode::OP_SafeCreateVariableFieldCached:
         case opcode::OP_SetNewLocalVariableFieldCached0:
-            inst.data.push_back((ctx_->props() & props::hash) ? ctx_->hash_name(script_.read<u64>()) : std::format("{}", script_.read<u8>()));
+            inst.data.push_back((ctx_->props() & props::hash) ? operand{ ctx_->hash_name(script_.read<u64>()) } : operand::make_int(script_.read<u8>()));
             break;
         case opcode::OP_EvalSelfFieldVariable:
         case opcode::OP_SetLevelFieldVariableField:
@@ -241,7 +242,7 @@ auto disassembler::dissasemble_instruction(instruction& inst) -> void
         case opcode::OP_ScriptChildThreadCallPointer:
         case opcode::OP_ScriptMethodThreadCallPointer:
         case opcode::OP_ScriptMethodChildThreadCallPointer:
-            inst.data.push_back(std::format("{}", script_.read<u8>()));
+            inst.data.push_back(operand::make_int(script_.read<u8>()));
             break;
         case opcode::OP_GetLocalFunction:
         case opcode::OP_ScriptLocalFunctionCall2:
@@ -330,7 +331,7 @@ auto disassembler::disassemble_field(instruction& inst) -> void
     }
 
     auto temp = (ctx_->props() & props::tok4) ? stack_.read<u32>() : stack_.read<u16>();
-    inst.data.push_back(temp == 0 ? decrypt_string(stack_.read_cstr()) : std::format("{}", temp));
+    inst.data.push_back(temp == 0 ? operand{ decrypt_string(stack_.read_cstr()) } : operand::make_int(temp));
 }
 
 auto disassembler::disassemble_params(instruction& inst) -> void
@@ -338,11 +339,11 @@ auto disassembler::disassemble_params(instruction& inst) -> void
     auto count = script_.read<u8>();
 
     inst.size += (ctx_->props() & props::hash) ? count * 8 : count;
-    inst.data.push_back(std::format("{}", count));
+    inst.data.push_back(operand::make_int(count));
 
     for (auto i = 0u; i < count; i++)
     {
-        inst.data.push_back((ctx_->props() & props::hash) ? ctx_->hash_name(script_.read<u64>()) : std::format("{}", script_.read<u8>()));
+        inst.data.push_back((ctx_->props() & props::hash) ? operand{ ctx_->hash_name(script_.read<u64>()) } : operand::make_int(script_.read<u8>()));
     }
 }
 
@@ -370,7 +371,7 @@ auto disassembler::disassemble_call_far(instruction& inst, bool thread) -> void
 
     if (thread)
     {
-        inst.data.push_back(std::format("{}", script_.read<u8>()));
+        inst.data.push_back(operand::make_int(script_.read<u8>()));
     }
 }
 
@@ -383,7 +384,7 @@ auto disassembler::disassemble_call_far2(instruction& inst, bool thread) -> void
     if (file == 0)
     {
         inst.data.push_back(""s);
-        inst.data.push_back(std::format("{}", inst.index + 1 + offs));
+        inst.data.push_back(operand::make_int(inst.index + 1 + offs));
     }
     else
     {
@@ -400,7 +401,7 @@ auto disassembler::disassemble_call_far2(instruction& inst, bool thread) -> void
 
     if (thread)
     {
-        inst.data.push_back(std::format("{}", script_.read<u8>()));
+        inst.data.push_back(operand::make_int(script_.read<u8>()));
     }
 }
 
@@ -408,11 +409,11 @@ auto disassembler::disassemble_call_local(instruction& inst, bool thread) -> voi
 {
     auto offset = disassemble_offset();
 
-    inst.data.push_back(std::format("{}", inst.index + 1 + offset));
+    inst.data.push_back(operand::make_int(inst.index + 1 + offset));
 
     if (thread)
     {
-        inst.data.push_back(std::format("{}", script_.read<u8>()));
+        inst.data.push_back(operand::make_int(script_.read<u8>()));
     }
 }
 
@@ -431,7 +432,7 @@ auto disassembler::disassemble_call_builtin(instruction& inst, bool method, bool
 
     if (args)
     {
-        inst.data.push_back(std::format("{}", count));
+        inst.data.push_back(operand::make_int(count));
     }
 }
 
@@ -449,7 +450,7 @@ auto disassembler::disassemble_call_builtin2(instruction& inst, bool method, boo
 
     if (args)
     {
-        inst.data.push_back(std::format("{}", script_.read<u8>()));
+        inst.data.push_back(operand::make_int(script_.read<u8>()));
     }
 
     script_.seek(2);
@@ -460,7 +461,7 @@ auto disassembler::disassemble_jump(instruction& inst, bool expr, bool back) ->
     auto addr = inst.index + (expr ? 3 + script_.read<i16>() : back ? 3 - script_.read<u16>() : 5 + script_.read<i32>());
     auto label = std::format("loc_{:X}", addr);
 
-    inst.data.emplace_back(label);
+    inst.data.push_back(operand::make_label(label));
     func_->labels.insert({ addr, label });
 }
 
@@ -469,7 +470,7 @@ auto disassembler::disassemble_switch(instruction& inst) -> void
     auto addr = inst.index + 4 + script_.read<i32>();
     auto label = std::format("loc_{:X}", addr);
 
-    inst.data.emplace_back(label);
+    inst.data.push_back(operand::make_label(label));
     func_->labels.insert({ addr, label });
 }
 
@@ -478,7 +479,7 @@ auto disassembler::disassemble_switch_table(instruction& inst) -> void
     auto count = script_.read<u16>();
     auto index = inst.index + 3u;
 
-    inst.data.push_back(std::format("{}", count));
+    inst.data.push_back(operand::make_int(count));
 
     for (auto i = 0u; i < count; i++)
     {
@@ -498,13 +499,13 @@ auto disassembler::disassemble_switch_table(instruction& inst) -> void
             else if (type == 1)
             {
                 inst.data.push_back("case");
-                inst.data.push_back(std::format("{}", static_cast<int>(switch_type::integer)));
-                inst.data.push_back(std::format("{}", data));
+                inst.data.push_back(operand::make_int(static_cast<int>(switch_type::integer)));
+                inst.data.push_back(operand::make_int(data));
             }
             else if (type == 2)
             {
                 inst.data.push_back("case");
-                inst.data.push_back(std::format("{}", static_cast<int>(switch_type::string)));
+                inst.data.push_back(operand::make_int(static_cast<int>(switch_type::string)));
                 inst.data.push_back(stack_.read_cstr());
             }
         }
@@ -518,7 +519,7 @@ auto disassembler::disassemble_switch_table(instruction& inst) -> void
                 if (ctx_->engine() == engine::s2 && str != "\x01")
                 {
                     inst.data.push_back("case");
-                    inst.data.push_back(std::format("{}", static_cast<int>(switch_type::string)));
+                    inst.data.push_back(operand::make_int(static_cast<int>(switch_type::string)));
                     inst.data.push_back(decrypt_string(str));
                 }
                 else
@@ -529,21 +530,21 @@ auto disassembler::disassemble_switch_table(instruction& inst) -> void
             else if (data < 0x100000)
             {
                 inst.data.push_back("case");
-                inst.data.push_back(std::format("{}", static_cast<int>(switch_type::string)));
+                inst.data.push_back(operand::make_int(static_cast<int>(switch_type::string)));
                 inst.data.push_back(decrypt_string(stack_.read_cstr()));
             }
             else
             {
                 inst.data.push_back("case");
-                inst.data.push_back(std::format("{}", static_cast<int>(switch_type::integer)));
-                inst.data.push_back(std::format("{}", (data - 0x800000) & 0xFFFFFF));
+                inst.data.push_back(operand::make_int(static_cast<int>(switch_type::integer)));
+                inst.data.push_back(operand::make_int((data - 0x800000) & 0xFFFFFF));
             }
         }
 
         auto addr = index + 4 + offs;
         auto label = std::format("loc_{:X}", addr);
 
-        inst.data.emplace_back(label);
+        inst.data.push_back(operand::make_label(label));
         func_->labels.insert({ addr, label });
 
         index += size;
@@ -572,7 +573,7 @@ auto disassembler::resolve_functions() -> void
                 case opcode::OP_ScriptLocalChildThreadCall:
                 case opcode::OP_ScriptLocalMethodThreadCall:
                 case opcode::OP_ScriptLocalMethodChildThreadCall:
-                    inst->data[0] = resolve_function(inst->data[0]);
+                    inst->data[0] = resolve_function(inst->data[0].as_int());
                     break;
                 case opcode::OP_GetFarFunction:
                 case opcode::OP_ScriptFarFunctionCall:
@@ -581,8 +582,8 @@ auto disassembler::resolve_functions() -> void
                 case opcode::OP_ScriptFarChildThreadCall:
                 case opcode::OP_ScriptFarMethodThreadCall:
                 case opcode::OP_ScriptFarMethodChildThreadCall:
-                    if ((ctx_->props() & props::farcall) && inst->data[0].empty())
-                        inst->data[1] = resolve_function(inst->data[1]);
+                    if ((ctx_->props() & props::farcall) && inst->data[0].text.empty())
+                        inst->data[1] = resolve_function(inst->data[1].as_int());
                     break;
                 default:
                     break;
@@ -591,10 +592,8 @@ auto disassembler::resolve_functions() -> void
     }
 }
 
-auto disassembler::resolve_function(std::string const& index) -> std::string
+auto disassembler::resolve_function(usize addr) -> std::string
 {
-    auto addr = static_cast<usize>(std::stoul(index));
-
     for (auto const& func : assembly_->functions)
     {
         if (func->index == addr)
@@ -603,7 +602,7 @@ auto disassembler::resolve_function(std::string const& index) -> std::string
         }
     }
 
-    throw disasm_error(std::format("couldn't resolve function name at index 0x{}", index));
+    throw disasm_error(std::format("couldn't resolve function name at index 0x{}", addr));
 }
 
 auto disassembler::decrypt_string(std::string const& str) -> std::string
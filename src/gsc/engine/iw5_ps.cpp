@@ -13,40 +13,47 @@ extern std::array<std::pair<u16, char const*>, func_count> const func_list;
 extern std::array<std::pair<u16, char const*>, meth_count> const meth_list;
 extern std::array<std::pair<u32, char const*>, token_count> const token_list;
 
-context::context(gsc::instance inst) : gsc::context(props::none, engine::iw5, endian::big, system::ps3, inst, max_string_id)
+auto tables() -> gsc::tables const&
 {
-    code_map_.reserve(code_list.size());
-    code_map_rev_.reserve(code_list.size());
-    func_map_.reserve(func_list.size());
-    func_map_rev_.reserve(func_list.size());
-    meth_map_.reserve(meth_list.size());
-    meth_map_rev_.reserve(meth_list.size());
-    token_map_.reserve(token_list.size());
-    token_map_rev_.reserve(token_list.size());
-
-    for (auto const& entry : code_list)
+    static auto const shared = []
     {
-        code_map_.insert({ entry.first, entry.second });
-        code_map_rev_.insert({ entry.second, entry.first });
-    }
-
-    for (auto const& entry : func_list)
-    {
-        func_map_.insert({ entry.first, entry.second });
-        func_map_rev_.insert({ entry.second, entry.first });
-    }
-
-    for (auto const& entry : meth_list)
-    {
-        meth_map_.insert({ entry.first, entry.second });
-        meth_map_rev_.insert({ entry.second, entry.first });
-    }
+        auto data = gsc::tables{};
+
+        data.func_map = gsc::name_table{ func_list };
+        data.meth_map = gsc::name_table{ meth_list };
+        data.token_map = gsc::name_table{ token_list };
+        data.func_map_rev.reserve(func_list.size());
+        data.meth_map_rev.reserve(meth_list.size());
+        data.token_map_rev.reserve(token_list.size());
+
+        for (auto const& entry : code_list)
+        {
+            data.add_code(entry.first, entry.second);
+        }
+
+        for (auto const& entry : func_list)
+        {
+            data.func_map_rev.insert({ entry.second, entry.first });
+        }
+
+        for (auto const& entry : meth_list)
+        {
+            data.meth_map_rev.insert({ entry.second, entry.first });
+        }
+
+        for (auto const& entry : token_list)
+        {
+            data.token_map_rev.insert({ entry.second, entry.first });
+        }
+
+        return data;
+    }();
+
+    return shared;
+}
 
-    for (auto const& entry : token_list)
-    {
-        token_map_.insert({ entry.first, entry.second });
-        token_map_rev_.insert({ entry.second, entry.first });
-    }
+context::context(gsc::instance inst) : gsc::context(props::none, engine::iw5, endian::big, system::ps3, inst, max_string_id, tables())
+{
 }
 
 } // namespace xsk::gsc::iw5_ps
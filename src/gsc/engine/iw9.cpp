@@ -14,41 +14,51 @@ extern std::array<std::pair<u64, char const*>, meth_count> const meth_list;
 extern std::array<std::pair<u64, char const*>, path_count> const path_list;
 extern std::array<std::pair<u64, char const*>, hash_count> const hash_list;
 
-context::context(gsc::instance inst) : gsc::context(props::str4| props::waitframe | props::params | props::boolfuncs | props::boolnotand | props::hash | props::farcall | props::foreach,
-    engine::iw9, endian::little, system::pc, inst, 0)
+auto tables() -> gsc::tables const&
 {
-    code_map_.reserve(code_list.size());
-    code_map_rev_.reserve(code_list.size());
-    func_map2_.reserve(func_list.size());
-    meth_map2_.reserve(meth_list.size());
-    path_map_.reserve(path_list.size());
-    hash_map_.reserve(hash_list.size());
-
-    for (auto const& entry : code_list)
+    static auto const shared = []
     {
-        code_map_.insert({ entry.first, entry.second });
-        code_map_rev_.insert({ entry.second, entry.first });
-    }
+        auto data = gsc::tables{};
 
-    for (auto const& entry : func_list)
-    {
-        func_map2_.insert({ entry.first, entry.second });
-    }
+        data.func_map2.reserve(func_list.size());
+        data.meth_map2.reserve(meth_list.size());
+        data.path_map.reserve(path_list.size());
+        data.hash_map.reserve(hash_list.size());
 
-    for (auto const& entry : meth_list)
-    {
-        meth_map2_.insert({ entry.first, entry.second });
-    }
+        for (auto const& entry : code_list)
+        {
+            data.add_code(entry.first, entry.second);
+        }
 
-    for (auto const& entry : path_list)
-    {
-        path_map_.insert({ entry.first, entry.second });
-    }
+        for (auto const& entry : func_list)
+        {
+            data.func_map2.insert({ entry.first, entry.second });
+        }
 
-    for (auto const& entry : hash_list)
-    {
-        hash_map_.insert({ entry.first, entry.second });
-    }
+        for (auto const& entry : meth_list)
+        {
+            data.meth_map2.insert({ entry.first, entry.second });
+        }
+
+        for (auto const& entry : path_list)
+        {
+            data.path_map.insert({ entry.first, entry.second });
+        }
+
+        for (auto const& entry : hash_list)
+        {
+            data.hash_map.insert({ entry.first, entry.second });
+        }
+
+        return data;
+    }();
+
+    return shared;
+}
+
+context::context(gsc::instance inst) : gsc::context(props::str4| props::waitframe | props::params | props::boolfuncs | props::boolnotand | props::hash | props::farcall | props::foreach,
+    engine::iw9, endian::little, system::pc, inst, 0, tables())
+{
 }
 
 } // namespace xsk::gsc::iw9
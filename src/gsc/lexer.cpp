@@ -4,6 +4,7 @@
 // that can be found in the LICENSE file.
 
 #include "xsk/stdinc.hpp"
+#include "xsk/utils/scan.hpp"
 #include "xsk/utils/string.hpp"
 #include "xsk/gsc/lexer.hpp"
 #include "xsk/gsc/context.hpp"
@@ -11,7 +12,7 @@
 namespace xsk::gsc
 {
 
-lexer::lexer(context const* ctx, std::string const& name, char const* data, usize size) : ctx_{ ctx }, reader_{ data, size }, loc_{ &name }, buflen_{ 0 }, spacing_{ spacing::null }, indev_{ false }
+lexer::lexer(context const* ctx, utils::arena& arena, std::string const& name, char const* data, usize size) : ctx_{ ctx }, arena_{ &arena }, reader_{ data, size }, loc_{ &name }, buflen_{ 0 }, spacing_{ spacing::null }, indev_{ false }
 {
 }
 
@@ -48,12 +49,20 @@ auto lexer::lex() -> token
         else
             spacing_ = spacing::none;
 
+        auto begin = reader_.buffer_pos;
         advance();
 
         switch (last)
         {
             case ' ':
             case '\t':
+                while (curr == ' ' || curr == '\t')
+                {
+                    loc_.step();
+                    spacing_ = (last == ' ' || last == '\t') ? ((spacing_ == spacing::null) ? spacing::empty : spacing::back) : spacing::none;
+                    advance();
+                }
+                [[fallthrough]];
             case '\r':
                 loc_.step();
                 continue;
@@ -104,6 +113,7 @@ auto lexer::lex() -> token
 
                             advance();
                             first = false;
+                            skip_comment('#');
                         }
                     }
                 }
@@ -129,6 +139,7 @@ auto lexer::lex() -> token
 
                         advance();
                         first = false;
+                        skip_comment('@');
                     }
                 }
                 else if (last == '*')
@@ -153,12 +164,16 @@ auto lexer::lex() -> token
 
                         advance();
                         first = false;
+                        skip_comment('*');
                     }
                 }
                 else if (last == '/')
                 {
                     while (true)
                     {
+                        if (auto const count = utils::scan::span(reader_.buffer_pos, reader_.available, '\n', '\\'); count != 0)
+                            skip(count, count);
+
                         if (reader_.ended())
                             break;
 
@@ -340,15 +355,29 @@ auto lexer::lex() -> token
         }
 
 lex_string:
+        begin = reader_.buffer_pos;
+
         while (true)
         {
+            if (auto const count = utils::scan::span(reader_.buffer_pos, reader_.available, '"', '\n', '\\'); count != 0)
+            {
+                if (buflen_ + count > 0x1000)
+                    throw error("lexer: max literal size exceeded");
+
+                std::memcpy(&buffer_[buflen_], reader_.buffer_pos, count);
+                buflen_ += count;
+                skip(count, count);
+                continue;
+            }
+
             if (reader_.ended())
                 throw comp_error(loc_, "unmatched string start ('\"')");
 
             if (curr == '"')
             {
+                auto const str = data(begin);
                 advance();
-                break;
+                return token{ localize ? token::ISTRING : token::STRING, spacing_, loc_, str };
             }
 
             if (curr == '\n')
@@ -380,11 +409,6 @@ lex_string:
             advance();
         }
 
-        if (localize)
-            return token{ token::ISTRING, spacing_, loc_, std::string{ &buffer_[0], buflen_ } };
-
-        return token{ token::STRING, spacing_, loc_, std::string{ &buffer_[0], buflen_ } };
-
 lex_name:
         push(last);
 
@@ -415,10 +439,10 @@ lex_name:
             if (buffer_[buflen_ - 1] == '/')
                 throw comp_error(loc_, "invalid path end '\\'");
 
-            return token{ token::PATH, spacing_, loc_, ctx_->make_token(std::string_view{ &buffer_[0], buflen_ }) };
+            return token{ token::PATH, spacing_, loc_, arena_->store(ctx_->make_token(std::string_view{ &buffer_[0], buflen_ })) };
         }
 
-        return token{ token::NAME, spacing_, loc_, std::string{ &buffer_[0], buflen_ } };
+        return token{ token::NAME, spacing_, loc_, data(begin) };
 
 lex_number:
         if (last == '.' || last != '0' || (last == '0' && (curr != 'o' && curr != 'b' && curr != 'x')))
@@ -463,9 +487,9 @@ lex_number:
                 throw comp_error(loc_, "invalid number literal");
 
             if (dot || flt)
-                return token{ token::FLT, spacing_, loc_, std::string{ &buffer_[0], buflen_ } };
+                return token{ token::FLT, spacing_, loc_, data(begin) };
 
-            return token{ token::INT, spacing_, loc_, std::string{ &buffer_[0], buflen_ } };
+            return token{ token::INT, spacing_, loc_, data(begin) };
         }
         else if (curr == 'o')
         {
@@ -497,7 +521,7 @@ lex_number:
 
             push('\0');
 
-            return token{ token::INT, spacing_, loc_, utils::string::oct_to_dec(&buffer_[0]) };
+            return token{ token::INT, spacing_, loc_, arena_->store(utils::string::oct_to_dec(&buffer_[0])) };
         }
         else if (curr == 'b')
         {
@@ -531,7 +555,7 @@ lex_number:
 
             push('\0');
 
-            return token{ token::INT, spacing_, loc_, utils::string::bin_to_dec(&buffer_[0]) };
+            return token{ token::INT, spacing_, loc_, arena_->store(utils::string::bin_to_dec(&buffer_[0])) };
         }
         else if (curr == 'x')
         {
@@ -565,7 +589,7 @@ lex_number:
 
             push('\0');
 
-            return token{ token::INT, spacing_, loc_, utils::string::hex_to_dec(&buffer_[0]) };
+            return token{ token::INT, spacing_, loc_, arena_->store(utils::string::hex_to_dec(&buffer_[0])) };
         }
 
         throw error("UNEXPECTED LEXER INTERNAL ERROR");
@@ -580,6 +604,16 @@ auto lexer::push(char c) -> void
     buffer_[buflen_++] = c;
 }
 
+// escapes, digit separators and line wraps all read more bytes than they push,
+// so a literal of the same length as the bytes read is a slice of the source
+auto lexer::data(char const* begin) -> std::string_view
+{
+    if (static_cast<usize>(reader_.buffer_pos - begin) == buflen_)
+        return { begin, buflen_ };
+
+    return arena_->store({ &buffer_[0], buflen_ });
+}
+
 auto lexer::advance() -> void
 {
     reader_.advance();
@@ -589,6 +623,46 @@ auto lexer::advance() -> void
         linewrap();
 }
 
+// same as count advance() calls, the bytes skipped must not hold a '\\'
+auto lexer::skip(usize count, usize columns) -> void
+{
+    reader_.buffer_pos += count;
+    reader_.available -= count;
+    reader_.last_byte = reader_.buffer_pos[-1];
+    reader_.curr_byte = reader_.available ? *reader_.buffer_pos : 0;
+    loc_.end.column += static_cast<location::counter_type>(columns);
+
+    if (reader_.curr_byte == '\\') [[unlikely]]
+        linewrap();
+}
+
+// jumps to the next byte that may end the comment, counting the lines passed
+auto lexer::skip_comment(char end) -> void
+{
+    if (reader_.last_byte == end)
+        return;
+
+    auto const data = reader_.buffer_pos;
+    auto const count = utils::scan::span(data, reader_.available, end, '\\');
+
+    if (count == 0)
+        return;
+
+    auto const lines = utils::scan::count(data, count, '\n');
+
+    if (lines == 0)
+        return skip(count, count);
+
+    auto last = count - 1;
+
+    while (data[last] != '\n')
+        last--;
+
+    loc_.lines(static_cast<location::counter_type>(lines));
+    loc_.step();
+    skip(count, count - last);
+}
+
 auto lexer::linewrap() -> void
 {
     while (reader_.curr_byte == '\\')
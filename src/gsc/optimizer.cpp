@@ -0,0 +1,484 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/gsc/optimizer.hpp"
+#include "xsk/gsc/context.hpp"
+
+namespace xsk::gsc
+{
+
+namespace
+{
+
+// conditional jumps keep a 16 bit offset, leave room for the padding relocation may add
+constexpr auto jump_range = usize{ 0x7000 };
+
+auto is_jump(opcode op) -> bool
+{
+    switch (op)
+    {
+        case opcode::OP_jump:
+        case opcode::OP_JumpOnFalse:
+        case opcode::OP_JumpOnTrue:
+        case opcode::OP_JumpOnFalseExpr:
+        case opcode::OP_JumpOnTrueExpr:
+            return true;
+        default:
+            return false;
+    }
+}
+
+auto is_branch(opcode op) -> bool
+{
+    return op == opcode::OP_JumpOnFalse || op == opcode::OP_JumpOnTrue;
+}
+
+auto is_exit(opcode op) -> bool
+{
+    return op == opcode::OP_End || op == opcode::OP_Return;
+}
+
+auto invert(opcode op) -> opcode
+{
+    return (op == opcode::OP_JumpOnFalse) ? opcode::OP_JumpOnTrue : opcode::OP_JumpOnFalse;
+}
+
+auto set_label(operand& entry, usize dest) -> void
+{
+    entry.integer = static_cast<i64>(dest);
+    entry.text.clear();
+}
+
+} // namespace
+
+optimizer::optimizer(context const* ctx) : ctx_{ ctx }
+{
+}
+
+// returns the bytecode size before and after the pass
+auto optimizer::optimize(assembly& data) -> std::pair<usize, usize>
+{
+    auto const size = [&data]()
+    {
+        auto res = usize{ 0 };
+
+        for (auto const& func : data.functions)
+        {
+            res += func->size;
+        }
+
+        return res;
+    };
+
+    auto const before = size();
+
+    for (auto& func : data.functions)
+    {
+        optimize_function(*func);
+    }
+
+    relocate(data);
+
+    return { before, size() };
+}
+
+auto optimizer::optimize_function(function& func) -> void
+{
+    dead_.assign(func.instructions.size(), false);
+    compact(func);
+
+    auto changed = true;
+
+    while (changed)
+    {
+        changed = thread_jumps(func);
+        changed = rewrite(func) || changed;
+        compact(func);
+        changed = remove_unreachable(func) || changed;
+        compact(func);
+    }
+}
+
+auto optimizer::thread_jumps(function& func) -> bool
+{
+    auto changed = false;
+
+    for (auto& inst : func.instructions)
+    {
+        if (!is_jump(inst->opcode))
+            continue;
+
+        auto& entry = inst->data[0];
+        auto dest = entry.as_label();
+
+        for (auto itr = pos_.find(dest); itr != pos_.end(); itr = pos_.find(dest))
+        {
+            auto const& target = *func.instructions[itr->second];
+
+            if (target.opcode != opcode::OP_jump || target.data[0].as_label() <= dest || !in_range(*inst, target.data[0].as_label()))
+                break;
+
+            dest = target.data[0].as_label();
+        }
+
+        if (dest != entry.as_label())
+        {
+            set_label(entry, dest);
+            changed = true;
+        }
+
+        if (inst->opcode != opcode::OP_jump)
+            continue;
+
+        if (auto const itr = pos_.find(dest); itr != pos_.end() && is_exit(func.instructions[itr->second]->opcode))
+        {
+            inst->opcode = func.instructions[itr->second]->opcode;
+            inst->size = ctx_->opcode_size(inst->opcode);
+            inst->data.clear();
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+auto optimizer::rewrite(function& func) -> bool
+{
+    auto& code = func.instructions;
+    auto changed = false;
+
+    for (auto i = 0u; i < code.size(); i++)
+    {
+        if (dead_[i])
+            continue;
+
+        auto const j = next(func, i);
+
+        if (j == code.size())
+            break;
+
+        auto& inst = *code[i];
+        auto& succ = *code[j];
+
+        switch (inst.opcode)
+        {
+            case opcode::OP_jump:
+            {
+                if (inst.data[0].as_label() == succ.index)
+                {
+                    dead_[i] = true;
+                    changed = true;
+                }
+                break;
+            }
+            case opcode::OP_JumpOnFalse:
+            case opcode::OP_JumpOnTrue:
+            {
+                // a branch over a single jump takes the jump with the test inverted
+                auto const k = next(func, j);
+
+                if (succ.opcode == opcode::OP_jump && !referenced(succ) && k < code.size() && code[k]->index == inst.data[0].as_label() && in_range(inst, succ.data[0].as_label()))
+                {
+                    inst.opcode = invert(inst.opcode);
+                    set_label(inst.data[0], succ.data[0].as_label());
+                    dead_[j] = true;
+                    changed = true;
+                }
+                break;
+            }
+            case opcode::OP_CastBool:
+            {
+                if (is_branch(succ.opcode))
+                {
+                    dead_[i] = true;
+                    changed = true;
+                }
+                break;
+            }
+            case opcode::OP_BoolNot:
+            {
+                if (is_branch(succ.opcode) && !referenced(succ))
+                {
+                    succ.opcode = invert(succ.opcode);
+                    dead_[i] = true;
+                    changed = true;
+                }
+                break;
+            }
+            case opcode::OP_RemoveLocalVariables:
+            {
+                if (is_exit(succ.opcode))
+                {
+                    dead_[i] = true;
+                    changed = true;
+                }
+                break;
+            }
+            case opcode::OP_GetZero:
+            {
+                changed = rewrite_negate(func, i) || changed;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return changed;
+}
+
+// 0 - constant is folded into the negated constant
+auto optimizer::rewrite_negate(function& func, usize i) -> bool
+{
+    auto& code = func.instructions;
+    auto const j = next(func, i);
+    auto const k = (j < code.size()) ? next(func, j) : code.size();
+
+    if (k == code.size())
+        return false;
+
+    auto& inst = *code[i];
+    auto const& value = *code[j];
+
+    if (code[k]->opcode != opcode::OP_minus || referenced(value) || referenced(*code[k]))
+        return false;
+
+    switch (value.opcode)
+    {
+        case opcode::OP_GetZero:
+            break;
+        case opcode::OP_GetByte:
+            inst.opcode = opcode::OP_GetNegByte;
+            inst.data = value.data;
+            break;
+        case opcode::OP_GetNegByte:
+            inst.opcode = opcode::OP_GetByte;
+            inst.data = value.data;
+            break;
+        case opcode::OP_GetUnsignedShort:
+            inst.opcode = opcode::OP_GetNegUnsignedShort;
+            inst.data = value.data;
+            break;
+        case opcode::OP_GetNegUnsignedShort:
+            inst.opcode = opcode::OP_GetUnsignedShort;
+            inst.data = value.data;
+            break;
+        case opcode::OP_GetUnsignedInt:
+            inst.opcode = opcode::OP_GetNegUnsignedInt;
+            inst.data = value.data;
+            break;
+        case opcode::OP_GetNegUnsignedInt:
+            inst.opcode = opcode::OP_GetUnsignedInt;
+            inst.data = value.data;
+            break;
+        case opcode::OP_GetInteger:
+        {
+            if (value.data[0].as_int() == std::numeric_limits<i32>::min())
+                return false;
+
+            inst.opcode = opcode::OP_GetInteger;
+            inst.data = { operand::make_int(-value.data[0].as_int()) };
+            break;
+        }
+        case opcode::OP_GetFloat:
+        {
+            // 0 - 0.0 is +0.0, the negated constant would be -0.0
+            if (value.data[0].as_float() == 0.0f)
+                return false;
+
+            inst.opcode = opcode::OP_GetFloat;
+            inst.data = { operand::make_float(-value.data[0].as_float()) };
+            break;
+        }
+        default:
+            return false;
+    }
+
+    inst.size = ctx_->opcode_size(inst.opcode);
+    dead_[j] = true;
+    dead_[k] = true;
+    return true;
+}
+
+auto optimizer::remove_unreachable(function& func) -> bool
+{
+    auto graph = flowgraph{};
+    graph.build(func);
+
+    if (graph.blocks.empty())
+        return false;
+
+    auto seen = std::vector<bool>(graph.blocks.size());
+    auto work = std::vector<u32>{ 0 };
+    seen[0] = true;
+
+    while (!work.empty())
+    {
+        auto const index = work.back();
+        work.pop_back();
+
+        for (auto const succ : graph.blocks[index].succs)
+        {
+            if (!seen[succ])
+            {
+                seen[succ] = true;
+                work.push_back(succ);
+            }
+        }
+    }
+
+    auto changed = false;
+
+    for (auto i = 0u; i < graph.blocks.size(); i++)
+    {
+        if (seen[i])
+            continue;
+
+        // the closing End stays even when a return leaves it unreachable
+        for (auto p = pos_.at(graph.blocks[i].begin); p <= pos_.at(graph.blocks[i].last) && p + 1 < func.instructions.size(); p++)
+        {
+            dead_[p] = true;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+// drops dead instructions, their labels move on to the next instruction kept
+auto optimizer::compact(function& func) -> void
+{
+    auto& code = func.instructions;
+    auto moved = std::unordered_map<usize, usize>{};
+    auto dest = usize{ 0 };
+
+    for (auto i = dead_.size(); i-- > 0;)
+    {
+        if (dead_[i])
+            moved.insert({ code[i]->index, dest });
+        else
+            dest = code[i]->index;
+    }
+
+    if (!moved.empty())
+    {
+        auto kept = std::vector<instruction::ptr>{};
+        kept.reserve(code.size() - moved.size());
+
+        for (auto i = 0u; i < code.size(); i++)
+        {
+            if (!dead_[i])
+                kept.push_back(std::move(code[i]));
+        }
+
+        code = std::move(kept);
+
+        for (auto& inst : code)
+        {
+            for (auto& entry : inst->data)
+            {
+                if (entry.type != operand::kind::label)
+                    continue;
+
+                if (auto const itr = moved.find(entry.as_label()); itr != moved.end())
+                    set_label(entry, itr->second);
+            }
+        }
+    }
+
+    dead_.assign(code.size(), false);
+    pos_.clear();
+    refs_.clear();
+    func.labels.clear();
+
+    for (auto i = 0u; i < code.size(); i++)
+    {
+        pos_.insert({ code[i]->index, i });
+    }
+
+    for (auto const& inst : code)
+    {
+        for (auto const& entry : inst->data)
+        {
+            if (entry.type == operand::kind::label)
+                refs_[entry.as_label()]++;
+        }
+    }
+
+    for (auto const& [index, count] : refs_)
+    {
+        func.labels.insert({ index, std::format("loc_{:X}", index) });
+    }
+}
+
+auto optimizer::relocate(assembly& data) -> void
+{
+    if (data.functions.empty())
+        return;
+
+    auto index = data.functions.front()->index;
+
+    for (auto& func : data.functions)
+    {
+        auto offsets = std::unordered_map<usize, usize>{};
+        func->index = index;
+
+        for (auto& inst : func->instructions)
+        {
+            offsets.insert({ inst->index, index });
+            inst->index = index;
+
+            // vectors are 4 byte aligned on big endian, the padding follows the new offset
+            if (inst->opcode == opcode::OP_GetVector && ctx_->endian() == endian::big)
+            {
+                auto const base = index + 1;
+                inst->size = ctx_->opcode_size(inst->opcode) + (((base + 3) & ~usize{ 3 }) - base);
+            }
+
+            index += inst->size;
+        }
+
+        func->size = index - func->index;
+        func->labels.clear();
+
+        for (auto& inst : func->instructions)
+        {
+            for (auto& entry : inst->data)
+            {
+                if (entry.type != operand::kind::label)
+                    continue;
+
+                auto const dest = offsets.at(entry.as_label());
+                set_label(entry, dest);
+                func->labels.insert({ dest, std::format("loc_{:X}", dest) });
+            }
+        }
+    }
+}
+
+auto optimizer::next(function const& func, usize i) const -> usize
+{
+    auto j = i + 1;
+
+    while (j < func.instructions.size() && dead_[j])
+    {
+        j++;
+    }
+
+    return j;
+}
+
+auto optimizer::referenced(instruction const& inst) const -> bool
+{
+    return refs_.contains(inst.index);
+}
+
+auto optimizer::in_range(instruction const& inst, usize dest) const -> bool
+{
+    return dest > inst.index && (inst.opcode == opcode::OP_jump || dest - inst.index < jump_range);
+}
+
+} // namespace xsk::gsc
@@ -5085,9 +5085,9 @@ auto map_token(context const* ctx_, token& tok) -> parser::symbol_type
 {
     if (tok.type == token::NAME)
     {
-        tok.data = ctx_->make_token(tok.data);
+        auto name = ctx_->make_token(tok.data);
 
-        auto const it = keyword_map.find(tok.data);
+        auto const it = keyword_map.find(name);
 
         if (it != keyword_map.end())
         {
@@ -5109,7 +5109,7 @@ auto map_token(context const* ctx_, token& tok) -> parser::symbol_type
             }
         }
 
-        return parser::symbol_type(parser::token::IDENTIFIER, std::move(tok.data), tok.pos);
+        return parser::symbol_type(parser::token::IDENTIFIER, std::move(name), tok.pos);
     }
     else if (tok.type == token::PATH ||tok.type == token::STRING ||tok.type == token::ISTRING || tok.type == token::INT ||tok.type == token::FLT)
     {
@@ -5117,7 +5117,7 @@ auto map_token(context const* ctx_, token& tok) -> parser::symbol_type
 
         if (it != tok_to_parser.end())
         {
-            return parser::symbol_type(it->second, std::move(tok.data), tok.pos);
+            return parser::symbol_type(it->second, std::string{ tok.data }, tok.pos);
         }
     }
     else
@@ -10,16 +10,20 @@
 namespace xsk::gsc
 {
 
-preprocessor::preprocessor(context* ctx, std::string const& name, u8 const* data, usize size) : ctx_{ ctx }, curr_expr_{ 0 }, expand_{ 0 }, skip_{ 0 }
+preprocessor::preprocessor(context* ctx, std::string const& name, u8 const* data, usize size)
+    : ctx_{ ctx }, lexer_{ ctx, strings_, name, reinterpret_cast<char const*>(data), size }, curr_expr_{ 0 }, depth_{ 0 }, skip_{ 0 }
 {
-    lexer_.push(lexer{ ctx, name, reinterpret_cast<char const*>(data), size });
     indents_.push({});
     defines_.reserve(5);
     defines_.insert({ "__FILE__", { define::BUILTIN,/* false,*/ {}, {} }});
     defines_.insert({ "__LINE__", { define::BUILTIN,/* false,*/ {}, {} }});
     defines_.insert({ "__DATE__", { define::BUILTIN,/* false,*/ {}, {} }});
     defines_.insert({ "__TIME__", { define::BUILTIN,/* false,*/ {}, {} }});
-    defines_.insert({ std::string(ctx->engine_name()), { define::BUILTIN,/* false,*/ {}, {} }});
+    defines_.insert({ ctx->engine_name(), { define::BUILTIN,/* false,*/ {}, {} }});
+
+    for (auto& [name, def] : defines_)
+        def.id = intern(name);
+
     directives_.reserve(15);
     directives_.insert({ "if", directive::IF });
     directives_.insert({ "ifdef", directive::IFDEF });
@@ -51,23 +55,9 @@ auto preprocessor::process() -> token
     {
         auto tok = next_token();
 
-        if (tok.type == token::MACROBEGIN)
-        {
-            reject_.insert(tok.data);
-            expand_++;
-            continue;
-        }
-
-        if (tok.type == token::MACROEND)
-        {
-            reject_.erase(tok.data);
-            expand_--;
-            continue;
-        }
-
         if (tok.type == token::SHARP)
         {
-            if (!expand_ && (tok.space == spacing::null || tok.space == spacing::empty))
+            if (!depth_ && (tok.space == spacing::null || tok.space == spacing::empty))
                 read_directive(tok);
             else
                 read_hashtoken(tok);
@@ -78,11 +68,11 @@ auto preprocessor::process() -> token
 
         if (tok.type == token::NAME)
         {
-            auto const it = defines_.find(tok.data);
+            auto const def = find_define(tok.data);
 
-            if (it != defines_.end() && (!expand_ || !reject_.contains(tok.data)))
+            if (def != nullptr && !hidden(def->id))
             {
-                expand(tok, it->second);
+                expand(tok, *def);
                 continue;
             }
         }
@@ -90,6 +80,9 @@ auto preprocessor::process() -> token
         if (tok.type == token::NEWLINE)
             continue;
 
+        for (auto& frame : headers_)
+            frame.record = false;
+
         return tok;
     }
 }
@@ -106,11 +99,17 @@ auto preprocessor::push_header(std::string const& file) -> void
                 throw ppr_error(location{}, std::format("recursive header inclusion {} at {}", name, includes_.back()));
         }
 
-        auto data = ctx_->load_header(name);
+        auto [data, defines] = load_header(name);
+
+        if (std::find(loaded_.begin(), loaded_.end(), data) == loaded_.end())
+            loaded_.push_back(data);
 
-        includes_.push_back(*std::get<0>(data));
+        if (defines != nullptr && apply_header(defines))
+            return;
+
+        includes_.push_back(data->name);
         indents_.push({});
-        lexer_.push(lexer{ ctx_, *std::get<0>(data), std::get<1>(data), std::get<2>(data) });
+        headers_.push_back(replay{ data, 0, tokens_.empty() && !depth_ && defines == nullptr, {}, {} });
     }
     catch (std::exception const& e)
     {
@@ -120,9 +119,13 @@ auto preprocessor::push_header(std::string const& file) -> void
 
 auto preprocessor::pop_header() -> void
 {
-    if (lexer_.size() > 1)
+    if (!headers_.empty())
     {
-        lexer_.pop();
+        // a header that emitted no token is summarized by the macros it left defined
+        if (headers_.back().record && tokens_.empty() && !depth_)
+            publish_header(headers_.back());
+
+        headers_.pop_back();
         indents_.pop();
         includes_.erase(includes_.end() - 1);
     }
@@ -134,12 +137,125 @@ auto preprocessor::pop_header() -> void
 
 auto preprocessor::ban_header(location const& loc) -> void
 {
-    if (lexer_.size() > 1)
+    if (!headers_.empty())
     {
         throw comp_error(loc, "not allowed inside a gsh file");
     }
 }
 
+// headers are lexed once per content and shared through the context cache
+auto preprocessor::load_header(std::string const& name) -> std::pair<header::ptr, header_defines::ptr>
+{
+    auto const file = ctx_->load_header(name);
+    auto const source = std::string_view{ std::get<1>(file), std::get<2>(file) };
+    auto const dev = (ctx_->build() & build::dev_blocks) != build::prod;
+    auto res = ctx_->headers().find(name);
+
+    if (res.first != nullptr && res.first->matches(source, dev))
+        return res;
+
+    auto data = std::make_shared<header>();
+    data->name = name;
+    data->data = source;
+    data->dev = dev;
+
+    // lexer errors are thrown when the replay reaches them, like a live lexer would
+    try
+    {
+        auto lex = lexer{ ctx_, data->strings, data->name, data->data.data(), data->data.size() };
+
+        do
+        {
+            data->tokens.push_back(lex.lex());
+        }
+        while (data->tokens.back().type != token::EOS);
+    }
+    catch (...)
+    {
+        data->error = std::current_exception();
+    }
+
+    ctx_->headers().insert(data);
+    return { data, nullptr };
+}
+
+// recorded defines stand for a replay only when every name the header looked up is still undefined
+auto preprocessor::apply_header(header_defines::ptr const& defines) -> bool
+{
+    if (!tokens_.empty() || depth_)
+        return false;
+
+    for (auto const& name : defines->absent)
+    {
+        if (defines_.contains(name))
+            return false;
+    }
+
+    for (auto const& [name, def] : defines->defines)
+    {
+        defines_.insert({ name, def }).first->second.id = intern(name);
+    }
+
+    applied_.push_back(defines);
+    return true;
+}
+
+auto preprocessor::publish_header(replay const& frame) -> void
+{
+    auto res = std::make_shared<header_defines>();
+    res->source = frame.data;
+
+    for (auto const& name : frame.absent)
+    {
+        res->absent.push_back(res->strings.store(name));
+    }
+
+    for (auto const& name : frame.added)
+    {
+        auto const itr = defines_.find(name);
+
+        if (itr == defines_.end())
+            continue;
+
+        auto def = itr->second;
+
+        for (auto& tok : def.args)
+            tok.data = res->strings.store(tok.data);
+
+        for (auto& tok : def.exp)
+            tok.data = res->strings.store(tok.data);
+
+        res->defines.push_back({ res->strings.store(name), std::move(def) });
+    }
+
+    ctx_->headers().publish(std::move(res));
+}
+
+// a header stops recording once it reads a macro it didn't define itself
+auto preprocessor::find_define(std::string_view name) -> define*
+{
+    auto const itr = defines_.find(name);
+
+    if (!headers_.empty() && headers_.back().record)
+    {
+        if (itr == defines_.end())
+            headers_.back().absent.insert(name);
+        else if (!headers_.back().added.contains(name))
+            headers_.back().record = false;
+    }
+
+    return (itr != defines_.end()) ? &itr->second : nullptr;
+}
+
+auto preprocessor::add_define(std::string_view name, define&& def) -> void
+{
+    if (!headers_.empty() && headers_.back().record)
+        headers_.back().added.insert(name);
+
+    def.id = intern(name);
+    defines_.insert({ name, std::move(def) });
+}
+
 auto preprocessor::skip_line() -> void
 {
     auto tok = read_token();
@@ -148,8 +264,24 @@ auto preprocessor::skip_line() -> void
         tok = read_token();
 }
 
+// tokens pushed back while a macro expands come before the rest of its expansion
 auto preprocessor::next_token() -> token
 {
+    while (depth_ != 0)
+    {
+        auto& frame = frames_[depth_ - 1];
+
+        if (tokens_.size() > frame.mark)
+            break;
+
+        auto tok = token{ token::EOS, spacing::none, frame.last.pos };
+
+        if (expansion_token(frame, tok))
+            return tok;
+
+        pop_expansion();
+    }
+
     if (!tokens_.empty())
     {
         auto tok = tokens_.front();
@@ -163,7 +295,7 @@ auto preprocessor::next_token() -> token
 
 auto preprocessor::read_token() -> token
 {
-    auto tok = lexer_.top().lex();
+    auto tok = headers_.empty() ? lexer_.lex() : replay_token();
 
     if (tok.type == token::EOS)
     {
@@ -174,7 +306,7 @@ auto preprocessor::read_token() -> token
             throw ppr_error(tok.pos, "missing #endif");
         }
 
-        if (lexer_.size() > 1)
+        if (!headers_.empty())
         {
             pop_header();
             return read_token();
@@ -184,6 +316,16 @@ auto preprocessor::read_token() -> token
     return tok;
 }
 
+auto preprocessor::replay_token() -> token
+{
+    auto& frame = headers_.back();
+
+    if (frame.pos == frame.data->tokens.size())
+        std::rethrow_exception(frame.data->error);
+
+    return frame.data->tokens[frame.pos++];
+}
+
 auto preprocessor::read_directive(token& tok) -> void
 {
     auto next = read_token();
@@ -283,7 +425,7 @@ auto preprocessor::read_directive_ifdef(token&) -> void
         tok = read_token();
         expect(tok, token::NEWLINE);
 
-        skip = !defines_.contains(name);
+        skip = find_define(name) == nullptr;
     }
 
     indents_.top().push({ directive::IFDEF, skip, !skip });
@@ -308,7 +450,7 @@ auto preprocessor::read_directive_ifndef(token&) -> void
         tok = read_token();
         expect(tok, token::NEWLINE);
 
-        skip = defines_.contains(name);
+        skip = find_define(name) != nullptr;
     }
 
     indents_.top().push({ directive::IFNDEF, skip, !skip });
@@ -368,7 +510,7 @@ auto preprocessor::read_directive_elifdef(token& tok) -> void
         next = read_token();
         expect(next, token::NEWLINE);
 
-        skip = !defines_.contains(name) || dir.exec;
+        skip = find_define(name) == nullptr || dir.exec;
     }
 
     indents_.top().push({ directive::ELIFDEF, skip, !skip || dir.exec });
@@ -407,7 +549,7 @@ auto preprocessor::read_directive_elifndef(token& tok) -> void
         next = read_token();
         expect(next, token::NEWLINE);
 
-        skip = defines_.contains(name) || dir.exec;
+        skip = find_define(name) != nullptr || dir.exec;
     }
 
     indents_.top().push({ directive::ELIFNDEF, skip, !skip || dir.exec });
@@ -462,7 +604,7 @@ auto preprocessor::read_directive_define(token&) -> void
 
     auto name = std::move(next.data);
 
-    if (defines_.contains(name))
+    if (find_define(name) != nullptr)
     {
         throw ppr_error(next.pos, "macro redefinition");
     }
@@ -472,7 +614,7 @@ auto preprocessor::read_directive_define(token&) -> void
     switch (next.type)
     {
         case token::NEWLINE:
-            defines_.insert({ name, define{ define::PLAIN,/* false,*/ {}, {} }});
+            add_define(name, define{ define::PLAIN,/* false,*/ {}, {} });
             break;
         case token::LPAREN:
             if (next.space == spacing::none)
@@ -605,7 +747,7 @@ auto preprocessor::read_directive_define(token&) -> void
                         throw ppr_error(next.pos, "'#' is not followed by a macro parameter");
                 }
 
-                defines_.insert({ name, define{ define::FUNCTION, /*last_elips,*/ params, exp }});
+                add_define(name, define{ define::FUNCTION, /*last_elips,*/ params, exp });
                 break;
             }
         default:
@@ -623,7 +765,7 @@ auto preprocessor::read_directive_define(token&) -> void
 
                 expect(next, token::NEWLINE);
 
-                defines_.insert({ name, define{ define::OBJECT,/* false,*/ {}, exp }});
+                add_define(name, define{ define::OBJECT,/* false,*/ {}, exp });
             }
             else
             {
@@ -645,14 +787,14 @@ auto preprocessor::read_directive_undef(token& tok) -> void
     next = read_token();
     expect(next, token::NEWLINE);
 
-    auto const it = defines_.find(name);
+    auto const def = find_define(name);
 
-    if (it != defines_.end())
+    if (def != nullptr)
     {
-        if (it->second.type == define::BUILTIN)
+        if (def->type == define::BUILTIN)
             throw ppr_error(tok.pos, "can't undefine builtin macro");
 
-        defines_.erase(it);
+        defines_.erase(name);
     }
 }
 
@@ -744,6 +886,172 @@ auto preprocessor::read_hashtoken_animtree(token& hash, token& name) -> void
     }
 }
 
+auto preprocessor::intern(std::string_view name) -> u32
+{
+    return ids_.try_emplace(name, static_cast<u32>(ids_.size())).first->second;
+}
+
+auto preprocessor::hidden(u32 id) const -> bool
+{
+    return (id >> 6) < hidden_.size() && ((hidden_[id >> 6] >> (id & 63)) & 1);
+}
+
+// frames are reused once popped, their buffers keep their capacity
+auto preprocessor::push_expansion(define const* def, u32 id) -> expansion&
+{
+    if (depth_ == frames_.size())
+        frames_.emplace_back();
+
+    if ((id >> 6) >= hidden_.size())
+        hidden_.resize((id >> 6) + 1);
+
+    hidden_[id >> 6] |= u64{ 1 } << (id & 63);
+
+    auto& frame = frames_[depth_++];
+    frame.def = def;
+    frame.args.clear();
+    frame.bounds.clear();
+    frame.pos = 0;
+    frame.slot = 0;
+    frame.arg = 0;
+    frame.end = 0;
+    frame.mark = tokens_.size();
+    frame.id = id;
+    frame.held = false;
+    return frame;
+}
+
+auto preprocessor::pop_expansion() -> void
+{
+    auto const id = frames_[--depth_].id;
+    hidden_[id >> 6] &= ~(u64{ 1 } << (id & 63));
+}
+
+auto preprocessor::param_index(define const& def, std::string_view name) const -> usize
+{
+    for (auto i = 0u; i < def.args.size(); i++)
+    {
+        if (def.args[i].data == name)
+            return i;
+    }
+
+    return def.args.size();
+}
+
+// empty arguments produce nothing, a frame is over once only they remain
+auto preprocessor::expansion_ended(expansion const& frame) const -> bool
+{
+    if (frame.held || frame.arg < frame.end)
+        return false;
+
+    if (frame.def == nullptr)
+        return true;
+
+    for (auto i = frame.pos; i < frame.def->exp.size(); i++)
+    {
+        auto const& tok = frame.def->exp[i];
+
+        if (tok.type == token::MACROVAARGS || tok.type == token::MACROVAOPT)
+            continue;
+
+        if (tok.type == token::MACROARG)
+        {
+            auto const n = param_index(*frame.def, tok.data);
+
+            if (n == frame.def->args.size() || frame.bounds[n] == frame.bounds[n + 1])
+                continue;
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
+// a token is held back until the next one shows it isn't the left side of a paste
+auto preprocessor::expansion_token(expansion& frame, token& out) -> bool
+{
+    while (true)
+    {
+        if (frame.arg < frame.end)
+        {
+            out = frame.args[frame.arg++];
+
+            if (frame.def != nullptr)
+                out.pos = frame.def->exp[frame.slot].pos;
+        }
+        else if (frame.def != nullptr && frame.pos < frame.def->exp.size())
+        {
+            auto const& tok = frame.def->exp[frame.pos++];
+
+            if (tok.type == token::MACROARG)
+            {
+                auto const n = param_index(*frame.def, tok.data);
+
+                if (n != frame.def->args.size())
+                {
+                    frame.slot = frame.pos - 1;
+                    frame.arg = frame.bounds[n];
+                    frame.end = frame.bounds[n + 1];
+                }
+
+                continue;
+            }
+            else if (tok.type == token::MACROVAARGS || tok.type == token::MACROVAOPT)
+            {
+                // TODO: variadic macros
+                continue;
+            }
+            else if (tok.type == token::PASTE)
+            {
+                // operands were checked when the expansion started
+                frame.last.data = strings_.store(std::format("{}{}", frame.last.data, frame.def->exp[frame.pos++].data));
+                continue;
+            }
+            else if (tok.type == token::STRINGIZE)
+            {
+                auto const n = param_index(*frame.def, frame.def->exp[frame.pos++].data);
+                auto str = std::string{};
+
+                if (n != frame.def->args.size())
+                {
+                    for (auto i = frame.bounds[n]; i < frame.bounds[n + 1]; i++)
+                    {
+                        if (i != frame.bounds[n] && frame.args[i].space == spacing::back)
+                            str.append(" ");
+                        str.append(frame.args[i].to_string());
+                    }
+                }
+
+                out = token{ token::STRING, tok.space, tok.pos, strings_.store(str) };
+            }
+            else
+            {
+                out = tok;
+            }
+        }
+        else
+        {
+            if (!frame.held)
+                return false;
+
+            out = frame.last;
+            frame.held = false;
+            return true;
+        }
+
+        if (!frame.held)
+        {
+            frame.last = out;
+            frame.held = true;
+            continue;
+        }
+
+        std::swap(out, frame.last);
+        return true;
+    }
+}
+
 auto preprocessor::expand(token& tok, define& def) -> void
 {
     if (def.type == define::PLAIN)
@@ -757,7 +1065,7 @@ auto preprocessor::expand(token& tok, define& def) -> void
         }
         else if (tok.data == "__LINE__")
         {
-            tokens_.push_front(token{ token::STRING, tok.space, tok.pos, std::format("{}", tok.pos.begin.line) });
+            tokens_.push_front(token{ token::STRING, tok.space, tok.pos, strings_.store(std::format("{}", tok.pos.begin.line)) });
         }
         else if (tok.data == "__DATE__")
         {
@@ -770,117 +1078,46 @@ auto preprocessor::expand(token& tok, define& def) -> void
     }
     else if (def.type == define::OBJECT)
     {
-        tokens_.push_front(token{ token::MACROEND, tok.space, tok.pos, tok.data });
-        for (auto it = def.exp.rbegin(); it != def.exp.rend(); ++it) tokens_.push_front(*it);
-        tokens_.push_front(token{ token::MACROBEGIN, tok.space, tok.pos, tok.data });
+        push_expansion(&def, def.id);
     }
     else if (def.type == define::FUNCTION)
     {
-        auto next = next_token();
-
-        if (next.type != token::LPAREN)
+        // a name ending the expansion it came from doesn't take the tokens after it as arguments
+        if (depth_ != 0 && tokens_.size() == frames_[depth_ - 1].mark && expansion_ended(frames_[depth_ - 1]))
         {
-            tokens_.push_front(next);
-            tokens_.push_front(token{ token::MACROEND, tok.space, tok.pos, tok.data });
-            tokens_.push_front(tok);
-            tokens_.push_front(token{ token::MACROBEGIN, tok.space, tok.pos, tok.data });
+            auto& frame = push_expansion(nullptr, def.id);
+            frame.args.push_back(tok);
+            frame.end = 1;
             return;
         }
 
-        auto args = expand_params(tok, def);
-
-        auto exp = std::vector<token>{};
-        exp.reserve(def.exp.size());
+        auto next = next_token();
 
-        for (auto i = 0u; i < def.exp.size(); i++)
+        if (next.type != token::LPAREN)
         {
-            if (def.exp[i].type == token::MACROARG)
-            {
-                auto const& name = def.exp[i].data;
-
-                for (auto n = 0u; n < def.args.size(); n++)
-                {
-                    if (def.args[n].data == name)
-                    {
-                        for (auto t : args.at(n))
-                            exp.push_back(token{ t.type, t.space, def.exp[i].pos, t.data });
-
-                        break;
-                    }
-                }
-            }
-            else if (def.exp[i].type == token::MACROVAARGS)
-            {
-                // TODO:
-                // if (!def.vararg)
-                //     throw ppr_error(def.exp[i].pos, "__VA_ARGS__ can only appear in the expansion of a variadic macro");
-
-                // for (auto t : args.back()) exp.push_back(t);
-            }
-            else if (def.exp[i].type == token::MACROVAOPT)
-            {
-                // TODO:
-                // if (!def.vararg)
-                //     throw ppr_error(def.exp[i].pos, "__VA_OPT__ can only appear in the expansion of a variadic macro");
-
-                //
-                // if (!args.back().empty())
-                // {
-                //     // paste opt
-                // }
-            }
-            else if (def.exp[i].type == token::STRINGIZE)
-            {
-                auto name = def.exp[i + 1].data;
-                auto str = std::string{};
-
-                for (auto n = 0u; n < def.args.size(); n++)
-                {
-                    if (def.args[n].data == name)
-                    {
-                        for (size_t idx = 0; auto t : args.at(n))
-                        {
-                            if (idx != 0 && t.space == spacing::back)
-                                str.append(" ");
-                            str.append(t.to_string());
-                            idx++;
-                        }
-                        break;
-                    }
-                }
+            tokens_.push_front(next);
 
-                exp.push_back(token{ token::STRING, def.exp[i].space, def.exp[i].pos, str });
-                i++;
-            }
-            else if (def.exp[i].type == token::PASTE)
-            {
-                if (exp.back().type == token::NAME && def.exp[i+1].type == token::NAME)
-                {
-                    exp.back().data.append(def.exp[i+1].data);
-                }
-                else
-                {
-                    throw ppr_error(def.exp[i].pos, "paste can only be applied to identifiers");
-                }
-                i++;
-            }
-            else
-            {
-                exp.push_back(def.exp[i]);
-            }
+            auto& frame = push_expansion(nullptr, def.id);
+            frame.args.push_back(tok);
+            frame.end = 1;
+            return;
         }
 
-        tokens_.push_front(token{ token::MACROEND, tok.space, tok.pos, tok.data });
-        for (auto it = exp.rbegin(); it != exp.rend(); ++it) tokens_.push_front(*it);
-        tokens_.push_front(token{ token::MACROBEGIN, tok.space, tok.pos, tok.data });
+        expand_params(tok, def);
+        expand_check(def);
+
+        auto& frame = push_expansion(&def, def.id);
+        std::swap(frame.args, params_);
+        std::swap(frame.bounds, bounds_);
     }
 }
 
-auto preprocessor::expand_params(token& tok, define& def) -> std::vector<std::vector<token>>
+auto preprocessor::expand_params(token& tok, define const& def) -> void
 {
     auto nest_paren = 0;
-    auto args = std::vector<std::vector<token>>{};
-    args.push_back({});
+    params_.clear();
+    bounds_.clear();
+    bounds_.push_back(0);
 
     while (true)
     {
@@ -893,7 +1130,7 @@ auto preprocessor::expand_params(token& tok, define& def) -> std::vector<std::ve
         else if (next.type == token::LPAREN)
         {
             nest_paren++;
-            args.back().push_back(next);
+            params_.push_back(next);
         }
         else if (next.type == token::RPAREN)
         {
@@ -902,36 +1139,80 @@ auto preprocessor::expand_params(token& tok, define& def) -> std::vector<std::ve
             else
             {
                 nest_paren--;
-                args.back().push_back(next);
+                params_.push_back(next);
             }
         }
         else if (next.type == token::COMMA && nest_paren == 0 /*&& !(def.vararg && args.size() > def.args.size())*/)
         {
-            args.push_back({});
+            bounds_.push_back(params_.size());
         }
         else
         {
-            args.back().push_back(next);
+            params_.push_back(next);
         }
     }
 
-    if (def.args.empty() && args.size() == 1 && args[0].empty())
+    bounds_.push_back(params_.size());
+
+    if (def.args.empty() && bounds_.size() == 2 && params_.empty())
     {
-        args.pop_back();
+        bounds_.pop_back();
     }
 
-    if (args.size() < def.args.size())
+    if (bounds_.size() - 1 < def.args.size())
     {
         throw ppr_error(tok.pos, "too few arguments provided to function-like macro invocation");
     }
 
-    if (/*!def.vararg &&*/ args.size() > def.args.size())
+    if (/*!def.vararg &&*/ bounds_.size() - 1 > def.args.size())
     {
         throw ppr_error(tok.pos, "too many arguments provided to function-like macro invocation");
     }
 
     // TODO: expand args
-    return args;
+}
+
+// bad pastes fail before any token of the expansion is read
+auto preprocessor::expand_check(define const& def) -> void
+{
+    auto last = token::EOS;
+    auto some = false;
+
+    for (auto i = 0u; i < def.exp.size(); i++)
+    {
+        auto const& tok = def.exp[i];
+
+        if (tok.type == token::MACROARG)
+        {
+            auto const n = param_index(def, tok.data);
+
+            if (n != def.args.size() && bounds_[n] != bounds_[n + 1])
+            {
+                last = params_[bounds_[n + 1] - 1].type;
+                some = true;
+            }
+        }
+        else if (tok.type == token::STRINGIZE)
+        {
+            last = token::STRING;
+            some = true;
+            i++;
+        }
+        else if (tok.type == token::PASTE)
+        {
+            if (!some || last != token::NAME || def.exp[i + 1].type != token::NAME)
+            {
+                throw ppr_error(tok.pos, "paste can only be applied to identifiers");
+            }
+
+            i++;
+        }
+        else if (tok.type != token::MACROVAARGS && tok.type != token::MACROVAOPT)
+        {
+            last = tok.type;
+            some = true;
+        }
+    }
 }
 
 auto preprocessor::expect(token& tok, token::kind expected, spacing) -> void
@@ -966,17 +1247,7 @@ auto preprocessor::evaluate() -> bool
     tok = next_token();
     while (tok.type != token::NEWLINE)
     {
-        if (tok.type == token::MACROBEGIN)
-        {
-            reject_.insert(tok.data);
-            expand_++;
-        }
-        else if (tok.type == token::MACROEND)
-        {
-            reject_.erase(tok.data);
-            expand_--;
-        }
-        else if (tok.type == token::LPAREN && last_def && !last_paren)
+        if (tok.type == token::LPAREN && last_def && !last_paren)
         {
             last_paren = true;
             expr_.push_back(std::move(tok));
@@ -1012,11 +1283,11 @@ auto preprocessor::evaluate() -> bool
                 last_def = false;
                 last_paren = false;
 
-                auto const it = defines_.find(tok.data);
+                auto const def = find_define(tok.data);
 
-                if (it != defines_.end() && (!expand_ || !reject_.contains(tok.data)))
+                if (def != nullptr && !hidden(def->id))
                 {
-                    expand(tok, it->second);
+                    expand(tok, *def);
                 }
                 else // macro not defined
                 {
@@ -1346,10 +1617,10 @@ auto preprocessor::eval_expr_primary() -> i32
         return 0;
 
     if (eval_match(token::FLT))
-        return static_cast<i32>(std::stof(eval_prev().data));
+        return static_cast<i32>(std::stof(std::string{ eval_prev().data }));
 
     if (eval_match(token::INT))
-        return static_cast<i32>(std::stoi(eval_prev().data));
+        return static_cast<i32>(std::stoi(std::string{ eval_prev().data }));
 
     if (eval_match(token::LPAREN))
     {
@@ -1366,13 +1637,13 @@ auto preprocessor::eval_expr_primary() -> i32
 
             if (val.type == token::NAME)
             {
-                return defines_.contains(val.data);
+                return find_define(val.data) != nullptr;
             }
             else if (eval_match(token::NAME))
             {
                 val = eval_prev();
                 eval_consume(token::RPAREN, "expect ')' after defined( identifier.");
-                return defines_.contains(val.data);
+                return find_define(val.data) != nullptr;
             }
 
             throw ppr_error(eval_peek().pos, "expect identifier after defined(.");
@@ -29,15 +29,36 @@ auto source::parse_assembly(std::vector<u8> const& data) -> assembly::ptr
 
 auto source::parse_assembly(u8 const* data, usize size) -> assembly::ptr
 {
-    auto lines = utils::string::clean_buffer_lines(data, size);
+    auto const text = std::string_view{ reinterpret_cast<char const*>(data), size };
     auto assembly = assembly::make();
     auto func = function::ptr{ nullptr };
+    auto opdata = std::vector<std::string_view>{};
     auto index = usize{ 1 };
     auto count = u16{ 0 };
 
-    for (auto& line : lines)
+    auto const parse_operand = [](std::string_view entry)
     {
-        if (line == "" || line.starts_with("//"))
+        return entry.starts_with('"') ? operand{ utils::string::to_code(std::string{ entry }) } : operand{ entry };
+    };
+
+    for (auto pos = usize{ 0 }; pos < text.size(); )
+    {
+        auto end = text.find('\n', pos);
+
+        if (end == std::string_view::npos)
+            end = text.size();
+
+        auto line = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        // lines are indented with tabs and may end with \r
+        while (!line.empty() && (line.front() == '\t' || line.front() == ' '))
+            line.remove_prefix(1);
+
+        while (!line.empty() && (line.back() == '\r' || line.back() == '\t' || line.back() == ' '))
+            line.remove_suffix(1);
+
+        if (line.empty() || line.starts_with("//"))
             continue;
 
         if (line.starts_with("sub:"))
@@ -62,15 +83,28 @@ auto source::parse_assembly(u8 const* data, usize size) -> assembly::ptr
             continue;
         }
 
-        auto opdata = utils::string::parse_code(line);
+        utils::string::parse_code(line, opdata);
 
         if (count)
         {
             if (opdata[0] != "case" && opdata[0] != "default")
-                throw asm_error("invalid instruction inside endswitch \""s + line + "\"");
+                throw asm_error(std::format("invalid instruction inside endswitch \"{}\"", line));
+
+            auto& data = func->instructions.back()->data;
 
-            for (auto const& entry : opdata)
-                func->instructions.back()->data.push_back(entry);
+            // the dump leaves the case type implicit, string values are the quoted ones
+            if (opdata[0] == "case" && opdata.size() == 3)
+            {
+                data.emplace_back(opdata[0]);
+                data.push_back(operand::make_int(static_cast<int>(opdata[1].starts_with('"') ? switch_type::string : switch_type::integer)));
+                data.push_back(parse_operand(opdata[1]));
+                data.emplace_back(opdata[2]);
+            }
+            else
+            {
+                for (auto const& entry : opdata)
+                    data.push_back(parse_operand(entry));
+            }
 
             count--;
             continue;
@@ -80,8 +114,9 @@ auto source::parse_assembly(u8 const* data, usize size) -> assembly::ptr
         inst->index = index;
         inst->opcode = ctx_->opcode_enum(opdata[0]);
         inst->size = ctx_->opcode_size(inst->opcode);
-        opdata.erase(opdata.begin());
-        inst->data = std::move(opdata);
+
+        for (auto i = 1u; i < opdata.size(); i++)
+            inst->data.push_back(parse_operand(opdata[i]));
 
         switch (inst->opcode)
         {
@@ -90,11 +125,11 @@ auto source::parse_assembly(u8 const* data, usize size) -> assembly::ptr
                     inst->size += ((inst->index + 4) & ~3) - (inst->index + 1);
                 break;
             case opcode::OP_endswitch:
-                count = static_cast<u16>(std::stoul(inst->data[0]));
+                count = static_cast<u16>(inst->data[0].as_int());
                 inst->size += 7 * count;
                 break;
             case opcode::OP_FormalParams:
-                count = static_cast<u8>(std::stoul(inst->data[0]));
+                count = static_cast<u8>(inst->data[0].as_int());
                 inst->size += (ctx_->props() & props::hash) ? count * 8 : count;
                 break;
             default:
@@ -120,14 +155,20 @@ auto source::parse_program(std::string const& name, std::vector<u8> const& data)
 
 auto source::parse_program(std::string const& name, u8 const* data, usize size) -> program::ptr
 {
+    auto nodes = utils::arena{};
     auto res = program::ptr{ nullptr };
-    auto ppr = preprocessor{ ctx_, name, data, size };
-    auto psr = parser{ ctx_, ppr, res, 0 };
 
-    if (!psr.parse() && res != nullptr)
-        return res;
+    {
+        auto scope = node_arena{ nodes };
+        auto ppr = preprocessor{ ctx_, name, data, size };
+        auto psr = parser{ ctx_, ppr, res, 0 };
+
+        if (psr.parse() || res == nullptr)
+            throw error{ std::format("an unknown error ocurred while parsing script {}", name) };
+    }
 
-    throw error{ std::format("an unknown error ocurred while parsing script {}", name) };
+    res->nodes = std::move(nodes);
+    return res;
 }
 
 auto source::dump(assembly const& data) -> std::vector<u8>
@@ -190,15 +231,15 @@ auto source::dump_instruction(instruction const& inst) -> void
         case opcode::OP_GetString:
         case opcode::OP_GetIString:
         case opcode::OP_GetAnimTree:
-            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[0]));
+            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[0].text));
             break;
         case opcode::OP_GetAnimation:
-            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[0]));
-            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[1]));
+            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[0].text));
+            std::format_to(std::back_inserter(buf_), " {}", utils::string::to_literal(inst.data[1].text));
             break;
         case opcode::OP_endswitch:
         {
-            auto count = static_cast<u32>(std::stoul(inst.data[0]));
+            auto count = static_cast<u32>(inst.data[0].as_int());
             auto index = 1;
 
             std::format_to(std::back_inserter(buf_), " {}\n", count);
@@ -207,14 +248,14 @@ auto source::dump_instruction(instruction const& inst) -> void
             {
                 if (inst.data[index] == "case")
                 {
-                    auto type = static_cast<switch_type>(std::stoul(inst.data[index + 1]));
-                    auto data = (type == switch_type::integer) ? std::format("{}", inst.data[index + 2]) : utils::string::to_literal(inst.data[index + 2]);
-                    std::format_to(std::back_inserter(buf_), "\t\t\t{} {} {}", inst.data[index], data, inst.data[index + 3]);
+                    auto type = static_cast<switch_type>(inst.data[index + 1].as_int());
+                    auto data = (type == switch_type::integer) ? inst.data[index + 2].to_string() : utils::string::to_literal(inst.data[index + 2].text);
+                    std::format_to(std::back_inserter(buf_), "\t\t\t{} {} {}", inst.data[index].text, data, inst.data[index + 3].text);
                     index += 4;
                 }
                 else if (inst.data[index] == "default")
                 {
-                    std::format_to(std::back_inserter(buf_), "\t\t\t{} {}", inst.data[index], inst.data[index + 1]);
+                    std::format_to(std::back_inserter(buf_), "\t\t\t{} {}", inst.data[index].text, inst.data[index + 1].text);
                     index += 2;
                 }
 
@@ -228,7 +269,7 @@ auto source::dump_instruction(instruction const& inst) -> void
         default:
             for (auto const& entry : inst.data)
             {
-                std::format_to(std::back_inserter(buf_), " {}", entry);
+                std::format_to(std::back_inserter(buf_), " {}", entry.to_string());
             }
             break;
     }
@@ -909,32 +950,32 @@ auto source::dump_stmt_clear(stmt_clear const& stm) -> void
 
 auto source::dump_stmt_jmp(stmt_jmp const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_jmp( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_jmp( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_back(stmt_jmp_back const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_jmp_back( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_jmp_back( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_cond(stmt_jmp_cond const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_jmp_cond( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_jmp_cond( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_true(stmt_jmp_true const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_jmp_expr_true( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_jmp_expr_true( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_false(stmt_jmp_false const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_jmp_expr_false( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_jmp_expr_false( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_switch(stmt_jmp_switch const& stm) -> void
 {
-    std::format_to(std::back_inserter(buf_), "__asm_switch( {} )", stm.value);
+    std::format_to(std::back_inserter(buf_), "__asm_switch( loc_{:X} )", stm.value);
 }
 
 auto source::dump_stmt_jmp_endswitch(stmt_jmp_endswitch const&) -> void
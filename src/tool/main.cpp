@@ -7,6 +7,8 @@
 #include "xsk/utils/zlib.hpp"
 #include "xsk/utils/file.hpp"
 #include "xsk/utils/string.hpp"
+#include "xsk/utils/thread_pool.hpp"
+#include "xsk/utils/watcher.hpp"
 #include "xsk/gsc/engine/iw5_pc.hpp"
 #include "xsk/gsc/engine/iw5_ps.hpp"
 #include "xsk/gsc/engine/iw5_xb.hpp"
@@ -47,6 +49,9 @@ enum class mach { _, pc, ps3, ps4, ps5, xb2, xb3, xb4, wiiu };
 enum class inst { _, server, client };
 
 auto dry_run = false;
+auto jobs = usize{ 1 };
+// a single script spreads its functions over these workers when jobs are requested
+auto function_pool = static_cast<utils::thread_pool*>(nullptr);
 
 std::unordered_map<std::string_view, fenc> const gsc_exts =
 {
@@ -167,22 +172,307 @@ auto overwrite_prompt(std::string const& file) -> bool
     return overwrite;
 }
 
+namespace cache
+{
+
+auto root = fs::path{};
+auto limit = u64{ 0 };
+auto config = std::string{};
+std::atomic<usize> hits;
+std::atomic<usize> misses;
+std::atomic<usize> evicted;
+
+using digest_fn = std::function<u64(std::string const&)>;
+
+auto enabled() -> bool
+{
+    return !root.empty() && !dry_run;
+}
+
+auto hash(u8 const* data, usize size, u64 value = 0xCBF29CE484222325) -> u64
+{
+    for (auto i = 0u; i < size; i++)
+    {
+        value ^= data[i];
+        value *= 0x100000001B3;
+    }
+
+    return value;
+}
+
+auto digest(fs::path const& file) -> u64
+{
+    if (!utils::file::exists(file))
+        return 0;
+
+    auto data = utils::file::read(file);
+    return hash(data.data(), data.size());
+}
+
+// inputs hash together with everything that changes the output for the same bytes
+auto key(mode mode, std::initializer_list<std::pair<u8 const*, usize>> inputs) -> std::string
+{
+    if (!enabled())
+        return {};
+
+    auto const salt = std::format("{}|{}", static_cast<i32>(mode), config);
+    auto value = hash(reinterpret_cast<u8 const*>(salt.data()), salt.size());
+    auto input = u64{ 0xCBF29CE484222325 };
+
+    for (auto const& [data, size] : inputs)
+    {
+        input = hash(data, size, input);
+    }
+
+    return std::format("{:016x}{:016x}", value, input);
+}
+
+auto fetch(std::string const& key, std::vector<fs::path> const& outputs, digest_fn const& digest, std::vector<std::string>* deps = nullptr, std::string* note = nullptr) -> bool
+{
+    if (!enabled())
+        return false;
+
+    try
+    {
+        auto const entry = root / key;
+        auto stream = std::ifstream{ entry / "manifest" };
+        auto count = usize{ 0 };
+
+        if (!(stream >> count) || count != outputs.size())
+        {
+            misses++;
+            return false;
+        }
+
+        auto line = std::string{};
+        std::getline(stream, line);
+
+        // every header & include the entry was compiled against must be unchanged
+        while (std::getline(stream, line))
+        {
+            auto const pos = line.find(' ');
+
+            if (pos == std::string::npos || std::stoull(line.substr(0, pos), nullptr, 16) != digest(line.substr(pos + 1)))
+            {
+                misses++;
+                return false;
+            }
+
+            if (deps != nullptr)
+                deps->push_back(line.substr(pos + 1));
+        }
+
+        stream.close();
+
+        for (auto i = 0u; i < outputs.size(); i++)
+        {
+            fs::create_directories(outputs[i].parent_path());
+            fs::copy_file(entry / std::to_string(i), outputs[i], fs::copy_options::overwrite_existing);
+        }
+
+        // messages printed when the entry was built, replayed on a hit
+        if (note != nullptr && fs::exists(entry / "note"))
+        {
+            auto const data = utils::file::read(entry / "note");
+            note->assign(data.begin(), data.end());
+        }
+
+        fs::last_write_time(entry / "manifest", fs::file_time_type::clock::now());
+        hits++;
+        return true;
+    }
+    catch (std::exception const&)
+    {
+        misses++;
+        return false;
+    }
+}
+
+auto store(std::string const& key, std::vector<fs::path> const& outputs, std::vector<std::string> const& deps, digest_fn const& digest, std::string const& note = {}) -> void
+{
+    if (!enabled() || fs::exists(root / key))
+        return;
+
+    // build the entry aside and publish it with a rename, concurrent writers of the same key lose the race
+    auto const temp = utils::file::temp_path(root / key);
+
+    try
+    {
+        fs::create_directories(temp);
+
+        for (auto i = 0u; i < outputs.size(); i++)
+        {
+            fs::copy_file(outputs[i], temp / std::to_string(i), fs::copy_options::overwrite_existing);
+        }
+
+        if (auto stream = std::ofstream{ temp / "manifest" }; stream)
+        {
+            stream << outputs.size() << '\n';
+
+            for (auto const& dep : deps)
+            {
+                stream << std::format("{:016x} {}\n", digest(dep), dep);
+            }
+        }
+
+        if (!note.empty())
+            utils::file::save(temp / "note", reinterpret_cast<u8 const*>(note.data()), note.size());
+
+        fs::rename(temp, root / key);
+    }
+    catch (std::exception const&)
+    {
+        auto ec = std::error_code{};
+        fs::remove_all(temp, ec);
+    }
+}
+
+// evict least recently used entries until the cache fits the size limit
+auto trim() -> void
+{
+    if (!enabled() || !fs::is_directory(root))
+        return;
+
+    struct entry
+    {
+        fs::path path;
+        fs::file_time_type time;
+        u64 size;
+    };
+
+    auto entries = std::vector<entry>{};
+    auto total = u64{ 0 };
+
+    for (auto const& dir : fs::directory_iterator(root))
+    {
+        if (!dir.is_directory() || !fs::exists(dir.path() / "manifest"))
+            continue;
+
+        auto size = u64{ 0 };
+
+        for (auto const& file : fs::directory_iterator(dir.path()))
+        {
+            size += file.is_regular_file() ? file.file_size() : 0;
+        }
+
+        entries.push_back({ dir.path(), fs::last_write_time(dir.path() / "manifest"), size });
+        total += size;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](auto const& lhs, auto const& rhs) { return lhs.time < rhs.time; });
+
+    for (auto const& entry : entries)
+    {
+        if (total <= limit)
+            break;
+
+        auto ec = std::error_code{};
+        fs::remove_all(entry.path, ec);
+        total -= entry.size;
+        evicted++;
+    }
+}
+
+} // namespace cache
+
+namespace watch
+{
+
+auto enabled = false;
+std::mutex mutex;
+
+struct node
+{
+    std::vector<std::pair<std::string, std::string>> deps;
+    bool failed;
+};
+
+// dependency names and resolved paths of every compiled file
+std::unordered_map<std::string, node> graph;
+
+auto key(fs::path const& file) -> std::string
+{
+    return fs::absolute(file).lexically_normal().generic_string();
+}
+
+auto record(fs::path const& file, std::vector<std::string> const& deps, std::function<fs::path(std::string const&)> const& resolve, bool failed) -> void
+{
+    if (!enabled)
+        return;
+
+    auto entry = node{ {}, failed };
+
+    for (auto const& dep : deps)
+    {
+        entry.deps.push_back({ dep, key(resolve(dep)) });
+    }
+
+    auto lock = std::unique_lock{ mutex };
+    graph[key(file)] = std::move(entry);
+}
+
+} // namespace watch
+
 namespace gsc
 {
 
-std::map<game, std::map<mach, std::unique_ptr<context>>> contexts;
-std::map<mode, std::function<result(game game, mach mach, fs::path file, fs::path rel)>> funcs;
+// contexts are kept per target, so a server run reuses them across requests
+std::map<std::tuple<game, mach, inst>, std::vector<std::unique_ptr<context>>> pools;
+std::vector<std::unique_ptr<context>>* contexts = nullptr;
+// tokenized headers shared by the contexts of a target, persisted next to the output cache
+std::map<std::tuple<game, mach, inst>, header_cache::ptr> headers;
+std::map<mode, std::function<result(context& ctx, game game, fs::path file, fs::path rel, std::ostream& out, std::ostream& err)>> funcs;
 bool zonetool = false;
+bool optimize = false;
+
+// resolves a header or include name the way fs_read loads it
+auto fs_path(context const* ctx, std::string const& name) -> fs::path
+{
+    auto path = fs::path{ name };
+
+    if (!utils::file::exists(path))
+    {
+        auto const bin_ext = ctx->instance() == gsc::instance::client ? ".cscbin" : ".gscbin";
+        auto const name_noext = path.replace_extension("").string();
+
+        auto id = ctx->token_id(name_noext);
+        if (id > 0)
+        {
+            path = fs::path{ std::to_string(id) + bin_ext };
+        }
+
+        if (!utils::file::exists(path))
+        {
+            path = fs::path{ name_noext + bin_ext };
+        }
+    }
+
+    return path;
+}
 
-auto assemble_file(game game, mach mach, fs::path file, fs::path rel) -> result
+// one file per build config, written back once the run is over
+auto headers_path() -> fs::path
+{
+    return cache::root / std::format("headers.{:016x}", cache::hash(reinterpret_cast<u8 const*>(cache::config.data()), cache::config.size()));
+}
+
+auto save_headers(game game, mach mach, inst inst) -> void
+{
+    auto const itr = headers.find({ game, mach, inst });
+
+    if (itr != headers.end() && cache::enabled())
+        itr->second->save(headers_path());
+}
+
+auto assemble_file(context& ctx, game game, fs::path file, fs::path rel, std::ostream& out, std::ostream& err) -> result
 {
     try
     {
         rel = fs::path{ games_rev.at(game) } / rel / file.filename().replace_extension((zonetool ? ".cgsc" : ".gscbin"));
 
         auto data = utils::file::read(file);
-        auto outasm = contexts[game][mach]->source().parse_assembly(data);
-        auto outbin = contexts[game][mach]->assembler().assemble(*outasm);
+        auto outasm = ctx.source().parse_assembly(data);
+        auto outbin = ctx.assembler().assemble(*outasm);
 
         if (true/*overwrite_prompt(file + (zonetool ? ".cgsc" : ".gscbin"))*/)
         {
@@ -196,30 +486,24 @@ auto assemble_file(game game, mach mach, fs::path file, fs::path rel) -> result
                     utils::file::save(path.replace_extension(".cgsc.stack"), std::get<1>(outbin).data, std::get<1>(outbin).size);
                 }
 
-                std::cout << std::format("assembled {}\n", rel.generic_string());
+                out << std::format("assembled {}\n", rel.generic_string());
             }
             else
             {
-                asset script;
-                script.name = "GSC"s;
-
-                script.bytecode.resize(std::get<0>(outbin).size);
-                std::memcpy(script.bytecode.data(), std::get<0>(outbin).data, script.bytecode.size());
-
-                script.buffer.resize(std::get<1>(outbin).size);
-                std::memcpy(script.buffer.data(), std::get<1>(outbin).data, script.buffer.size());
-                script.buffer = utils::zlib::compress(script.buffer);
+                auto stack = utils::zlib::compress(std::get<1>(outbin).data, std::get<1>(outbin).size);
 
+                asset_view script;
+                script.name = "GSC"sv;
                 script.len = static_cast<u32>(std::get<1>(outbin).size);
-                script.compressedLen = static_cast<u32>(script.buffer.size());
-                script.bytecodeLen = static_cast<u32>(script.bytecode.size());
-
-                auto result = script.serialize();
+                script.compressedLen = static_cast<u32>(stack.size());
+                script.bytecodeLen = static_cast<u32>(std::get<0>(outbin).size);
+                script.buffer = stack.data();
+                script.bytecode = std::get<0>(outbin).data;
 
                 if (!dry_run)
-                    utils::file::save(fs::path{ "assembled" } / rel, result);
+                    utils::file::save(fs::path{ "assembled" } / rel, [&](std::ostream& stream) { script.serialize(stream); });
 
-                std::cout << std::format("assembled {}\n", rel.generic_string());
+                out << std::format("assembled {}\n", rel.generic_string());
             }
         }
 
@@ -227,17 +511,20 @@ auto assemble_file(game game, mach mach, fs::path file, fs::path rel) -> result
     }
     catch (std::exception const& e)
     {
-        std::cerr << std::format("{} at {}\n", e.what(), file.generic_string());
+        err << std::format("{} at {}\n", e.what(), file.generic_string());
         return result::failure;
     }
 }
 
-auto disassemble_file(game game, mach mach, fs::path file, fs::path rel) -> result
+auto disassemble_file(context& ctx, game game, fs::path file, fs::path rel, std::ostream& out, std::ostream& err) -> result
 {
     try
     {
-        auto script = std::vector<std::uint8_t>{};
-        auto stack = std::vector<std::uint8_t>{};
+        auto script_file = utils::mapped_file{};
+        auto stack_file = utils::mapped_file{};
+        auto stack_data = std::vector<std::uint8_t>{};
+        auto script = buffer{};
+        auto stack = buffer{};
 
         if (zonetool)
         {
@@ -247,110 +534,138 @@ auto disassemble_file(game game, mach mach, fs::path file, fs::path rel) -> resu
             auto fbuf = file;
             rel = fs::path{ games_rev.at(game) } / rel / file.filename().replace_extension(".gsc");
 
-            script = utils::file::read(file);
-            stack = utils::file::read(fbuf.replace_extension(".cgsc.stack"));
+            script_file = utils::mapped_file{ file };
+            stack_file = utils::mapped_file{ fbuf.replace_extension(".cgsc.stack") };
+            script = buffer{ script_file.data(), script_file.size() };
+            stack = buffer{ stack_file.data(), stack_file.size() };
         }
         else
         {
             rel = fs::path{ games_rev.at(game) } / rel / file.filename().replace_extension(file.extension() == ".gscbin" ? ".gscasm" : ".cscasm");
 
-            auto data = utils::file::read(file);
+            script_file = utils::mapped_file{ file };
 
-            asset asset;
-            asset.deserialize(data);
+            auto asset = asset_view{};
+            asset.deserialize(script_file.data(), script_file.size());
 
-            script = std::move(asset.bytecode);
-            stack = utils::zlib::decompress(asset.buffer, asset.len);
+            stack_data = utils::zlib::decompress(asset.buffer, asset.compressedLen, asset.len);
+            script = buffer{ asset.bytecode, asset.bytecodeLen };
+            stack = buffer{ stack_data.data(), stack_data.size() };
         }
 
-        auto outasm = contexts[game][mach]->disassembler().disassemble(script, stack);
-        auto outsrc = contexts[game][mach]->source().dump(*outasm);
+        auto outasm = ctx.disassembler().disassemble(script, stack);
+        auto outsrc = ctx.source().dump(*outasm);
 
         if (!dry_run)
             utils::file::save(fs::path{ "disassembled" } / rel, outsrc);
 
-        std::cout << std::format("disassembled {}\n", rel.generic_string());
+        out << std::format("disassembled {}\n", rel.generic_string());
         return result::success;
     }
     catch (std::exception const& e)
     {
-        std::cerr << std::format("{} at {}\n", e.what(), file.generic_string());
+        err << std::format("{} at {}\n", e.what(), file.generic_string());
         return result::failure;
     }
 }
 
-auto compile_file(game game, mach mach, fs::path file, fs::path rel) -> result
+auto compile_file(context& ctx, game game, fs::path file, fs::path rel, std::ostream& out, std::ostream& err) -> result
 {
     try
     {
         rel = fs::path{ games_rev.at(game) } / rel / file.filename().replace_extension((zonetool ? ".cgsc" : ".gscbin"));
 
         auto data = utils::file::read(file);
-        auto outasm = contexts[game][mach]->compiler().compile(file.string(), data);
-        auto outbin = contexts[game][mach]->assembler().assemble(*outasm);
+        auto const name = file.string();
+        auto const key = cache::key(mode::compile, { { reinterpret_cast<u8 const*>(name.data()), name.size() }, { data.data(), data.size() } });
+        auto const digest = [&ctx](std::string const& name) { return cache::digest(fs_path(&ctx, name)); };
+        auto const devmap = !zonetool && (ctx.build() & build::dev_maps) != build::prod;
+        auto outputs = std::vector<fs::path>{ fs::path{ "compiled" } / rel };
 
-        if (true/*overwrite_prompt(file + (zonetool ? ".cgsc" : ".gscbin"))*/)
+        if (zonetool)
+            outputs.push_back(fs::path{ outputs[0] }.replace_extension(".cgsc.stack"));
+        else if (devmap)
+            outputs.push_back(fs::path{ "compiled" } / fs::path{ "developer_maps" } / fs::path{ rel }.replace_extension(".gscmap"));
+
+        auto deps = std::vector<std::string>{};
+        auto report = std::string{};
+
+        if (!cache::fetch(key, outputs, digest, &deps, &report))
         {
-            if (zonetool)
+            auto outasm = function_pool ? ctx.compiler().compile(name, data, *function_pool) : ctx.compiler().compile(name, data);
+
+            if (optimize)
             {
-                auto path = fs::path{ "compiled" } / rel;
+                auto const [before, after] = ctx.optimizer().optimize(*outasm);
+                report = std::format("optimized {} ({} -> {} bytes)\n", rel.generic_string(), before, after);
+            }
+
+            auto outbin = ctx.assembler().assemble(*outasm);
+
+            deps = ctx.dependencies();
 
+            if (zonetool)
+            {
                 if (!dry_run)
                 {
-                    utils::file::save(path, std::get<0>(outbin).data, std::get<0>(outbin).size);
-                    utils::file::save(path.replace_extension(".cgsc.stack"), std::get<1>(outbin).data, std::get<1>(outbin).size);
+                    utils::file::save(outputs[0], std::get<0>(outbin).data, std::get<0>(outbin).size);
+                    utils::file::save(outputs[1], std::get<1>(outbin).data, std::get<1>(outbin).size);
                 }
-
-                std::cout << std::format("compiled {}\n", rel.generic_string());
             }
             else
             {
-                asset script;
-                script.name = "GSC"s;
-
-                script.bytecode.resize(std::get<0>(outbin).size);
-                std::memcpy(script.bytecode.data(), std::get<0>(outbin).data, script.bytecode.size());
-
-                script.buffer.resize(std::get<1>(outbin).size);
-                std::memcpy(script.buffer.data(), std::get<1>(outbin).data, script.buffer.size());
-                script.buffer = utils::zlib::compress(script.buffer);
-
-                script.len = static_cast<std::uint32_t>(std::get<1>(outbin).size);
-                script.compressedLen = static_cast<std::uint32_t>(script.buffer.size());
-                script.bytecodeLen = static_cast<std::uint32_t>(script.bytecode.size());
+                auto stack = utils::zlib::compress(std::get<1>(outbin).data, std::get<1>(outbin).size);
 
-                auto result = script.serialize();
+                asset_view script;
+                script.name = "GSC"sv;
+                script.len = static_cast<u32>(std::get<1>(outbin).size);
+                script.compressedLen = static_cast<u32>(stack.size());
+                script.bytecodeLen = static_cast<u32>(std::get<0>(outbin).size);
+                script.buffer = stack.data();
+                script.bytecode = std::get<0>(outbin).data;
 
                 if (!dry_run)
-                    utils::file::save(fs::path{ "compiled" } / rel, result);
-
-                std::cout << std::format("compiled {}\n", rel.generic_string());
-
-                if ((contexts[game][mach]->build() & build::dev_maps) != build::prod)
                 {
-                    if (!dry_run)
-                        utils::file::save(fs::path{ "compiled" } / fs::path{ "developer_maps" } / rel.replace_extension(".gscmap"), std::get<2>(outbin).data, std::get<2>(outbin).size);
+                    utils::file::save(outputs[0], [&](std::ostream& stream) { script.serialize(stream); });
 
-                    std::cout << std::format("saved developer map {}\n", rel.generic_string());
+                    if (devmap)
+                        utils::file::save(outputs[1], std::get<2>(outbin).data, std::get<2>(outbin).size);
                 }
             }
+
+            cache::store(key, outputs, deps, digest, report);
         }
 
+        watch::record(file, deps, [&ctx](std::string const& name) { return fs_path(&ctx, name); }, false);
+
+        out << report;
+        out << std::format("compiled {}\n", rel.generic_string());
+
+        if (devmap)
+            out << std::format("saved developer map {}\n", rel.replace_extension(".gscmap").generic_string());
+
         return result::success;
     }
     catch (std::exception const& e)
     {
-        std::cerr << std::format("{} at {}\n", e.what(), file.generic_string());
+        // the headers & includes read before the error are watched too, so fixing them retries the file
+        watch::record(file, ctx.dependencies(), [&ctx](std::string const& name) { return fs_path(&ctx, name); }, true);
+
+        err << std::format("{} at {}\n", e.what(), file.generic_string());
         return result::failure;
     }
 }
 
-auto decompile_file(game game, mach mach, fs::path file, fs::path rel) -> result
+auto decompile_file(context& ctx, game game, fs::path file, fs::path rel, std::ostream& out, std::ostream& err) -> result
 {
     try
     {
-        auto script = std::vector<std::uint8_t>{};
-        auto stack = std::vector<std::uint8_t>{};
+        auto script_file = utils::mapped_file{};
+        auto stack_file = utils::mapped_file{};
+        auto stack_data = std::vector<std::uint8_t>{};
+        auto asset = asset_view{};
+        auto script = buffer{};
+        auto stack = buffer{};
 
         if (zonetool)
         {
@@ -360,40 +675,52 @@ auto decompile_file(game game, mach mach, fs::path file, fs::path rel) -> result
             auto fbuf = file;
             rel = fs::path{ games_rev.at(game) } / rel / file.filename().replace_extension(".gsc");
 
-            script = utils::file::read(file);
-            stack = utils::file::read(fbuf.replace_extension(".cgsc.stack"));
+            script_file = utils::mapped_file{ file };
+            stack_file = utils::mapped_file{ fbuf.replace_extension(".cgsc.stack") };
+            script = buffer{ script_file.data(), script_file.size() };
+            stack = buffer{ stack_file.data(), stack_file.size() };
         }
         else
         {
             rel = fs::path{ games_rev.at(game) } / rel / file.filename().replace_extension((file.extension() == ".gscbin" ? ".gsc" : ".csc"));
 
-            auto data = utils::file::read(file);
+            script_file = utils::mapped_file{ file };
+            asset.deserialize(script_file.data(), script_file.size());
+            script = buffer{ asset.bytecode, asset.bytecodeLen };
+        }
 
-            asset asset;
-            asset.deserialize(data);
+        auto const key = cache::key(mode::decompile, { { script_file.data(), script_file.size() }, { stack_file.data(), stack_file.size() } });
+        auto const outputs = std::vector<fs::path>{ fs::path{ "decompiled" } / rel };
 
-            script = std::move(asset.bytecode);
-            stack = utils::zlib::decompress(asset.buffer, asset.len);
-        }
+        if (!cache::fetch(key, outputs, {}))
+        {
+            if (!zonetool)
+            {
+                stack_data = utils::zlib::decompress(asset.buffer, asset.compressedLen, asset.len);
+                stack = buffer{ stack_data.data(), stack_data.size() };
+            }
 
-        auto outasm = contexts[game][mach]->disassembler().disassemble(script, stack);
-        auto outast = contexts[game][mach]->decompiler().decompile(*outasm);
-        auto outsrc = contexts[game][mach]->source().dump(*outast);
+            auto outasm = ctx.disassembler().disassemble(script, stack);
+            auto outast = function_pool ? ctx.decompiler().decompile(*outasm, *function_pool) : ctx.decompiler().decompile(*outasm);
+            auto outsrc = ctx.source().dump(*outast);
 
-        if (!dry_run)
-            utils::file::save(fs::path{ "decompiled" } / rel, outsrc);
+            if (!dry_run)
+                utils::file::save(outputs[0], outsrc);
+
+            cache::store(key, outputs, {}, {});
+        }
 
-        std::cout << std::format("decompiled {}\n", rel.generic_string());
+        out << std::format("decompiled {}\n", rel.generic_string());
         return result::success;
     }
     catch (std::exception const& e)
     {
-        std::cerr << std::format("{} at {}\n", e.what(), file.generic_string());
+        err << std::format("{} at {}\n", e.what(), file.generic_string());
         return result::failure;
     }
 }
 
-auto parse_file(game game, mach mach, fs::path file, fs::path rel) -> result
+auto parse_file(context& ctx, game game, fs::path file, fs::path rel, std::ostream& out, std::ostream& err) -> result
 {
     try
     {
@@ -401,22 +728,22 @@ auto parse_file(game game, mach mach, fs::path file, fs::path rel) -> result
 
         auto data = utils::file::read(file);
 
-        auto prog = contexts[game][mach]->source().parse_program(file.string(), data);
+        auto prog = ctx.source().parse_program(file.string(), data);
 
         if (!dry_run)
-            utils::file::save(fs::path{ "parsed" } / rel, contexts[game][mach]->source().dump(*prog));
+            utils::file::save(fs::path{ "parsed" } / rel, ctx.source().dump(*prog));
 
-        std::cout << std::format("parsed {}\n", rel.generic_string());
+        out << std::format("parsed {}\n", rel.generic_string());
         return result::success;
     }
     catch (std::exception const& e)
     {
-        std::cerr << std::format("{} at {}\n", e.what(), file.generic_string());
+        err << std::format("{} at {}\n", e.what(), file.generic_string());
         return result::failure;
     }
 }
 
-auto rename_file(game game, mach mach, fs::path file, fs::path rel) -> result
+auto rename_file(context& ctx, game game, fs::path file, fs::path rel, std::ostream& out, std::ostream& err) -> result
 {
     try
     {
@@ -436,11 +763,11 @@ auto rename_file(game game, mach mach, fs::path file, fs::path rel) -> result
 
             if (utils::string::is_number(name))
             {
-                name = contexts[game][mach]->token_name(std::stoul(name));
+                name = ctx.token_name(std::stoul(name));
             }
             else if (utils::string::is_hex_number(name))
             {
-                name = contexts[game][mach]->token_name(std::stoul(name, nullptr, 16));
+                name = ctx.token_name(std::stoul(name, nullptr, 16));
             }
 
             if (!name.starts_with("_id_"))
@@ -459,7 +786,7 @@ auto rename_file(game game, mach mach, fs::path file, fs::path rel) -> result
         if (!dry_run)
             utils::file::save(fs::path{ "renamed" } / rel, data);
 
-        std::cout << std::format("renamed {} -> {}\n", file.filename().generic_string(), rel.generic_string());
+        out << std::format("renamed {} -> {}\n", file.filename().generic_string(), rel.generic_string());
 
         if (zt)
         {
@@ -468,24 +795,23 @@ auto rename_file(game game, mach mach, fs::path file, fs::path rel) -> result
             if (!dry_run)
                 utils::file::save(fs::path{ "renamed" } / rel.replace_extension(".cgsc.stack"), stack);
 
-            std::cout << std::format("renamed {} -> {}\n", file.filename().generic_string(), rel.generic_string());
+            out << std::format("renamed {} -> {}\n", file.filename().generic_string(), rel.generic_string());
         }
 
         return result::success;
     }
     catch (std::exception const& e)
     {
-        std::cerr << std::format("{} at {}\n", e.what(), file.generic_string());
+        err << std::format("{} at {}\n", e.what(), file.generic_string());
         return result::failure;
     }
 }
 
 std::unordered_map<std::string, std::vector<std::uint8_t>> files;
+std::mutex files_mutex;
 
 auto fs_read(context const* ctx, std::string const& name) -> std::pair<buffer, std::vector<u8>>
 {
-    auto path = fs::path{ name };
-
     auto bin_ext = ".gscbin";
     auto gsc_ext = ".gsc";
     auto gsh_ext = ".gsh";
@@ -496,22 +822,7 @@ auto fs_read(context const* ctx, std::string const& name) -> std::pair<buffer, s
         gsc_ext = ".csc";
     }
 
-    if (!utils::file::exists(path))
-    {
-        auto const name_noext = path.replace_extension("").string();
-
-        auto id = ctx->token_id(name_noext);
-        if (id > 0)
-        {
-            path = fs::path{ std::to_string(id) + bin_ext };
-        }
-
-        if (!utils::file::exists(path))
-        {
-            path = fs::path{ name_noext + bin_ext };
-        }
-    }
-
+    auto const path = fs_path(ctx, name);
     auto data = utils::file::read(path);
 
     if (path.extension().string() == bin_ext || (path.extension().string() != gsh_ext && path.extension().string() != gsc_ext))
@@ -519,12 +830,12 @@ auto fs_read(context const* ctx, std::string const& name) -> std::pair<buffer, s
         asset s;
         s.deserialize(data);
         auto stk = utils::zlib::decompress(s.buffer, s.len);
-        auto res = files.insert({ path.filename().string(), std::move(s.bytecode)});
 
-        if (res.second)
-        {
-            return { {res.first->second.data(), res.first->second.size() }, std::move(stk) };
-        }
+        // workers share the bytecode cache, so the file may be already loaded by another context
+        auto lock = std::unique_lock{ files_mutex };
+        auto res = files.try_emplace(path.filename().string(), std::move(s.bytecode));
+
+        return { {res.first->second.data(), res.first->second.size() }, std::move(stk) };
     }
     else
     {
@@ -534,213 +845,147 @@ auto fs_read(context const* ctx, std::string const& name) -> std::pair<buffer, s
     throw std::runtime_error("file read error");
 }
 
-auto init_iw5(mach mach, inst inst, bool dev) -> void
+auto make_iw5(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::iw5].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::iw5][mach] = std::make_unique<iw5_pc::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::iw5][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<iw5_pc::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         case mach::ps3:
-        {
-            contexts[game::iw5][mach] = std::make_unique<iw5_ps::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::iw5][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<iw5_ps::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         case mach::xb2:
-        {
-            contexts[game::iw5][mach] = std::make_unique<iw5_xb::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::iw5][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<iw5_xb::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_iw6(mach mach, inst inst, bool dev) -> void
+auto make_iw6(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::iw6].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::iw6][mach] = std::make_unique<iw6_pc::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::iw6][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<iw6_pc::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         case mach::ps3:
-        {
-            contexts[game::iw6][mach] = std::make_unique<iw6_ps::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::iw6][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<iw6_ps::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         case mach::xb2:
-        {
-            contexts[game::iw6][mach] = std::make_unique<iw6_xb::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::iw6][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<iw6_xb::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_iw7(mach mach, inst inst, bool dev) -> void
+auto make_iw7(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::iw7].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::iw7][mach] = std::make_unique<iw7::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::iw7][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<iw7::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_iw8(mach mach, inst inst, bool dev) -> void
+auto make_iw8(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::iw8].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::iw8][mach] = std::make_unique<iw8::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::iw8][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<iw8::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_iw9(mach mach, inst inst, bool dev) -> void
+auto make_iw9(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::iw9].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::iw9][mach] = std::make_unique<iw9::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::iw9][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<iw9::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_s1(mach mach, inst inst, bool dev) -> void
+auto make_s1(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::s1].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::s1][mach] = std::make_unique<s1_pc::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::s1][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<s1_pc::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         case mach::ps3:
-        {
-            contexts[game::s1][mach] = std::make_unique<s1_ps::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::s1][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<s1_ps::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         case mach::xb2:
-        {
-            contexts[game::s1][mach] = std::make_unique<s1_xb::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::s1][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<s1_xb::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_s2(mach mach, inst inst, bool dev) -> void
+auto make_s2(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::s2].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::s2][mach] = std::make_unique<s2::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::s2][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<s2::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_s4(mach mach, inst inst, bool dev) -> void
+auto make_s4(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::s4].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::s4][mach] = std::make_unique<s4::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::s4][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<s4::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_h1(mach mach, inst inst, bool dev) -> void
+auto make_h1(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::h1].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::h1][mach] = std::make_unique<h1::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::h1][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<h1::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_h2(mach mach, inst inst, bool dev) -> void
+auto make_h2(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::h2].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::h2][mach] = std::make_unique<h2::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
-            contexts[game::h2][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<h2::context>(inst == inst::client ? gsc::instance::client : gsc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init(game game, mach mach, inst inst, bool dev) -> void
+auto make(game game, mach mach, inst inst) -> std::unique_ptr<context>
+{
+    switch (game)
+    {
+        case game::iw5: return make_iw5(mach, inst);
+        case game::iw6: return make_iw6(mach, inst);
+        case game::iw7: return make_iw7(mach, inst);
+        case game::iw8: return make_iw8(mach, inst);
+        case game::iw9: return make_iw9(mach, inst);
+        case game::s1:  return make_s1(mach, inst);
+        case game::s2:  return make_s2(mach, inst);
+        case game::s4:  return make_s4(mach, inst);
+        case game::h1:  return make_h1(mach, inst);
+        case game::h2:  return make_h2(mach, inst);
+        default: return nullptr;
+    }
+}
+
+auto init(game game, mach mach, inst inst, bool dev, usize count) -> void
 {
     funcs[mode::assemble] = assemble_file;
     funcs[mode::disassemble] = disassemble_file;
@@ -749,25 +994,37 @@ auto init(game game, mach mach, inst inst, bool dev) -> void
     funcs[mode::parse] = parse_file;
     funcs[mode::rename] = rename_file;
 
-    if (!contexts.contains(game))
+    contexts = &pools[{ game, mach, inst }];
+
+    auto& shared = headers[{ game, mach, inst }];
+
+    if (shared == nullptr)
     {
-        contexts.insert({ game, std::map<xsk::mach, std::unique_ptr<context>>() });
+        shared = std::make_shared<header_cache>();
+
+        if (cache::enabled())
+            shared->load(headers_path());
     }
 
-    switch (game)
+    // one context per worker, they keep compiler & include state between files
+    while (contexts->size() < count)
+    {
+        auto ctx = make(game, mach, inst);
+
+        if (ctx == nullptr) return;
+
+        contexts->push_back(std::move(ctx));
+    }
+
+    // sources may have changed since a previous run on these contexts
+    for (auto& ctx : *contexts)
     {
-        case game::iw5: init_iw5(mach, inst, dev); break;
-        case game::iw6: init_iw6(mach, inst, dev); break;
-        case game::iw7: init_iw7(mach, inst, dev); break;
-        case game::iw8: init_iw8(mach, inst, dev); break;
-        case game::iw9: init_iw9(mach, inst, dev); break;
-        case game::s1:  init_s1(mach, inst, dev);  break;
-        case game::s2:  init_s2(mach, inst, dev);  break;
-        case game::s4:  init_s4(mach, inst, dev);  break;
-        case game::h1:  init_h1(mach, inst, dev);  break;
-        case game::h2:  init_h2(mach, inst, dev);  break;
-        default: break;
+        ctx->init(dev ? build::dev : build::prod, fs_read);
+        ctx->cleanup();
+        ctx->headers(shared);
     }
+
+    files.clear();
 }
 
 } // namespace xsk::gsc
@@ -775,11 +1032,12 @@ auto init(game game, mach mach, inst inst, bool dev) -> void
 namespace arc
 {
 
-std::map<game, std::map<mach, std::unique_ptr<context>>> contexts;
-std::map<mode, std::function<result(game game, mach mach, fs::path const& file, fs::path rel)>> funcs;
+std::map<std::tuple<game, mach, inst, bool>, std::vector<std::unique_ptr<context>>> pools;
+std::vector<std::unique_ptr<context>>* contexts = nullptr;
+std::map<mode, std::function<result(context& ctx, game game, fs::path const& file, fs::path rel, std::ostream& out, std::ostream& err)>> funcs;
 bool t6fixup = false;
 
-auto assemble_file(game game, mach mach, fs::path const& file, fs::path rel) -> result
+auto assemble_file(context& ctx, game game, fs::path const& file, fs::path rel, std::ostream& out, std::ostream& err) -> result
 {
     try
     {
@@ -792,27 +1050,27 @@ auto assemble_file(game game, mach mach, fs::path const& file, fs::path rel) ->
 
         if (data.size() >= 4 && !std::memcmp(&data[0], "\x80GSC", 4))
         {
-            std::cerr << std::format("{} at {}\n", "already assembled", file.generic_string());
+            err << std::format("{} at {}\n", "already assembled", file.generic_string());
             return result::success;
         }
 
-        auto outasm = contexts[game][mach]->source().parse_assembly(data);
-        auto outbin = contexts[game][mach]->assembler().assemble(*outasm);
+        auto outasm = ctx.source().parse_assembly(data);
+        auto outbin = ctx.assembler().assemble(*outasm);
 
         if (!dry_run)
             utils::file::save(fs::path{ "assembled" } / rel, outbin.first.data, outbin.first.size);
 
-        std::cout << std::format("assembled {}\n", rel.generic_string());
+        out << std::format("assembled {}\n", rel.generic_string());
         return result::success;
     }
     catch (std::exception const& e)
     {
-        std::cerr << std::format("{} at {}\n", e.what(), file.generic_string());
+        err << std::format("{} at {}\n", e.what(), file.generic_string());
         return result::failure;
     }
 }
 
-auto disassemble_file(game game, mach mach, fs::path const& file, fs::path rel) -> result
+auto disassemble_file(context& ctx, game game, fs::path const& file, fs::path rel, std::ostream& out, std::ostream& err) -> result
 {
     try
     {
@@ -821,24 +1079,24 @@ auto disassemble_file(game game, mach mach, fs::path const& file, fs::path rel)
 
         rel = fs::path{ games_rev.at(game) } / rel / file.filename().replace_extension((file.extension().string().starts_with(".gsc") ? ".gscasm" : ".cscasm"));
 
-        auto data = utils::file::read(file.string());
-        auto outasm = contexts[game][mach]->disassembler().disassemble(data);
-        auto outsrc = contexts[game][mach]->source().dump(*outasm);
+        auto data = utils::mapped_file{ file };
+        auto outasm = ctx.disassembler().disassemble(data.data(), data.size());
+        auto outsrc = ctx.source().dump(*outasm);
 
         if (!dry_run)
             utils::file::save(fs::path{ "disassembled" } / rel, outsrc);
 
-        std::cout << std::format("disassembled {}\n", rel.generic_string());
+        out << std::format("disassembled {}\n", rel.generic_string());
         return result::success;
     }
     catch (std::exception const& e)
     {
-        std::cerr << std::format("{} at {}\n", e.what(), file.generic_string());
+        err << std::format("{} at {}\n", e.what(), file.generic_string());
         return result::failure;
     }
 }
 
-auto compile_file(game game, mach mach, fs::path const& file, fs::path rel) -> result
+auto compile_file(context& ctx, game game, fs::path const& file, fs::path rel, std::ostream& out, std::ostream& err) -> result
 {
     try
     {
@@ -851,36 +1109,60 @@ auto compile_file(game game, mach mach, fs::path const& file, fs::path rel) -> r
 
         if (data.size() >= 4 && !std::memcmp(&data[0], "\x80GSC", 4))
         {
-            std::cerr << std::format("{} at {}\n", "already compiled", file.generic_string());
+            err << std::format("{} at {}\n", "already compiled", file.generic_string());
             return result::success;
         }
 
-        auto outasm = contexts[game][mach]->compiler().compile(file.string(), data);
-        auto outbin = contexts[game][mach]->assembler().assemble(*outasm);
+        auto const name = file.string();
+        auto const key = cache::key(mode::compile, { { reinterpret_cast<u8 const*>(name.data()), name.size() }, { data.data(), data.size() } });
+        auto const digest = [](std::string const& name) { return cache::digest(fs::path{ name }); };
+        auto const devmap = (ctx.build() & build::dev_maps) != build::prod;
+        auto const mapext = rel.extension().string().starts_with(".gsc") ? ".gscmap" : ".cscmap";
+        auto outputs = std::vector<fs::path>{ fs::path{ "compiled" } / rel };
 
-        if (!dry_run)
-            utils::file::save(fs::path{ "compiled" } / rel, outbin.first.data, outbin.first.size);
+        if (devmap)
+            outputs.push_back(fs::path{ "compiled" } / fs::path{ "developer_maps" } / fs::path{ rel }.replace_extension(mapext));
 
-        std::cout << std::format("compiled {}\n", rel.generic_string());
+        auto deps = std::vector<std::string>{};
 
-        if ((contexts[game][mach]->build() & build::dev_maps) != build::prod)
+        if (!cache::fetch(key, outputs, digest, &deps))
         {
+            auto outasm = ctx.compiler().compile(name, data);
+            auto outbin = ctx.assembler().assemble(*outasm);
+
+            deps = ctx.dependencies();
+
             if (!dry_run)
-                utils::file::save(fs::path{ "compiled" } / fs::path{ "developer_maps" } / rel.replace_extension((rel.extension().string().starts_with(".gsc") ? ".gscmap" : ".cscmap")), outbin.second.data, outbin.second.size);
+            {
+                utils::file::save(outputs[0], outbin.first.data, outbin.first.size);
+
+                if (devmap)
+                    utils::file::save(outputs[1], outbin.second.data, outbin.second.size);
+            }
 
-            std::cout << std::format("saved developer map {}\n", rel.generic_string());
+            cache::store(key, outputs, deps, digest);
         }
 
+        watch::record(file, deps, [](std::string const& name) { return fs::path{ name }; }, false);
+
+        out << std::format("compiled {}\n", rel.generic_string());
+
+        if (devmap)
+            out << std::format("saved developer map {}\n", rel.replace_extension(mapext).generic_string());
+
         return result::success;
     }
     catch (std::exception const& e)
     {
-        std::cerr << std::format("{} at {}\n", e.what(), file.generic_string());
+        // the headers & includes read before the error are watched too, so fixing them retries the file
+        watch::record(file, ctx.dependencies(), [](std::string const& name) { return fs::path{ name }; }, true);
+
+        err << std::format("{} at {}\n", e.what(), file.generic_string());
         return result::failure;
     }
 }
 
-auto decompile_file(game game, mach mach, fs::path const& file, fs::path rel) -> result
+auto decompile_file(context& ctx, game game, fs::path const& file, fs::path rel, std::ostream& out, std::ostream& err) -> result
 {
     try
     {
@@ -889,26 +1171,33 @@ auto decompile_file(game game, mach mach, fs::path const& file, fs::path rel) ->
 
         rel = fs::path{ games_rev.at(game) } / rel / file.filename();
 
-        auto data = utils::file::read(file);
+        auto data = utils::mapped_file{ file };
+        auto const key = cache::key(mode::decompile, { { data.data(), data.size() } });
+        auto const outputs = std::vector<fs::path>{ fs::path{ "decompiled" } / rel };
 
-        auto outasm = contexts[game][mach]->disassembler().disassemble(data);
-        auto outsrc = contexts[game][mach]->decompiler().decompile(*outasm);
-        auto output = contexts[game][mach]->source().dump(*outsrc);
+        if (!cache::fetch(key, outputs, {}))
+        {
+            auto outasm = ctx.disassembler().disassemble(data.data(), data.size());
+            auto outsrc = ctx.decompiler().decompile(*outasm);
+            auto output = ctx.source().dump(*outsrc);
 
-        if (!dry_run)
-            utils::file::save(fs::path{ "decompiled" } / rel, output);
+            if (!dry_run)
+                utils::file::save(outputs[0], output);
+
+            cache::store(key, outputs, {}, {});
+        }
 
-        std::cout << std::format("decompiled {}\n", rel.generic_string());
+        out << std::format("decompiled {}\n", rel.generic_string());
         return result::success;
     }
     catch (std::exception const& e)
     {
-        std::cerr << std::format("{} at {}\n", e.what(), file.generic_string());
+        err << std::format("{} at {}\n", e.what(), file.generic_string());
         return result::failure;
     }
 }
 
-auto parse_file(game game, mach mach, fs::path file, fs::path rel) -> result
+auto parse_file(context& ctx, game game, fs::path file, fs::path rel, std::ostream& out, std::ostream& err) -> result
 {
     try
     {
@@ -921,28 +1210,28 @@ auto parse_file(game game, mach mach, fs::path file, fs::path rel) -> result
 
         if (data.size() >= 4 && !std::memcmp(&data[0], "\x80GSC", 4))
         {
-            std::cerr << std::format("{} at {}\n", "already compiled", file.generic_string());
+            err << std::format("{} at {}\n", "already compiled", file.generic_string());
             return result::success;
         }
 
-        auto prog = contexts[game][mach]->source().parse_program(file.string(), data);
+        auto prog = ctx.source().parse_program(file.string(), data);
 
         if (!dry_run)
-            utils::file::save(fs::path{ "parsed" } / rel, contexts[game][mach]->source().dump(*prog));
+            utils::file::save(fs::path{ "parsed" } / rel, ctx.source().dump(*prog));
 
-        std::cout << std::format("parsed {}\n", rel.generic_string());
+        out << std::format("parsed {}\n", rel.generic_string());
         return result::success;
     }
     catch (std::exception const& e)
     {
-        std::cerr << std::format("{} at {}\n", e.what(), file.generic_string());
+        err << std::format("{} at {}\n", e.what(), file.generic_string());
         return result::failure;
     }
 }
 
-auto rename_file(game, mach, fs::path const&, fs::path) -> result
+auto rename_file(context&, game, fs::path const&, fs::path, std::ostream&, std::ostream& err) -> result
 {
-    std::cerr << std::format("not implemented for treyarch\n");
+    err << std::format("not implemented for treyarch\n");
     return result::failure;
 }
 
@@ -951,111 +1240,85 @@ auto fs_read(std::string const& name) -> std::vector<u8>
     return utils::file::read(fs::path{ name });
 }
 
-auto init_t6(mach mach, inst inst, bool dev) -> void
+auto make_t6(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::t6].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
         {
-            contexts[game::t6][mach] = std::make_unique<t6::pc::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
-            contexts[game::t6][mach]->init(dev ? build::dev : build::prod, fs_read);
-            contexts[game::t6][mach]->fixup(t6fixup);
-            break;
+            auto ctx = std::make_unique<t6::pc::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
+            ctx->fixup(t6fixup);
+            return ctx;
         }
         case mach::ps3:
-        {
-            contexts[game::t6][mach] = std::make_unique<t6::ps3::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
-            contexts[game::t6][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<t6::ps3::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
         case mach::xb2:
-        {
-            contexts[game::t6][mach] = std::make_unique<t6::xb2::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
-            contexts[game::t6][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<t6::xb2::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
         case mach::wiiu:
-        {
-            contexts[game::t6][mach] = std::make_unique<t6::wiiu::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
-            contexts[game::t6][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<t6::wiiu::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_t7(mach mach, inst inst, bool dev) -> void
+auto make_t7(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::t7].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::t7][mach] = std::make_unique<t7::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
-            contexts[game::t7][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<t7::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_t8(mach mach, inst inst, bool dev) -> void
+auto make_t8(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::t8].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::t8][mach] = std::make_unique<t8::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
-            contexts[game::t8][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<t8::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_t9(mach mach, inst inst, bool dev) -> void
+auto make_t9(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::t9].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::t9][mach] = std::make_unique<t9::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
-            contexts[game::t9][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<t9::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init_jup(mach mach, inst inst, bool dev) -> void
+auto make_jup(mach mach, inst inst) -> std::unique_ptr<context>
 {
-    if (contexts[game::jup].contains(mach)) return;
-
     switch (mach)
     {
         case mach::pc:
-        {
-            contexts[game::jup][mach] = std::make_unique<jup::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
-            contexts[game::jup][mach]->init(dev ? build::dev : build::prod, fs_read);
-            break;
-        }
+            return std::make_unique<jup::context>(inst == inst::client ? arc::instance::client : arc::instance::server);
         default:
             throw std::runtime_error("not implemented");
     }
 }
 
-auto init(game game, mach mach, inst inst, bool dev) -> void
+auto make(game game, mach mach, inst inst) -> std::unique_ptr<context>
+{
+    switch (game)
+    {
+        case game::t6: return make_t6(mach, inst);
+        case game::t7: return make_t7(mach, inst);
+        case game::t8: return make_t8(mach, inst);
+        case game::t9: return make_t9(mach, inst);
+        case game::jup: return make_jup(mach, inst);
+        default: return nullptr;
+    }
+}
+
+auto init(game game, mach mach, inst inst, bool dev, usize count) -> void
 {
     funcs[mode::assemble] = assemble_file;
     funcs[mode::disassemble] = disassemble_file;
@@ -1064,19 +1327,21 @@ auto init(game game, mach mach, inst inst, bool dev) -> void
     funcs[mode::parse] = parse_file;
     funcs[mode::rename] = rename_file;
 
-    if (!contexts.contains(game))
+    contexts = &pools[{ game, mach, inst, t6fixup }];
+
+    while (contexts->size() < count)
     {
-        contexts.insert({ game, std::map<xsk::mach, std::unique_ptr<context>>() });
+        auto ctx = make(game, mach, inst);
+
+        if (ctx == nullptr) return;
+
+        contexts->push_back(std::move(ctx));
     }
 
-    switch (game)
+    for (auto& ctx : *contexts)
     {
-        case game::t6: init_t6(mach, inst, dev); break;
-        case game::t7: init_t7(mach, inst, dev); break;
-        case game::t8: init_t8(mach, inst, dev); break;
-        case game::t9: init_t9(mach, inst, dev); break;
-        case game::jup: init_jup(mach, inst, dev); break;
-        default: break;
+        ctx->init(dev ? build::dev : build::prod, fs_read);
+        ctx->cleanup();
     }
 }
 
@@ -1103,29 +1368,94 @@ auto extension_match(fs::path const& ext, mode mode, game game) -> bool
     }
 }
 
-auto execute(mode mode, game game, mach mach, inst inst, fs::path const& path, bool dev) -> result
+auto execute_file(mode mode, game game, usize worker, fs::path const& file, fs::path const& rel, std::ostream& out, std::ostream& err) -> result
 {
-    gsc::init(game, mach, inst, dev);
-    arc::init(game, mach, inst, dev);
+    if (game < game::t6)
+        return gsc::funcs[mode](*(*gsc::contexts)[worker], game, file, rel, out, err);
+    else
+        return arc::funcs[mode](*(*arc::contexts)[worker], game, fs::path{ file.generic_string(), fs::path::format::generic_format }, rel, out, err);
+}
 
-    if (fs::is_directory(path))
+auto execute_batch(mode mode, game game, std::vector<std::pair<fs::path, fs::path>> const& files, utils::thread_pool& pool) -> result
+{
+    struct output
+    {
+        std::ostringstream out;
+        std::ostringstream err;
+        result res = result::success;
+        bool done = false;
+    };
+
+    auto exit_code = result::success;
+    auto outputs = std::vector<output>(files.size());
+    auto next = usize{ 0 };
+    auto mutex = std::mutex{};
+
+    pool.run(files.size(), [&](usize index, usize worker)
     {
-        auto exit_code = result::success;
+        auto& entry = outputs[index];
+        auto error = std::exception_ptr{};
 
-        for (auto const& entry : fs::recursive_directory_iterator(path))
+        try
         {
-            if (entry.is_regular_file() && extension_match(entry.path().extension(), mode, game))
-            {
-                auto rel = fs::relative(entry, path).remove_filename();
+            entry.res = execute_file(mode, game, worker, files[index].first, files[index].second, entry.out, entry.err);
+        }
+        catch (...)
+        {
+            entry.res = result::failure;
+            error = std::current_exception();
+        }
 
-                if (game < game::t6)
-                    exit_code |= gsc::funcs[mode](game, mach, entry.path().generic_string(), rel);
-                else
-                    exit_code |= arc::funcs[mode](game, mach, fs::path{ entry.path().generic_string(), fs::path::format::generic_format }, rel);
+        // print in directory order, whichever worker completes the head flushes it
+        {
+            auto lock = std::unique_lock{ mutex };
+            entry.done = true;
+
+            while (next < outputs.size() && outputs[next].done)
+            {
+                std::cout << outputs[next].out.str();
+                std::cerr << outputs[next].err.str();
+                exit_code |= outputs[next].res;
+                next++;
             }
         }
 
-        return exit_code;
+        // the pool rethrows the first error once every file has been flushed
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    });
+
+    return exit_code;
+}
+
+auto collect_files(mode mode, game game, fs::path const& path) -> std::vector<std::pair<fs::path, fs::path>>
+{
+    auto files = std::vector<std::pair<fs::path, fs::path>>{};
+
+    for (auto const& entry : fs::recursive_directory_iterator(path))
+    {
+        if (entry.is_regular_file() && extension_match(entry.path().extension(), mode, game))
+        {
+            files.push_back({ entry.path().generic_string(), fs::relative(entry, path).remove_filename() });
+        }
+    }
+
+    return files;
+}
+
+auto execute(mode mode, game game, mach mach, inst inst, fs::path const& path, bool dev) -> result
+{
+    if (fs::is_directory(path))
+    {
+        auto files = collect_files(mode, game, path);
+        auto pool = utils::thread_pool{ std::clamp(jobs, usize{ 1 }, std::max(files.size(), usize{ 1 })) };
+
+        gsc::init(game, mach, inst, dev, pool.size());
+        arc::init(game, mach, inst, dev, pool.size());
+
+        return execute_batch(mode, game, files, pool);
     }
     else if (fs::is_regular_file(path))
     {
@@ -1135,10 +1465,15 @@ auto execute(mode mode, game game, mach mach, inst inst, fs::path const& path, b
             return result::failure;
         }
 
-        if (game < game::t6)
-            return gsc::funcs[mode](game, mach, path, fs::path{});
-        else
-            return arc::funcs[mode](game, mach, fs::path(path, fs::path::format::generic_format), fs::path{});
+        gsc::init(game, mach, inst, dev, 1);
+        arc::init(game, mach, inst, dev, 1);
+
+        auto pool = utils::thread_pool{ std::max(jobs, usize{ 1 }) };
+        function_pool = (pool.size() > 1) ? &pool : nullptr;
+
+        auto res = execute_file(mode, game, 0, path, fs::path{}, std::cout, std::cerr);
+        function_pool = nullptr;
+        return res;
     }
     else
     {
@@ -1147,6 +1482,96 @@ auto execute(mode mode, game game, mach mach, inst inst, fs::path const& path, b
     }
 }
 
+// compiles the directory, then recompiles the files whose source, headers or includes change
+auto execute_watch(mode mode, game game, mach mach, inst inst, fs::path const& path, bool dev) -> result
+{
+    if (mode != mode::compile || !fs::is_directory(path))
+    {
+        std::cerr << "[ERROR] watch mode needs a directory to compile\n";
+        return result::failure;
+    }
+
+    watch::enabled = true;
+
+    auto pool = utils::thread_pool{ std::max(jobs, usize{ 1 }) };
+    auto watcher = utils::watcher{};
+    auto changed = std::unordered_set<std::string>{};
+    auto rebuild = false;
+
+    gsc::init(game, mach, inst, dev, pool.size());
+    arc::init(game, mach, inst, dev, pool.size());
+
+    watcher.add(path, true);
+
+    while (true)
+    {
+        auto files = collect_files(mode, game, path);
+        auto batch = std::vector<std::pair<fs::path, fs::path>>{};
+
+        for (auto const& file : files)
+        {
+            auto const key = watch::key(file.first);
+            auto const itr = watch::graph.find(key);
+
+            // new files and files that failed last time are retried on any change
+            auto dirty = rebuild || itr == watch::graph.end() || itr->second.failed || changed.contains(key);
+
+            for (auto i = 0u; !dirty && i < itr->second.deps.size(); i++)
+            {
+                dirty = changed.contains(itr->second.deps[i].second);
+            }
+
+            if (dirty)
+                batch.push_back(file);
+        }
+
+        if (!batch.empty())
+        {
+            execute_batch(mode, game, batch, pool);
+
+            for (auto const& [file, node] : watch::graph)
+            {
+                for (auto const& dep : node.deps)
+                {
+                    watcher.add(fs::path{ dep.second }.parent_path(), false);
+                }
+            }
+
+            std::cout << std::format("watching {} for changes\n", path.generic_string()) << std::flush;
+        }
+
+        changed.clear();
+
+        auto events = std::vector<fs::path>{};
+
+        // lost events rebuild every file against freshly parsed headers & includes
+        rebuild = !watcher.wait(events);
+
+        for (auto const& file : events)
+        {
+            changed.insert(file.generic_string());
+        }
+
+        // keep the parsed headers & includes that did not change
+        for (auto const& [file, node] : watch::graph)
+        {
+            for (auto const& dep : node.deps)
+            {
+                if (!rebuild && !changed.contains(dep.second))
+                    continue;
+
+                for (auto& ctx : *gsc::contexts)
+                    ctx->invalidate(dep.first);
+
+                for (auto& ctx : *arc::contexts)
+                    ctx->invalidate(dep.first);
+            }
+        }
+
+        gsc::files.clear();
+    }
+}
+
 auto parse_mode(std::string const& arg, mode& out) -> bool
 {
     auto mode = utils::string::to_lower(arg);
@@ -1216,6 +1641,185 @@ auto branding() -> std::string
     return std::format("GSC Tool {} created by xensik\n", XSK_VERSION_STR);
 }
 
+auto run(cxxopts::ParseResult const& result, bool banner) -> xsk::result
+{
+    if(!result.count("mode"))
+    {
+        std::cerr << "[ERROR] missing required argument <mode>\n";
+        return result::failure;
+    }
+
+    if (!result.count("game"))
+    {
+        std::cerr << "[ERROR] missing required argument <game>\n";
+        return result::failure;
+    }
+
+    if (!result.count("system"))
+    {
+        std::cerr << "[ERROR] missing required argument <system>\n";
+        return result::failure;
+    }
+
+    if (!result.count("path"))
+    {
+        std::cerr << "[ERROR] missing required argument <path>\n";
+        return result::failure;
+    }
+
+    auto mode_arg = utils::string::to_lower(result["mode"].as<std::string>());
+    auto game_arg = utils::string::to_lower(result["game"].as<std::string>());
+    auto mach_arg = utils::string::to_lower(result["system"].as<std::string>());
+    auto inst_arg = utils::string::to_lower(result["instance"].as<std::string>());
+    auto path_arg = result["path"].as<std::string>();
+    auto path = fs::path{};
+    auto mode = mode::_;
+    auto game = game::_;
+    auto mach = mach::_;
+    auto inst = inst::_;
+    auto dev = result["dev"].as<bool>();
+    gsc::zonetool = result["zonetool"].as<bool>();
+    gsc::optimize = result["optimize"].as<bool>();
+    arc::t6fixup = result["t6fixup"].as<bool>();
+    dry_run = result["dry"].as<bool>();
+    jobs = result["jobs"].as<u32>();
+
+    if (jobs == 0)
+        jobs = utils::thread_pool::concurrency();
+
+    cache::root = result.count("cache") ? fs::path{ utils::string::fordslash(result["cache"].as<std::string>()), fs::path::format::generic_format } : fs::path{};
+    cache::limit = u64{ result["cache-size"].as<u32>() } << 20;
+    cache::hits = 0;
+    cache::misses = 0;
+    cache::evicted = 0;
+
+    if(!parse_mode(mode_arg, mode))
+    {
+        std::cerr << "[ERROR] unknown mode '" << mode_arg << "'\n";
+        return result::failure;
+    }
+
+    if (!parse_game(game_arg, game))
+    {
+        std::cerr << "[ERROR] unknown game '" << game_arg << "'\n";
+        return result::failure;
+    }
+
+    if (!parse_system(mach_arg, mach))
+    {
+        std::cerr << "[ERROR] unknown system '" << mach_arg << "'\n";
+        return result::failure;
+    }
+
+    if (!parse_instance(inst_arg, inst))
+    {
+        std::cerr << "[ERROR] unknown instance '" << inst_arg << "'\n";
+        return result::failure;
+    }
+
+    path = fs::path{ utils::string::fordslash(path_arg), fs::path::format::generic_format };
+
+    if (banner)
+        std::cout << branding();
+
+    cache::config = std::format("{}|{}|{}|{}|{}|{}|{}|{}", static_cast<i32>(game), static_cast<i32>(mach), static_cast<i32>(inst), dev, gsc::zonetool, gsc::optimize, arc::t6fixup, XSK_VERSION_STR);
+
+    auto const res = result["watch"].as<bool>() ? execute_watch(mode, game, mach, inst, path, dev) : execute(mode, game, mach, inst, path, dev);
+
+    if (cache::enabled())
+    {
+        gsc::save_headers(game, mach, inst);
+        cache::trim();
+        std::cout << std::format("cache: {} hits, {} misses, {} evicted\n", cache::hits.load(), cache::misses.load(), cache::evicted.load());
+    }
+
+    return res;
+}
+
+auto split_args(std::string const& line) -> std::vector<std::string>
+{
+    auto args = std::vector<std::string>{};
+    auto arg = std::string{};
+    auto quoted = false;
+    auto pending = false;
+
+    for (auto const c : line)
+    {
+        if (c == '"')
+        {
+            quoted = !quoted;
+            pending = true;
+        }
+        else if (!quoted && (c == ' ' || c == '\t' || c == '\r'))
+        {
+            if (pending)
+                args.push_back(std::move(arg));
+
+            arg.clear();
+            pending = false;
+        }
+        else
+        {
+            arg.push_back(c);
+            pending = true;
+        }
+    }
+
+    if (pending)
+        args.push_back(std::move(arg));
+
+    return args;
+}
+
+// runs one command line per stdin line on warm contexts, every request ends with a status line on stdout
+auto serve(cxxopts::Options& options) -> result
+{
+    auto line = std::string{};
+
+    while (std::getline(std::cin, line))
+    {
+        auto args = split_args(line);
+
+        if (args.empty())
+            continue;
+
+        if (args[0] == "quit" || args[0] == "exit")
+            break;
+
+        auto argv = std::vector<char*>{ const_cast<char*>("gsc-tool") };
+
+        for (auto& arg : args)
+        {
+            argv.push_back(arg.data());
+        }
+
+        auto const start = std::chrono::steady_clock::now();
+        auto res = result::failure;
+
+        try
+        {
+            auto const request = options.parse(static_cast<int>(argv.size()), argv.data());
+
+            // requests never return while watching or serving, they would block the session
+            if (request.count("watch") || request.count("serve"))
+                std::cerr << "[ERROR] watch and serve are not allowed in serve requests\n";
+            else
+                res = run(request, false);
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "[ERROR] " << e.what() << std::endl;
+        }
+
+        auto const time = std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - start }.count();
+
+        std::cerr.flush();
+        std::cout << std::format("[DONE] {} {:.3f} ms\n", static_cast<i32>(res), time) << std::flush;
+    }
+
+    return result::success;
+}
+
 auto main(u32 argc, char** argv) -> result
 {
     cxxopts::Options options("gsc-tool", branding());
@@ -1232,7 +1836,13 @@ auto main(u32 argc, char** argv) -> result
         ("y,dry", "Dry run (do not write files).", cxxopts::value<bool>()->implicit_value("true"))
         ("d,dev", "Enable developer mode (dev blocks & generate bytecode map).", cxxopts::value<bool>()->implicit_value("true"))
         ("z,zonetool", "Enable zonetool mode (use .cgsc files).", cxxopts::value<bool>()->implicit_value("true"))
+        ("O,optimize", "Optimize compiled gsc bytecode (jump threading, dead code & peephole rewrites).", cxxopts::value<bool>()->implicit_value("true"))
         ("t6fixup", "Decompile t6 files from broken compilers", cxxopts::value<bool>()->implicit_value("true"))
+        ("j,jobs", "Process directory files, or the functions of a single script, on N worker threads (0 = all cores).", cxxopts::value<u32>()->default_value("1"), "<count>")
+        ("cache", "Reuse compile & decompile results stored in a cache directory.", cxxopts::value<std::string>(), "<dir>")
+        ("cache-size", "Cache size limit in MB, least recently used entries are evicted.", cxxopts::value<u32>()->default_value("1024"), "<size>")
+        ("watch", "Compile a directory, then recompile the files whose source, headers or includes change.", cxxopts::value<bool>()->implicit_value("true"))
+        ("serve", "Keep contexts warm and run one command line per stdin line, each followed by a '[DONE] <result> <time>' line.", cxxopts::value<bool>()->implicit_value("true"))
         ("h,help", "Display help.")
         ("v,version", "Display version.");
 
@@ -1254,73 +1864,13 @@ auto main(u32 argc, char** argv) -> result
             return result::success;
         }
 
-        if(!result.count("mode"))
-        {
-            std::cerr << "[ERROR] missing required argument <mode>\n";
-            return result::failure;
-        }
-
-        if (!result.count("game"))
-        {
-            std::cerr << "[ERROR] missing required argument <game>\n";
-            return result::failure;
-        }
-
-        if (!result.count("system"))
-        {
-            std::cerr << "[ERROR] missing required argument <system>\n";
-            return result::failure;
-        }
-
-        if (!result.count("path"))
-        {
-            std::cerr << "[ERROR] missing required argument <path>\n";
-            return result::failure;
-        }
-
-        auto mode_arg = utils::string::to_lower(result["mode"].as<std::string>());
-        auto game_arg = utils::string::to_lower(result["game"].as<std::string>());
-        auto mach_arg = utils::string::to_lower(result["system"].as<std::string>());
-        auto inst_arg = utils::string::to_lower(result["instance"].as<std::string>());
-        auto path_arg = result["path"].as<std::string>();
-        auto path = fs::path{};
-        auto mode = mode::_;
-        auto game = game::_;
-        auto mach = mach::_;
-        auto inst = inst::_;
-        auto dev = result["dev"].as<bool>();
-        gsc::zonetool = result["zonetool"].as<bool>();
-        arc::t6fixup = result["t6fixup"].as<bool>();
-        dry_run = result["dry"].as<bool>();
-
-        if(!parse_mode(mode_arg, mode))
-        {
-            std::cerr << "[ERROR] unknown mode '" << mode_arg << "'\n";
-            return result::failure;
-        }
-
-        if (!parse_game(game_arg, game))
-        {
-            std::cerr << "[ERROR] unknown game '" << game_arg << "'\n";
-            return result::failure;
-        }
-
-        if (!parse_system(mach_arg, mach))
-        {
-            std::cerr << "[ERROR] unknown system '" << mach_arg << "'\n";
-            return result::failure;
-        }
-
-        if (!parse_instance(inst_arg, inst))
+        if (result.count("serve"))
         {
-            std::cerr << "[ERROR] unknown instance '" << inst_arg << "'\n";
-            return result::failure;
+            std::cout << branding() << std::flush;
+            return serve(options);
         }
 
-        path = fs::path{ utils::string::fordslash(path_arg), fs::path::format::generic_format };
-
-        std::cout << branding();
-        return execute(mode, game, mach, inst, path, dev);
+        return run(result, true);
     }
     catch (std::exception const& e)
     {
@@ -0,0 +1,65 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/utils/arena.hpp"
+
+namespace xsk::utils
+{
+
+arena::arena(usize block_size) : block_size_{ block_size }
+{
+}
+
+auto arena::allocate(usize size, usize align) -> void*
+{
+    auto pad = (align - reinterpret_cast<std::uintptr_t>(head_) % align) % align;
+
+    if (head_ == nullptr || pad + size > left_)
+    {
+        // oversized requests get a block of their own so the current one keeps its space
+        if (size + align > block_size_ / 4)
+        {
+            blocks_.push_back(std::unique_ptr<u8[]>(new u8[size + align]));
+            auto const data = blocks_.back().get();
+            return data + (align - reinterpret_cast<std::uintptr_t>(data) % align) % align;
+        }
+
+        blocks_.push_back(std::unique_ptr<u8[]>(new u8[block_size_]));
+        head_ = blocks_.back().get();
+        left_ = block_size_;
+        pad = (align - reinterpret_cast<std::uintptr_t>(head_) % align) % align;
+    }
+
+    auto const data = head_ + pad;
+    head_ += pad + size;
+    left_ -= pad + size;
+    return data;
+}
+
+auto arena::store(std::string_view str) -> std::string_view
+{
+    if (str.empty())
+        return {};
+
+    auto const data = static_cast<char*>(allocate(str.size(), 1));
+    std::memcpy(data, str.data(), str.size());
+    return { data, str.size() };
+}
+
+// the other arena's blocks are kept alive here, new allocations still come from the current block
+auto arena::merge(arena&& other) -> void
+{
+    for (auto& block : other.blocks_)
+    {
+        blocks_.push_back(std::move(block));
+    }
+
+    other.blocks_.clear();
+    other.head_ = nullptr;
+    other.left_ = 0;
+}
+
+} // namespace xsk::utils
@@ -6,6 +6,17 @@
 #include "xsk/stdinc.hpp"
 #include "xsk/utils/file.hpp"
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace xsk::utils
 {
 
@@ -50,6 +61,16 @@ auto file::save(std::filesystem::path const& file, u8 const* data, usize size) -
     }
 }
 
+auto file::save(std::filesystem::path const& file, std::function<void(std::ostream&)> const& writer) -> void
+{
+    std::filesystem::create_directories(file.parent_path());
+
+    if (auto stream = std::ofstream{ file, std::ios::binary | std::ofstream::out }; stream)
+    {
+        writer(stream);
+    }
+}
+
 auto file::length(std::filesystem::path const& file) -> usize
 {
     if (auto stream = std::ifstream{ file, std::ios::binary }; stream.good())
@@ -66,4 +87,120 @@ auto file::exists(std::filesystem::path const& file) -> bool
     return std::filesystem::exists(file);
 }
 
+// sibling path private to the calling process & thread, published over file with a rename
+auto file::temp_path(std::filesystem::path const& file) -> std::filesystem::path
+{
+#ifdef _WIN32
+    auto const pid = static_cast<u64>(GetCurrentProcessId());
+#else
+    auto const pid = static_cast<u64>(getpid());
+#endif
+    auto const tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+    return std::filesystem::path{ file }.concat(std::format(".{:x}.{:x}.tmp", pid, tid));
+}
+
+mapped_file::mapped_file() : data_{ nullptr }, size_{ 0 }
+{
+}
+
+mapped_file::mapped_file(std::filesystem::path const& file) : data_{ nullptr }, size_{ 0 }
+{
+#ifdef _WIN32
+    auto handle = CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        throw error(std::format("couldn't open file {}", file.string()));
+    }
+
+    auto size = LARGE_INTEGER{};
+
+    if (GetFileSizeEx(handle, &size) && size.QuadPart > 0)
+    {
+        // the view keeps the mapping object alive after its handle is closed
+        if (auto mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr); mapping != nullptr)
+        {
+            data_ = static_cast<u8 const*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+
+        if (data_ == nullptr)
+        {
+            CloseHandle(handle);
+            throw error(std::format("couldn't map file {}", file.string()));
+        }
+
+        size_ = static_cast<usize>(size.QuadPart);
+    }
+
+    CloseHandle(handle);
+#else
+    auto fd = ::open(file.c_str(), O_RDONLY);
+
+    if (fd == -1)
+    {
+        throw error(std::format("couldn't open file {}", file.string()));
+    }
+
+    struct stat info{};
+
+    if (::fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        auto data = ::mmap(nullptr, static_cast<usize>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data == MAP_FAILED)
+        {
+            ::close(fd);
+            throw error(std::format("couldn't map file {}", file.string()));
+        }
+
+        data_ = static_cast<u8 const*>(data);
+        size_ = static_cast<usize>(info.st_size);
+    }
+
+    ::close(fd);
+#endif
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept : data_{ other.data_ }, size_{ other.size_ }
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+auto mapped_file::operator=(mapped_file&& other) noexcept -> mapped_file&
+{
+    if (this != &other)
+    {
+        close();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    return *this;
+}
+
+mapped_file::~mapped_file()
+{
+    close();
+}
+
+auto mapped_file::close() -> void
+{
+    if (data_ == nullptr)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+#else
+    ::munmap(const_cast<u8*>(data_), size_);
+#endif
+
+    data_ = nullptr;
+    size_ = 0;
+}
+
 } // namespace xsk::utils
@@ -0,0 +1,153 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/utils/scan.hpp"
+
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XSK_SCAN_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define XSK_SCAN_NEON
+#include <arm_neon.h>
+#endif
+
+namespace xsk::utils
+{
+
+namespace
+{
+
+// length of the leading run of bytes that match none of the stops
+template<usize N>
+auto span_of(char const* data, usize size, std::array<char, N> const& stops) -> usize
+{
+    auto pos = usize{ 0 };
+
+#if defined(__AVX2__)
+    __m256i wide[N];
+
+    for (auto i = 0u; i < N; i++)
+        wide[i] = _mm256_set1_epi8(stops[i]);
+
+    for (; pos + 32 <= size; pos += 32)
+    {
+        auto const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + pos));
+        auto hits = _mm256_cmpeq_epi8(chunk, wide[0]);
+
+        for (auto i = 1u; i < N; i++)
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(chunk, wide[i]));
+
+        auto const mask = static_cast<u32>(_mm256_movemask_epi8(hits));
+
+        if (mask != 0)
+            return pos + std::countr_zero(mask);
+    }
+#endif
+
+#if defined(XSK_SCAN_SSE2)
+    __m128i narrow[N];
+
+    for (auto i = 0u; i < N; i++)
+        narrow[i] = _mm_set1_epi8(stops[i]);
+
+    for (; pos + 16 <= size; pos += 16)
+    {
+        auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + pos));
+        auto hits = _mm_cmpeq_epi8(chunk, narrow[0]);
+
+        for (auto i = 1u; i < N; i++)
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, narrow[i]));
+
+        auto const mask = static_cast<u32>(_mm_movemask_epi8(hits));
+
+        if (mask != 0)
+            return pos + std::countr_zero(mask);
+    }
+#elif defined(XSK_SCAN_NEON)
+    uint8x16_t narrow[N];
+
+    for (auto i = 0u; i < N; i++)
+        narrow[i] = vdupq_n_u8(static_cast<u8>(stops[i]));
+
+    for (; pos + 16 <= size; pos += 16)
+    {
+        auto const chunk = vld1q_u8(reinterpret_cast<u8 const*>(data + pos));
+        auto hits = vceqq_u8(chunk, narrow[0]);
+
+        for (auto i = 1u; i < N; i++)
+            hits = vorrq_u8(hits, vceqq_u8(chunk, narrow[i]));
+
+        // narrow each lane to 4 bits so the mask fits a u64
+        auto const mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+
+        if (mask != 0)
+            return pos + std::countr_zero(mask) / 4;
+    }
+#endif
+
+    for (; pos < size; pos++)
+    {
+        for (auto const stop : stops)
+        {
+            if (data[pos] == stop)
+                return pos;
+        }
+    }
+
+    return size;
+}
+
+} // namespace
+
+auto scan::span(char const* data, usize size, char a, char b) -> usize
+{
+    return span_of<2>(data, size, { a, b });
+}
+
+auto scan::span(char const* data, usize size, char a, char b, char c) -> usize
+{
+    return span_of<3>(data, size, { a, b, c });
+}
+
+auto scan::count(char const* data, usize size, char c) -> usize
+{
+    auto pos = usize{ 0 };
+    auto res = usize{ 0 };
+
+#if defined(XSK_SCAN_SSE2)
+    auto const value = _mm_set1_epi8(c);
+
+    for (; pos + 16 <= size; pos += 16)
+    {
+        auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + pos));
+        res += std::popcount(static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, value))));
+    }
+#elif defined(XSK_SCAN_NEON)
+    auto const value = vdupq_n_u8(static_cast<u8>(c));
+
+    for (; pos + 16 <= size; pos += 16)
+    {
+        auto const chunk = vld1q_u8(reinterpret_cast<u8 const*>(data + pos));
+        res += vaddvq_u8(vshrq_n_u8(vceqq_u8(chunk, value), 7));
+    }
+#endif
+
+    for (; pos < size; pos++)
+    {
+        if (data[pos] == c)
+            res++;
+    }
+
+    return res;
+}
+
+} // namespace xsk::utils
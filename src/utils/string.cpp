@@ -177,40 +177,45 @@ auto string::split(std::string& str, char delimiter) -> std::vector<std::string>
     return tokens;
 }
 
-auto string::clean_buffer_lines(u8 const* data, usize size) -> std::vector<std::string>
+// splits an assembly line into operands, quoted strings keep their quotes & escapes
+auto string::parse_code(std::string_view line, std::vector<std::string_view>& data) -> void
 {
-    auto lines = std::vector<std::string>{};
-    auto current = std::string{};
+    auto const space = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f'; };
+    auto pos = usize{ 0 };
+
+    data.clear();
 
-    for (auto i = 0u; i < size; ++i)
+    while (pos < line.size())
     {
-        auto c = data[i];
-        if (c == '\n')
+        auto const c = line[pos];
+
+        if (space(c))
         {
-            lines.push_back(current);
-            current.clear();
+            pos++;
+            continue;
         }
-        else if (c != '\t' && c != '\r')
-            current += c;
-    }
 
-    if (!current.empty())
-        lines.push_back(current);
+        auto const start = pos++;
 
-    return lines;
-}
+        if (c == '"' || c == '\'')
+        {
+            while (pos < line.size() && line[pos] != c)
+            {
+                pos += (line[pos] == '\\') ? 2 : 1;
+            }
 
-auto string::parse_code(std::string& line) -> std::vector<std::string>
-{
-    auto data = std::vector<std::string>{};
-    auto exp = std::regex{ R"(([_A-Za-z0-9\-]+|\"(?:\\.|[^\"])*?\"|\'(?:\\.|[^\'])*?\')(?:\s+|$))" };
+            pos = std::min(pos + 1, line.size());
+        }
+        else
+        {
+            while (pos < line.size() && !space(line[pos]))
+            {
+                pos++;
+            }
+        }
 
-    for (auto i = std::sregex_iterator{ line.begin(), line.end(), exp }; i != std::sregex_iterator{}; ++i)
-    {
-        data.push_back(i->format("$1"));
+        data.push_back(line.substr(start, pos - start));
     }
-
-    return data;
 }
 
 auto string::float_string(float value, bool toint) -> std::string
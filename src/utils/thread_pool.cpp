@@ -0,0 +1,189 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/utils/thread_pool.hpp"
+
+namespace xsk::utils
+{
+
+thread_pool::thread_pool(usize count)
+{
+    count = std::max(count, usize{ 1 });
+
+    for (auto i = 0u; i < count; i++)
+    {
+        queues_.push_back(std::make_unique<queue>());
+    }
+
+    // a single worker runs tasks on the calling thread
+    if (count == 1) return;
+
+    for (auto i = 0u; i < count; i++)
+    {
+        threads_.emplace_back([this, i]() { work(i); });
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        auto lock = std::unique_lock{ mutex_ };
+        stop_ = true;
+    }
+
+    wake_.notify_all();
+
+    for (auto& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+auto thread_pool::size() const -> usize
+{
+    return queues_.size();
+}
+
+auto thread_pool::run(usize count, task const& func) -> void
+{
+    if (count == 0) return;
+
+    // tasks are dealt in contiguous ranges so each worker starts on its own slice
+    // in order, idle workers steal from the tail of the busiest queues
+    for (auto i = 0u; i < queues_.size(); i++)
+    {
+        auto lock = std::unique_lock{ queues_[i]->mutex };
+        auto beg = count * i / queues_.size();
+        auto end = count * (i + 1) / queues_.size();
+
+        for (auto j = beg; j < end; j++)
+        {
+            queues_[i]->items.push_back(j);
+        }
+    }
+
+    // the inline path runs every task like the workers do, the first error is rethrown at the end
+    if (threads_.empty())
+    {
+        auto index = usize{ 0 };
+        auto error = std::exception_ptr{};
+
+        while (next(0, index))
+        {
+            try
+            {
+                func(index, 0);
+            }
+            catch (...)
+            {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+
+        return;
+    }
+
+    auto lock = std::unique_lock{ mutex_ };
+    task_ = &func;
+    error_ = nullptr;
+    active_ = threads_.size();
+    generation_++;
+    wake_.notify_all();
+    done_.wait(lock, [this]() { return active_ == 0; });
+    task_ = nullptr;
+
+    if (error_)
+    {
+        std::rethrow_exception(error_);
+    }
+}
+
+auto thread_pool::concurrency() -> usize
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+auto thread_pool::work(usize worker) -> void
+{
+    auto seen = usize{ 0 };
+
+    while (true)
+    {
+        auto func = static_cast<task const*>(nullptr);
+
+        {
+            auto lock = std::unique_lock{ mutex_ };
+            wake_.wait(lock, [this, seen]() { return stop_ || generation_ != seen; });
+
+            if (stop_) return;
+
+            seen = generation_;
+            func = task_;
+        }
+
+        auto index = usize{ 0 };
+
+        while (next(worker, index))
+        {
+            try
+            {
+                (*func)(index, worker);
+            }
+            catch (...)
+            {
+                auto lock = std::unique_lock{ mutex_ };
+
+                if (!error_)
+                    error_ = std::current_exception();
+            }
+        }
+
+        auto lock = std::unique_lock{ mutex_ };
+
+        if (--active_ == 0)
+        {
+            done_.notify_one();
+        }
+    }
+}
+
+auto thread_pool::next(usize worker, usize& index) -> bool
+{
+    {
+        auto& own = *queues_[worker];
+        auto lock = std::unique_lock{ own.mutex };
+
+        if (!own.items.empty())
+        {
+            index = own.items.front();
+            own.items.pop_front();
+            return true;
+        }
+    }
+
+    for (auto i = 1u; i < queues_.size(); i++)
+    {
+        auto& other = *queues_[(worker + i) % queues_.size()];
+        auto lock = std::unique_lock{ other.mutex };
+
+        if (!other.items.empty())
+        {
+            index = other.items.back();
+            other.items.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace xsk::utils
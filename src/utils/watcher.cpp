@@ -0,0 +1,252 @@
+// Copyright 2025 xensik. All rights reserved.
+//
+// Use of this source code is governed by a GNU GPLv3 license
+// that can be found in the LICENSE file.
+
+#include "xsk/stdinc.hpp"
+#include "xsk/utils/watcher.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace xsk::utils
+{
+
+watcher::watcher() : fd_{ -1 }
+{
+#ifdef __linux__
+    fd_ = ::inotify_init1(IN_CLOEXEC);
+
+    if (fd_ == -1)
+    {
+        throw error("couldn't initialize inotify");
+    }
+#endif
+}
+
+watcher::~watcher()
+{
+#ifdef __linux__
+    if (fd_ != -1)
+    {
+        ::close(fd_);
+    }
+#endif
+}
+
+auto watcher::add(std::filesystem::path const& dir, bool recursive) -> void
+{
+    auto const path = std::filesystem::absolute(dir).lexically_normal();
+
+    if (!std::filesystem::is_directory(path))
+        return;
+
+    auto const itr = dirs_.find(path);
+
+    if (itr != dirs_.end() && (itr->second || !recursive))
+        return;
+
+    if (itr == dirs_.end())
+    {
+#ifdef __linux__
+        auto const handle = ::inotify_add_watch(fd_, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_DELETE_SELF);
+
+        if (handle == -1)
+        {
+            throw error(std::format("couldn't watch directory {}", path.string()));
+        }
+
+        handles_[handle] = path;
+#else
+        for (auto const& entry : std::filesystem::directory_iterator(path))
+        {
+            if (entry.is_regular_file())
+                times_[entry.path()] = entry.last_write_time();
+        }
+#endif
+    }
+
+    dirs_[path] = recursive;
+
+    if (!recursive)
+        return;
+
+    for (auto const& entry : std::filesystem::directory_iterator(path))
+    {
+        if (entry.is_directory())
+            add(entry.path(), true);
+    }
+}
+
+// false when events were lost and any file may have changed
+auto watcher::wait(std::vector<std::filesystem::path>& files) -> bool
+{
+    auto changes = std::set<std::filesystem::path>{};
+
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    auto timeout = -1;
+    auto overflow = false;
+
+    // block for the first event, then gather the rest of an editor's save burst
+    while (true)
+    {
+        auto poller = pollfd{ fd_, POLLIN, 0 };
+        auto const res = ::poll(&poller, 1, timeout);
+
+        if (res < 0 && errno == EINTR)
+            continue;
+
+        if (res <= 0)
+            break;
+
+        auto const size = ::read(fd_, buffer, sizeof(buffer));
+
+        if (size <= 0)
+            break;
+
+        for (auto ptr = buffer; ptr < buffer + size; )
+        {
+            auto const event = reinterpret_cast<inotify_event const*>(ptr);
+            ptr += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                overflow = true;
+                continue;
+            }
+
+            auto const itr = handles_.find(event->wd);
+
+            if (itr == handles_.end())
+                continue;
+
+            // the directory is gone, a new one at the same path is watched again by add
+            if (event->mask & (IN_DELETE_SELF | IN_IGNORED))
+            {
+                auto const path = itr->second;
+
+                if (event->mask & IN_IGNORED)
+                    handles_.erase(itr);
+
+                if (std::ranges::none_of(handles_, [&](auto const& entry) { return entry.first != event->wd && entry.second == path; }))
+                    dirs_.erase(path);
+
+                continue;
+            }
+
+            if (event->len == 0)
+                continue;
+
+            auto const path = itr->second / event->name;
+
+            if (event->mask & IN_ISDIR)
+            {
+                if ((event->mask & (IN_CREATE | IN_MOVED_TO)) && dirs_[itr->second])
+                    add(path, true);
+
+                continue;
+            }
+
+            changes.insert(path);
+        }
+
+        timeout = 100;
+    }
+
+    if (overflow)
+    {
+        rescan();
+        files.clear();
+        return false;
+    }
+#else
+    while (changes.empty())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 500 });
+
+        auto const dirs = dirs_;
+
+        for (auto const& [dir, recursive] : dirs)
+        {
+            scan(dir, changes);
+        }
+    }
+#endif
+
+    files.assign(changes.begin(), changes.end());
+    return true;
+}
+
+auto watcher::scan(std::filesystem::path const& dir, std::set<std::filesystem::path>& changes) -> void
+{
+    if (!std::filesystem::is_directory(dir))
+    {
+        dirs_.erase(dir);
+    }
+    else
+    {
+        for (auto const& entry : std::filesystem::directory_iterator(dir))
+        {
+            if (entry.is_directory())
+            {
+                if (dirs_[dir] && !dirs_.contains(entry.path()))
+                    add(entry.path(), true);
+            }
+            else if (entry.is_regular_file())
+            {
+                auto const time = entry.last_write_time();
+                auto const itr = times_.find(entry.path());
+
+                if (itr == times_.end() || itr->second != time)
+                {
+                    times_[entry.path()] = time;
+                    changes.insert(entry.path());
+                }
+            }
+        }
+    }
+
+    for (auto itr = times_.begin(); itr != times_.end(); )
+    {
+        if (itr->first.parent_path() == dir && !std::filesystem::exists(itr->first))
+        {
+            changes.insert(itr->first);
+            itr = times_.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
+
+// picks up the directories created while events were lost
+auto watcher::rescan() -> void
+{
+    auto const dirs = dirs_;
+
+    for (auto const& [dir, recursive] : dirs)
+    {
+        if (!std::filesystem::is_directory(dir))
+        {
+            dirs_.erase(dir);
+            continue;
+        }
+
+        if (!recursive)
+            continue;
+
+        for (auto const& entry : std::filesystem::directory_iterator(dir))
+        {
+            if (entry.is_directory())
+                add(entry.path(), true);
+        }
+    }
+}
+
+} // namespace xsk::utils
@@ -9,31 +9,37 @@
 namespace xsk::utils
 {
 
-writer::writer(bool swap) : size_{ default_size }, swap_{ swap }
+writer::writer(bool swap) : buffer_(default_size), data_{ buffer_.data() }, size_{ buffer_.size() }, swap_{ swap }
 {
-    data_ = new u8[size_]();
 }
 
-writer::writer(usize size, bool swap) : size_{ size }, swap_{ swap }
+writer::writer(usize size, bool swap) : buffer_(size), data_{ buffer_.data() }, size_{ buffer_.size() }, swap_{ swap }
 {
-    data_ = new u8[size_]();
 }
 
-writer::~writer()
+auto writer::clear() -> void
 {
-    delete[] data_;
+    // bytes past the written range are always zero, only reset what was used
+    std::memset(data_, 0, end_);
+    pos_ = 0;
+    end_ = 0;
 }
 
-auto writer::clear() -> void
+auto writer::reserve(usize count) -> void
 {
-    std::memset(data_, 0, size_);
-    pos_ = 0;
+    if (pos_ + count > size_)
+    {
+        buffer_.resize(std::max({ size_ * 2, pos_ + count, default_size }));
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+
+    end_ = std::max(end_, pos_ + count);
 }
 
 template<> auto writer::write(i8 data) -> void
 {
-    if (pos_ + 1 > size_)
-        throw error("writer: out of bounds");
+    reserve(1);
 
     *reinterpret_cast<i8*>(data_ + pos_) = data;
     pos_ += 1;
@@ -41,8 +47,7 @@ template<> auto writer::write(i8 data) -> void
 
 template<> auto writer::write(u8 data) -> void
 {
-    if (pos_ + 1 > size_)
-        throw error("writer: out of bounds");
+    reserve(1);
 
     *reinterpret_cast<u8*>(data_ + pos_) = data;
     pos_ += 1;
@@ -50,8 +55,7 @@ template<> auto writer::write(u8 data) -> void
 
 template<> auto writer::write(i16 data) -> void
 {
-    if (pos_ + 2 > size_)
-        throw error("writer: out of bounds");
+    reserve(2);
 
     if (!swap_)
     {
@@ -68,8 +72,7 @@ template<> auto writer::write(i16 data) -> void
 
 template<> auto writer::write(u16 data) -> void
 {
-    if (pos_ + 2 > size_)
-        throw error("writer: out of bounds");
+    reserve(2);
 
     if (!swap_)
     {
@@ -86,8 +89,7 @@ template<> auto writer::write(u16 data) -> void
 
 template<> auto writer::write(i32 data) -> void
 {
-    if (pos_ + 4 > size_)
-        throw error("writer: out of bounds");
+    reserve(4);
 
     if (!swap_)
     {
@@ -106,8 +108,7 @@ template<> auto writer::write(i32 data) -> void
 
 template<> auto writer::write(u32 data) -> void
 {
-    if (pos_ + 4 > size_)
-        throw error("writer: out of bounds");
+    reserve(4);
 
     if (!swap_)
     {
@@ -126,8 +127,7 @@ template<> auto writer::write(u32 data) -> void
 
 template<> auto writer::write(i64 data) -> void
 {
-    if (pos_ + 8 > size_)
-        throw error("writer: out of bounds");
+    reserve(8);
 
     if (!swap_)
     {
@@ -150,8 +150,7 @@ template<> auto writer::write(i64 data) -> void
 
 template<> auto writer::write(u64 data) -> void
 {
-    if (pos_ + 8 > size_)
-        throw error("writer: out of bounds");
+    reserve(8);
 
     if (!swap_)
     {
@@ -174,8 +173,7 @@ template<> auto writer::write(u64 data) -> void
 
 template<> auto writer::write(f32 data) -> void
 {
-    if (pos_ + 4 > size_)
-        throw error("writer: out of bounds");
+    reserve(4);
 
     if (!swap_)
     {
@@ -194,8 +192,8 @@ template<> auto writer::write(f32 data) -> void
 
 auto writer::write_i24(i32 data) -> void
 {
-    if (pos_ + 3 > size_)
-        throw error("writer: out of bounds");
+    // the little endian path stores a full dword
+    reserve(4);
 
     if (!swap_)
     {
@@ -213,8 +211,7 @@ auto writer::write_i24(i32 data) -> void
 
 auto writer::write_string(std::string const& data) -> void
 {
-    if (pos_ + data.size() > size_)
-        throw error("writer: out of bounds");
+    reserve(data.size());
 
     std::memcpy(reinterpret_cast<void*>(data_ + pos_), data.data(), data.size());
     pos_ += data.size();
@@ -222,10 +219,10 @@ auto writer::write_string(std::string const& data) -> void
 
 auto writer::write_cstr(std::string const& data) -> void
 {
-    if (pos_ + data.size() >= size_)
-        throw error("writer: out of bounds");
+    reserve(data.size() + 1);
 
     std::memcpy(reinterpret_cast<void*>(data_ + pos_), data.data(), data.size());
+    data_[pos_ + data.size()] = 0;
     pos_ += data.size() + 1;
 }
 
@@ -236,7 +233,8 @@ auto writer::is_avail() const -> bool
 
 auto writer::seek(usize size) -> void
 {
-    if (pos_ + size <= size_) pos_ += size;
+    reserve(size);
+    pos_ += size;
 }
 
 auto writer::seek_neg(usize size) -> void
@@ -246,11 +244,13 @@ auto writer::seek_neg(usize size) -> void
 
 auto writer::align(usize size) -> usize
 {
-    auto pos = pos_;
+    auto const next = (pos_ + (size - 1)) & ~(size - 1);
+    auto const pad = next - pos_;
 
-    pos_ = (pos_ + (size - 1)) & ~(size - 1);
+    reserve(pad);
+    pos_ = next;
 
-    return pos_ - pos;
+    return pad;
 }
 
 auto writer::data() const -> const u8*
@@ -270,7 +270,10 @@ auto writer::pos() const -> usize
 
 auto writer::pos(usize pos) -> void
 {
-    if (pos <= size_) pos_ = pos;
+    if (pos > pos_)
+        reserve(pos - pos_);
+
+    pos_ = pos;
 }
 
 } // namespace xsk::utils
@@ -12,12 +12,17 @@ namespace xsk::utils
 
 auto zlib::compress(std::vector<u8> const& data) -> std::vector<u8>
 {
-    auto length = compressBound(static_cast<uLong>(data.size()));
+    return compress(data.data(), data.size());
+}
+
+auto zlib::compress(u8 const* data, usize size) -> std::vector<u8>
+{
+    auto length = compressBound(static_cast<uLong>(size));
 
     auto output = std::vector<u8>{};
     output.resize(length);
 
-    auto result = compress2(reinterpret_cast<Bytef*>(output.data()), &length, reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size()), Z_BEST_COMPRESSION);
+    auto result = compress2(reinterpret_cast<Bytef*>(output.data()), &length, reinterpret_cast<const Bytef*>(data), static_cast<uLong>(size), Z_BEST_COMPRESSION);
 
     if (result == Z_OK)
     {
@@ -29,11 +34,17 @@ auto zlib::compress(std::vector<u8> const& data) -> std::vector<u8>
 }
 
 auto zlib::decompress(std::vector<u8> const& data, u32 length) -> std::vector<u8>
+{
+    return decompress(data.data(), data.size(), length);
+}
+
+auto zlib::decompress(u8 const* data, usize size, u32 length) -> std::vector<u8>
 {
     auto output = std::vector<u8>{};
     output.resize(length);
 
-    auto result = uncompress(reinterpret_cast<Bytef*>(output.data()), reinterpret_cast<uLongf*>(&length), reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size()));
+    auto output_size = static_cast<uLongf>(length);
+    auto result = uncompress(reinterpret_cast<Bytef*>(output.data()), &output_size, reinterpret_cast<const Bytef*>(data), static_cast<uLong>(size));
 
     if (result == Z_OK)
         return output;